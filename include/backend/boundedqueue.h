@@ -0,0 +1,120 @@
+#ifndef BOUNDEDQUEUE_H
+#define BOUNDEDQUEUE_H
+
+#include <QMutex>
+#include <QMutexLocker>
+#include <QWaitCondition>
+#include <QVector>
+
+/**
+ * @brief BoundedQueue —— 有界阻塞队列（视频流水线各级之间的背压）
+ *
+ *  - push() 在队列满时阻塞，下游变慢时上游自然减速；
+ *  - tryPush() 在队列满时立即失败，用于不允许阻塞生产者的旁路（如录像）；
+ *  - pop() 在队列空时阻塞；
+ *  - abort() 唤醒所有等待者并使后续 push/pop 立即失败，用于停止流水线。
+ *
+ * 环形数组实现，容量固定，入队出队不分配内存。
+ */
+template <typename T>
+class BoundedQueue
+{
+public:
+    explicit BoundedQueue(int capacity)
+        : m_items(qMax(1, capacity))
+    {
+    }
+
+    BoundedQueue(const BoundedQueue &) = delete;
+    BoundedQueue &operator=(const BoundedQueue &) = delete;
+
+    bool push(const T &item)
+    {
+        QMutexLocker locker(&m_mutex);
+        while (m_count == m_items.size() && !m_aborted)
+            m_notFull.wait(&m_mutex);
+        if (m_aborted)
+            return false;
+        m_items[(m_head + m_count) % m_items.size()] = item;
+        ++m_count;
+        m_notEmpty.wakeOne();
+        return true;
+    }
+
+    /// 非阻塞入队：队列满或已中止时返回 false
+    bool tryPush(const T &item)
+    {
+        QMutexLocker locker(&m_mutex);
+        if (m_count == m_items.size() || m_aborted)
+            return false;
+        m_items[(m_head + m_count) % m_items.size()] = item;
+        ++m_count;
+        m_notEmpty.wakeOne();
+        return true;
+    }
+
+    bool pop(T &item)
+    {
+        QMutexLocker locker(&m_mutex);
+        while (m_count == 0 && !m_aborted)
+            m_notEmpty.wait(&m_mutex);
+        if (m_aborted)
+            return false;
+        takeFront(item);
+        return true;
+    }
+
+    /// 非阻塞出队（中止后仍可用于排空队列）
+    bool tryPop(T &item)
+    {
+        QMutexLocker locker(&m_mutex);
+        if (m_count == 0)
+            return false;
+        takeFront(item);
+        return true;
+    }
+
+    void abort()
+    {
+        QMutexLocker locker(&m_mutex);
+        m_aborted = true;
+        m_notEmpty.wakeAll();
+        m_notFull.wakeAll();
+    }
+
+    /// 清空并解除中止状态（调用方负责先排空并释放元素）
+    void reset()
+    {
+        QMutexLocker locker(&m_mutex);
+        m_head = 0;
+        m_count = 0;
+        m_aborted = false;
+    }
+
+    int size() const
+    {
+        QMutexLocker locker(&m_mutex);
+        return m_count;
+    }
+
+    int capacity() const { return m_items.size(); }
+
+private:
+    void takeFront(T &item)
+    {
+        item = m_items[m_head];
+        m_head = (m_head + 1) % m_items.size();
+        --m_count;
+        m_notFull.wakeOne();
+    }
+
+    mutable QMutex m_mutex;
+    QWaitCondition m_notEmpty;
+    QWaitCondition m_notFull;
+    QVector<T> m_items;
+    int m_head = 0;
+    int m_count = 0;
+    bool m_aborted = false;
+};
+
+#endif // BOUNDEDQUEUE_H
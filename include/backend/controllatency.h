@@ -0,0 +1,76 @@
+#ifndef CONTROLLATENCY_H
+#define CONTROLLATENCY_H
+
+#include <QtGlobal>
+#include <QString>
+
+/**
+ * @brief 单段延迟统计（自开始记录以来的累计值）
+ */
+struct ControlLatencyStage {
+    quint64 count = 0;
+    double meanMs = 0.0;
+    double p50Ms = 0.0;
+    double p99Ms = 0.0;
+    double maxMs = 0.0;
+};
+
+/**
+ * @brief 摇杆 → 代理的控制延迟快照
+ */
+struct ControlLatencySnapshot {
+    ControlLatencyStage sampleToDispatch;       // 采样 → ControllerBridge（跨线程排队、等待控制周期）
+    ControlLatencyStage dispatchToSerialize;    // ControllerBridge → publishThrusters 序列化完成
+    ControlLatencyStage serializeToSocket;      // 序列化 → 写入套接字（QIODevice::bytesWritten）
+    ControlLatencyStage total;                  // 采样 → 写入套接字
+};
+
+/**
+ * @brief ControlLatencyTracker —— 推力指令的逐段延迟直方图
+ *
+ * 一条指令带着四个 steady 时钟时间戳（微秒）：RudderController 读到输入、ControllerBridge
+ * 收到、publishThrusters 序列化完成、套接字写出。每段各记一个对数直方图
+ * （每个二倍程 4 档，相对误差约 19%），百分位在档内线性插值，内存固定、记录为 O(1)。
+ * 同一采样被控制循环重复发布时只统计第一次（调用方传 0 表示不统计）。
+ *
+ * 只在 GUI 线程访问（ControllerBridge 与 MqttClient 都在 GUI 线程）。
+ */
+class ControlLatencyTracker
+{
+public:
+    ControlLatencyTracker();
+
+    /// steady 时钟微秒，各阶段时间戳统一用它
+    static qint64 nowUs();
+
+    void record(qint64 sampledUs, qint64 dispatchedUs, qint64 serializedUs, qint64 writtenUs);
+    void reset();
+
+    ControlLatencySnapshot snapshot() const;
+    /// 多行文本：各段统计与端到端直方图（日志、提示框用）
+    QString report() const;
+
+private:
+    static constexpr int kStepsPerOctave = 4;
+    static constexpr int kBuckets = 4 * 20;     // 10 µs × 2^20 ≈ 10 s
+    static constexpr double kFirstUs = 10.0;
+
+    struct Histogram {
+        quint64 counts[kBuckets] = {};
+        quint64 count = 0;
+        double sumUs = 0.0;
+        qint64 maxUs = 0;
+
+        void add(qint64 us);
+        double percentileUs(double p) const;
+        ControlLatencyStage stage() const;
+    };
+
+    static int bucketFor(qint64 us);
+    static double bucketLowerUs(int bucket);
+
+    enum Stage { SampleToDispatch, DispatchToSerialize, SerializeToSocket, Total, StageCount };
+    Histogram m_stages[StageCount];
+};
+
+#endif // CONTROLLATENCY_H
@@ -0,0 +1,105 @@
+#ifndef CONTROLSCHEDULER_H
+#define CONTROLSCHEDULER_H
+
+#include <QThread>
+#include <QMutex>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include "backend/ruddercontroller.h"
+
+/**
+ * @brief 推力器控制指令（已整形，直接发布到 control/thrusters）
+ */
+struct ThrusterCommand {
+    double leftThrust = 0.0;    // [-1000, 1000]
+    double rightThrust = 0.0;
+    double leftPos = 0.0;       // [-1, 1]
+    double rightPos = 0.0;
+    qint64 sampledUs = 0;       // 对应输入的采样时间；同一采样重复发布时为 0（不计延迟）
+};
+
+/**
+ * @brief 控制周期时序统计（lateness 为实际唤醒时刻相对计划时刻的延后，取最近窗口）
+ */
+struct ControlSchedulerStats {
+    double rateHz = 0.0;            // 设定频率
+    double actualHz = 0.0;          // 最近窗口实测频率
+    quint64 ticks = 0;
+    quint64 missedTicks = 0;        // 严重超时而跳过的周期（不补发）
+    quint64 commands = 0;           // 发出的指令数（非手动模式下不发）
+    double lateMeanUs = 0.0;
+    double lateP50Us = 0.0;
+    double lateP99Us = 0.0;
+    double lateMaxUs = 0.0;
+    double periodJitterUs = 0.0;    // 实际周期的标准差
+};
+
+/**
+ * @brief ControlScheduler —— 固定频率控制循环
+ *
+ * 独立线程按设定频率从 RudderController 的无锁快照取最新输入，整形后发出 commandReady，
+ * 由 ControllerBridge 交给 MqttClient 发布。发布频率与手柄采样频率解耦：
+ *  - 计划时刻在 steady 时钟的时间轴上逐周期累加，不以实际唤醒时刻为基准，误差不累积；
+ *  - 先用条件变量睡到计划时刻前一小段，再让出 CPU 等到计划时刻，抵消系统定时器粒度；
+ *    Windows 下运行期间把系统定时器精度调到 1 ms；
+ *  - 落后超过一个周期（挂起、调试暂停）时跳过错过的周期，不补发一串旧指令。
+ * stats() 可在任意线程调用。
+ */
+class ControlScheduler : public QThread
+{
+    Q_OBJECT
+
+public:
+    /// 整形：输入状态与控制周期（秒）→ 推力指令
+    using Shaper = std::function<ThrusterCommand(const RudderState &, double periodSeconds)>;
+
+    explicit ControlScheduler(const RudderController *input, QObject *parent = nullptr);
+    ~ControlScheduler() override;
+
+    /// 控制频率（Hz），运行中修改在下一个周期生效
+    void setRate(double hz);
+    double rate() const { return m_rate.load(std::memory_order_relaxed); }
+
+    /// 输入整形（start() 前设置，在控制线程调用）
+    void setShaper(Shaper shaper);
+
+    /// 非手动模式下照常计时但不发指令
+    void setActive(bool active) { m_active.store(active, std::memory_order_relaxed); }
+    bool isActive() const { return m_active.load(std::memory_order_relaxed); }
+
+    void stop();
+
+    ControlSchedulerStats stats() const;
+
+    /// 新建实例的默认频率（命令行设置）；0 表示不使用固定频率，按输入变化发布
+    static void setDefaultRate(double hz);
+    static double defaultRate();
+
+signals:
+    void commandReady(const ThrusterCommand &command);
+
+protected:
+    void run() override;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    void sleepUntil(Clock::time_point deadline);
+
+    const RudderController *m_input;
+    Shaper m_shaper;
+    std::atomic<double> m_rate;
+    std::atomic<bool> m_active { true };
+    std::atomic<bool> m_running { true };
+
+    std::mutex m_waitMutex;
+    std::condition_variable m_wake;
+
+    mutable QMutex m_statsMutex;
+    ControlSchedulerStats m_stats;
+};
+
+#endif // CONTROLSCHEDULER_H
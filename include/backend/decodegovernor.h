@@ -0,0 +1,112 @@
+#ifndef DECODEGOVERNOR_H
+#define DECODEGOVERNOR_H
+
+#include <QMutex>
+#include <QString>
+#include <atomic>
+
+/**
+ * @brief 解码调控状态与决策计数（累计值）
+ */
+struct DecodeGovernorStats {
+    bool adaptive = false;          // 是否自适应（只对网络实时流启用）
+    int threads = 0;                // 当前解码线程数
+    bool sliceThreading = false;    // true 片级多线程（不增加延迟），false 帧级多线程（吞吐优先）
+    int skipLevel = 0;              // 0 完整 / 1 丢弃非参考帧 / 2 另外关闭全部环路滤波
+    double decodeLoad = 0.0;        // 最近窗口：每包解码耗时 / 帧间隔
+    double guiLoad = 0.0;           // 最近窗口：投递帧数 / 界面取走帧数（>1 表示界面跟不上，0 表示无帧）
+    double guiFrameMs = 0.0;        // 最近窗口：界面平均取帧间隔
+    double frameIntervalMs = 0.0;   // 实测帧间隔
+    quint64 downgrades = 0;         // 降质次数
+    quint64 upgrades = 0;           // 恢复画质次数
+    quint64 reconfigures = 0;       // 线程配置变更次数（在关键帧处重开解码器）
+    QString lastDecision;           // 最近一次决策及原因
+};
+
+/**
+ * @brief DecodeGovernor —— 解码质量调控器
+ *
+ * 按窗口（1 秒）比较每包解码耗时与帧间隔、界面取帧速度与出帧速度，决定：
+ *  - 线程方式：默认片级多线程（不引入帧延迟）；解码跟不上时改为帧级多线程，
+ *    仍跟不上再加倍线程数；
+ *  - 线程已到上限仍过载，或界面跟不上时，逐级丢弃非参考帧、关闭环路滤波；
+ *  - 连续空闲后逐级恢复：先恢复画质，再回到片级多线程（估计单线程也跟得上时）、减少线程。
+ * 过载需连续 2 个窗口、空闲需连续 5 个窗口才动作，每次动作后冷却 3 秒；
+ * 恢复后很快又过载时，下一次恢复的等待时间加倍（最长 10 分钟），避免来回振荡。
+ *
+ * 只做决策，不接触解码器：解码线程喂样本、调用 evaluate() 并执行返回的动作；
+ * 线程配置变更需要重开解码器，由解码器在下一个关键帧处完成。
+ * stats() 可在任意线程调用。
+ */
+class DecodeGovernor
+{
+public:
+    struct Threading {
+        int threads = 1;
+        bool slice = false;
+    };
+
+    enum Action {
+        NoAction,
+        ChangeSkip,         // 丢帧 / 环路滤波级别变化，下一个包生效
+        Reconfigure         // 线程配置变化，需要重开解码器
+    };
+
+    /**
+     * @brief 新会话开始（打开解码器前调用）
+     * @param sliceCapable 解码器支持片级多线程
+     * @param frameCapable 解码器支持帧级多线程
+     * @param adaptive     是否自适应；否则固定使用帧级多线程
+     */
+    void begin(bool sliceCapable, bool frameCapable, bool adaptive);
+
+    Threading threading() const { return m_threading; }
+    int skipLevel() const { return m_skipLevel.load(std::memory_order_relaxed); }
+
+    // ---- 解码线程 ----
+    void onPacketDecoded(qint64 busyNs, double dtsSeconds);   // dtsSeconds < 0 表示无时间戳
+    Action evaluate(qint64 nowUs, int queuedPackets);
+    void revertThreading(const Threading &previous);   // 新配置打不开解码器时退回
+
+    // ---- 转换线程 / 界面线程 ----
+    void onFramePosted() { m_posted.fetch_add(1, std::memory_order_relaxed); }
+    void onFrameTaken(qint64 nowUs);
+
+    DecodeGovernorStats stats() const;
+
+private:
+    void decide(const QString &what, const QString &why, bool downgrade);
+
+    // 会话配置（解码线程）
+    bool m_adaptive = false;
+    bool m_sliceCapable = false;
+    bool m_frameCapable = false;
+    int m_maxThreads = 1;
+    int m_baseThreads = 1;                  // 初始线程数；空闲时不低于此值
+    Threading m_threading;
+    std::atomic<int> m_skipLevel { 0 };
+
+    // 窗口统计（解码线程）
+    qint64 m_windowStartUs = 0;
+    qint64 m_windowBusyNs = 0;
+    int m_windowPackets = 0;
+    double m_lastDts = -1.0;
+    double m_intervalS = 0.0;               // 帧间隔（EWMA）
+    int m_overWindows = 0;
+    int m_idleWindows = 0;
+    qint64 m_holdUntilUs = 0;               // 冷却截止
+    qint64 m_lastDowngradeUs = 0;
+    qint64 m_lastUpgradeUs = 0;
+    qint64 m_upgradeDelayUs = 0;            // 降级后至少等待多久才允许恢复
+
+    // 出帧与界面取帧（转换线程 / 界面线程累加，解码线程按窗口取走）
+    std::atomic<int> m_posted { 0 };
+    qint64 m_lastTakeUs = 0;                // 只在界面线程访问
+    std::atomic<qint64> m_takeIntervalSumUs { 0 };
+    std::atomic<int> m_takeCount { 0 };
+
+    mutable QMutex m_statsMutex;
+    DecodeGovernorStats m_stats;
+};
+
+#endif // DECODEGOVERNOR_H
@@ -0,0 +1,68 @@
+#ifndef EVDEVINPUT_H
+#define EVDEVINPUT_H
+
+#include <QtGlobal>
+
+#ifdef Q_OS_LINUX
+
+#include "backend/rudderinput.h"
+
+/**
+ * @brief EvdevInputSource —— Linux evdev 手柄输入
+ *
+ * 直接读取 /dev/input/eventN：线程阻塞在 poll() 上，设备有事件才醒来，
+ * 以 SYN_REPORT 为界合并一批轴变化后交给 RudderController，空闲时不占 CPU。
+ *
+ *  - 自动选择第一个带 ABS_X/ABS_Y 且有手柄/摇杆按键的设备（排除触摸板），也可指定设备路径；
+ *  - 右摇杆优先 ABS_RX/ABS_RY，没有时用 ABS_Z/ABS_RZ（飞行摇杆类设备）；
+ *  - 轴值按设备报告的范围归一化到 [-1, 1]，flat 范围内视为 0；方向与 SDL 一致（Y 向下为正）；
+ *  - SYN_DROPPED（内核缓冲溢出）后用 EVIOCGABS 重新读取全部轴；
+ *  - 设备拔出后通过 inotify 监视 /dev/input，插回即重新打开，同样不轮询；
+ *  - interrupt() 写 eventfd 唤醒 poll()。
+ */
+class EvdevInputSource : public RudderInputSource
+{
+public:
+    explicit EvdevInputSource(const QString &devicePath = QString());
+    ~EvdevInputSource() override;
+
+    bool open(QString *error) override;
+    WaitResult wait(RudderState &state, int timeoutMs) override;
+    void interrupt() override;
+    bool isConnected() const override { return m_fd >= 0; }
+    QString name() const override;
+
+private:
+    enum AxisIndex { LeftX, LeftY, RightX, RightY, AxisCount };
+
+    struct Axis {
+        int code = -1;          // ABS_* 代码，-1 表示设备没有该轴
+        int minimum = 0;
+        int maximum = 0;
+        int flat = 0;
+    };
+
+    bool openDevice();
+    bool tryDevice(const QString &path);
+    void closeDevice();
+    void resync();
+    void applyAxis(int code, int value);
+    float normalize(const Axis &axis, int value) const;
+
+    QString m_fixedPath;        // 指定的设备；为空时自动查找
+    QString m_devicePath;
+    QString m_deviceName;
+    int m_fd = -1;
+    int m_wakeFd = -1;          // eventfd：interrupt() 唤醒
+    int m_notifyFd = -1;        // inotify：/dev/input 热插拔
+    Axis m_axes[AxisCount];
+    RudderState m_pending;      // 本批事件累积中的状态
+    RudderState m_reported;     // 最近一次交出的状态
+    bool m_dirty = false;
+    bool m_dropped = false;     // 收到 SYN_DROPPED，等下一个 SYN_REPORT 后重新同步
+    bool m_warnedAccess = false;
+};
+
+#endif // Q_OS_LINUX
+
+#endif // EVDEVINPUT_H
@@ -5,6 +5,19 @@
 #include <QImage>
 #include <QMutex>
 #include <QWaitCondition>
+#include <QAtomicInteger>
+#include <QElapsedTimer>
+#include <atomic>
+#include <memory>
+#include "backend/framepool.h"
+#include "backend/framemailbox.h"
+#include "backend/boundedqueue.h"
+#include "backend/videorecorder.h"
+#include "backend/packetring.h"
+#include "backend/latencytracker.h"
+#include "backend/decodegovernor.h"
+
+class QThread;
 
 extern "C" {
     #include <libavformat/avformat.h>
@@ -13,6 +26,101 @@ extern "C" {
     #include <libavutil/imgutils.h>
 }
 
+/**
+ * @brief 帧计数（累计值）
+ */
+struct VideoFrameStats {
+    quint64 decoded = 0;     // 解码完成的帧
+    quint64 displayed = 0;   // 被界面取走显示的帧
+    quint64 dropped = 0;     // 丢弃的帧（信箱中被覆盖 + 帧池耗尽）
+};
+
+/**
+ * @brief 流水线单级耗时统计（自上次读取以来）
+ */
+struct VideoStageStats {
+    quint64 count = 0;       // 处理的数据包/帧数
+    double avgMs = 0.0;      // 平均耗时
+    double maxMs = 0.0;      // 最大耗时
+    int queued = 0;          // 该级输入队列当前深度
+    int capacity = 0;        // 该级输入队列容量
+};
+
+struct VideoPipelineStats {
+    VideoStageStats demux;   // 读包（av_read_frame，含网络等待）
+    VideoStageStats decode;  // 解码（send_packet / receive_frame）
+    VideoStageStats convert; // 颜色转换与缩放（sws_scale_frame，切片多线程）
+    VideoStageStats handoff; // 显示交接：帧投递到信箱至界面取走的等待时间
+};
+
+/**
+ * @brief 连接健康统计（累计值）：区分网络问题与解码问题
+ */
+struct VideoHealthStats {
+    quint64 stalls = 0;          // 网络卡顿：包到达间隔超过阈值
+    qint64 longestStallMs = 0;   // 最长卡顿
+    quint64 ptsGaps = 0;         // 时间戳跳变（源端或传输中丢帧）
+    quint64 timeouts = 0;        // 读包超时（截止时间内无数据，触发重连）
+    quint64 readErrors = 0;      // 读包错误（损坏的包等）
+    quint64 decodeErrors = 0;    // 解码错误与残缺帧
+    quint64 reconnects = 0;      // 重连次数
+};
+
+/**
+ * @brief 打开耗时：从 openStream 到首帧进入信箱（time-to-first-frame）
+ */
+struct VideoOpenStats {
+    bool warm = false;       // 本次连接使用了参数缓存，跳过了流探测
+    qint64 ttffMs = -1;      // 本次连接从打开到首帧的耗时，尚未出帧时为 -1
+    qint64 outageMs = -1;    // 最近一次断流到重新出帧的总时长（含失败重试与退避），未断流过为 -1
+};
+
+/**
+ * @brief StageMeter —— 单级耗时累计（工作线程写，界面读）
+ */
+class StageMeter
+{
+public:
+    void add(qint64 ns);
+    VideoStageStats snapshot();     // 只在单一读者线程调用
+    void reset();
+
+private:
+    std::atomic<quint64> m_count { 0 };
+    std::atomic<quint64> m_totalNs { 0 };
+    std::atomic<quint64> m_maxNs { 0 };
+    quint64 m_lastCount = 0;
+    quint64 m_lastTotalNs = 0;
+};
+
+/**
+ * @brief FFmpegDecoder —— RTSP 视频解码器
+ *
+ * 三级流水线，各自独立线程，之间以有界队列连接：
+ *   读包线程 (av_read_frame) → 包队列 → 解码线程 → 帧队列 → 转换线程 (sws_scale_frame) → 帧信箱
+ * 网络抖动不会阻塞解码，转换变慢也不会阻塞读包（直到队列满才形成背压）。
+ * 颜色转换按输出的水平条带分给 swscale 的切片线程并行完成，输出格式与显示表面的后备缓冲一致，
+ * 界面贴图时不再做格式转换。
+ * 数据包与 AVFrame 均预分配并循环使用。连接与探测也在读包线程中完成，openStream 立即返回。
+ *
+ * 网络流由读包线程监督：所有阻塞的 FFmpeg 调用受中断回调的截止时间约束，
+ * 超时、连续读错误或服务端断开后按指数退避重连（Reconnecting 状态），不再空转。
+ *
+ * 解码线程方式与丢帧级别由 DecodeGovernor 按负载调整（网络实时流）：默认片级多线程保持低延迟，
+ * 跟不上时改帧级多线程、加线程，再不够才丢弃非参考帧 / 关闭环路滤波，空闲后逐级恢复。
+ *
+ * 同一 URL 的编码参数缓存在 StreamParamCache 中：重连 / 再次打开时跳过 avformat_find_stream_info，
+ * 直接从第一个关键帧开始解码。
+ *
+ * 录像（startRecording）：读包线程把视频包旁路给 VideoRecorder，独立线程流复制为分段 MP4，
+ * 备用流同样可以录像。
+ *
+ * 即时回放：读包线程同时把视频包写入按字节预算分配的回放环（PacketRing），
+ * ReplayEngine 按需从中解码任意时刻的画面。回放环默认关闭，由 StreamManager 只为活动流开启。
+ *
+ * 备用模式（setStandby）：保持 RTSP 会话，缓存最近一个 GOP 的数据包，只解码关键帧；
+ * 转为活动时立即可显示最新关键帧，并回放缓存的 GOP 追到实时画面。
+ */
 class FFmpegDecoder : public QObject
 {
     Q_OBJECT
@@ -23,7 +131,15 @@ public:
         Connecting,
         Playing,
         Paused,
-        Error
+        Error,
+        Reconnecting        // 网络流断开，等待退避后重连
+    };
+
+    // 解码质量：画面较小时降低解码成本（宫格视图的小图块）
+    enum DecodeQuality {
+        FullQuality,        // 完整解码
+        ReducedQuality,     // 非参考帧跳过环路滤波并丢弃
+        MinimalQuality      // 关闭全部环路滤波并丢弃非参考帧
     };
 
     explicit FFmpegDecoder(QObject *parent = nullptr);
@@ -35,44 +151,213 @@ public:
     void resume();
     void stop();
 
-    DecoderState getState() const { return m_state; }
-    QString getErrorString() const { return m_errorString; }
+    // 状态与错误信息由读取 / 解码线程写入，可在任意线程读取
+    DecoderState getState() const { return DecoderState(m_state.load()); }
+    QString getErrorString() const;
     int getVideoWidth() const { return m_videoWidth; }
     int getVideoHeight() const { return m_videoHeight; }
+    QString url() const { return m_url; }
+
+    // 备用模式（线程安全）：后台保持连接，只解码关键帧并缓存当前 GOP
+    void setStandby(bool standby);
+    bool isStandby() const { return m_standby.load(std::memory_order_relaxed); }
+
+    // 零转码分段录像（GUI 线程）：dir 下写入 name-时间.mp4 与 name-index.csv
+    bool startRecording(const QString &dir, const QString &name);
+    void stopRecording();
+    bool isRecording() const { return m_recorder->isRecording(); }
+    VideoRecorderStats recorderStats() const { return m_recorder->stats(); }
+
+    // 即时回放环（最近一段时间的压缩包）；预算为 0 时关闭（默认）
+    std::shared_ptr<PacketRing> replayRing() const { return m_replayRing; }
+    void setReplayBudget(qint64 bytes) { m_replayRing->setBudget(bytes); }
+
+    // 解码质量（线程安全，下一个数据包生效）
+    // 手动设置的质量与调控器的丢帧级别取较低者
+    void setDecodeQuality(DecodeQuality quality);
+    DecodeQuality decodeQuality() const { return DecodeQuality(m_decodeQuality.load(std::memory_order_relaxed)); }
+
+    // 显示区域尺寸（设备像素，线程安全）：解码线程直接输出该尺寸（保持宽高比）的 RGB 帧，
+    // 界面只需 1:1 贴图。空尺寸表示按源分辨率输出。
+    void setOutputSize(const QSize &size);
+    QSize outputSize() const;
+
+    // 输出像素格式（线程安全，下一帧生效）：传入显示表面后备缓冲的格式，
+    // 解码器选用与之内存布局相同的不透明格式（如 ARGB32_Premultiplied → RGB32），不支持时用 RGB32
+    void setOutputFormat(QImage::Format displayFormat);
+    QImage::Format outputFormat() const { return QImage::Format(m_outputFormat.load(std::memory_order_relaxed)); }
+
+    // 颜色转换线程数（线程安全，下一帧生效）：0 按输出高度与核数自动选择，1 为单线程
+    void setConvertThreads(int threads);
+    int convertThreads() const { return m_activeConvertThreads.load(std::memory_order_relaxed); }
+
+    // 界面取最新一帧（只在 GUI 线程调用）；没有新帧时返回 false
+    bool takeFrame(QImage &frame);
+    VideoFrameStats frameStats() const;
+    // 各级耗时与队列深度（自上次调用以来，只在 GUI 线程调用）
+    VideoPipelineStats pipelineStats();
+    // 最近一次打开的冷 / 热方式与首帧耗时（线程安全）
+    VideoOpenStats openStats() const;
+    // 逐帧延迟（收包 → 解码 → 转换 → 界面取走）的分位数、抖动与码率（只在 GUI 线程调用）
+    LatencySnapshot latencySnapshot() { return m_latency.snapshot(steadyNowUs()); }
+    // 卡顿 / 超时 / 读错误 / 解码错误 / 重连计数（线程安全）
+    VideoHealthStats healthStats() const;
+    // 解码调控：关闭后固定帧级多线程、完整质量（下次打开生效）；决策与负载（线程安全）
+    void setGovernorEnabled(bool enabled) { m_governorEnabled.store(enabled, std::memory_order_relaxed); }
+    DecodeGovernorStats governorStats() const { return m_governor.stats(); }
 
 signals:
-    void frameReady(const QImage &frame);
+    // 信箱由空变为有帧时发出（合并通知：界面未取走前不会重复发出）
+    void frameAvailable();
     void stateChanged(int state);
     void errorOccurred(const QString &errorMessage);
 
 private:
     void setState(DecoderState newState);
+    void setErrorString(const QString &error);
     bool initFFmpeg();
     bool initCodec();
-    bool initSwsContext();
-    bool decodePacket(AVPacket *packet);
+    AVCodecContext *createCodecContext(const DecodeGovernor::Threading &threading);
+    void reopenCodec();         // 解码线程：在关键帧处按调控器的新线程配置重开解码器
+    bool initBuffers();
+    bool updateSwsContext(const AVFrame *frame, const QSize &dstSize, AVPixelFormat dstFormat, int threads);
+    bool scaleInto(const AVFrame *frame, QImage &image);
+    QSize targetFrameSize(int srcWidth, int srcHeight) const;
+    // 读包会话的结束原因
+    enum SessionEnd {
+        EndStopped,     // 主动停止
+        EndOfFile,      // 流结束（网络流视为服务端断开）
+        EndTimeout,     // 截止时间内无数据
+        EndError        // 连续读错误
+    };
+
+    void readerMain();          // 读包线程入口：连接监督（打开、读包、断开后退避重连）
+    void startDecodeThreads();
+    void stopDecodeThreads();   // 等待解码 / 转换线程处理完流结束标记
+    bool waitBackoff(int ms);   // 可被 stop() 打断；被打断时返回 false
+    static int backoffDelayMs(int attempt);
+    bool isLiveSource() const;
+    void armDeadline(int ms);   // 为下一次阻塞调用设置截止时间
+    static qint64 steadyNowMs();
+    static qint64 steadyNowUs();
+    bool openInput();
+    bool probeStreamInfo();     // 完整探测（冷打开）并写入参数缓存
+    void requestStop();         // 置停止标志并唤醒暂停中的读包线程
+    void stopPipeline();        // 中止队列并等待三个线程退出
     void cleanup();
-    void run();
+    void releaseSession();      // 释放单次连接的上下文与缓冲（重连前调用）
+
+    // 流水线各级线程入口
+    SessionEnd readLoop();
+    void decodeLoop();
+    void convertLoop();
+    void applyDecodeSettings();
+    bool decodePacket(AVPacket *packet);    // packet 为 nullptr 时冲刷解码器
+    void bufferGopPacket(const AVPacket *pkt);
+    bool replayGop(int64_t resumePts);
+    void clearGop();
+    void convertFrame(AVFrame *frame);
+
+    static int interruptCallback(void *opaque);
 
     // FFmpeg相关变量
     AVFormatContext *m_formatContext = nullptr;
     AVCodecContext *m_codecContext = nullptr;
-    AVFrame *m_frame = nullptr;
-    AVFrame *m_frameRGB = nullptr;
-    AVPacket *m_packet = nullptr;
     SwsContext *m_swsContext = nullptr;
+    AVFrame *m_swsDstFrame = nullptr;           // 包装池化输出缓冲区（不持有内存）
+    // 当前转换上下文的参数（变化时重建）
+    QSize m_swsSrcSize;
+    int m_swsSrcFormat = AV_PIX_FMT_NONE;
+    QSize m_swsDstSize;
+    AVPixelFormat m_swsDstFormat = AV_PIX_FMT_NONE;
+    int m_swsThreads = 0;
+
+    // 输出格式与转换线程数（界面线程写，转换线程读）
+    std::atomic<int> m_outputFormat { QImage::Format_RGB32 };
+    std::atomic<int> m_convertThreads { 0 };
+    std::atomic<int> m_activeConvertThreads { 1 };
+
+    // 界面请求的输出尺寸，打包为 (宽 << 32 | 高)，无锁读写
+    QAtomicInteger<quint64> m_requestedSize = 0;
 
     int m_videoStreamIndex = -1;
-    uint8_t *m_rgbBuffer = nullptr;
+
+    // 流水线：预分配的数据包/帧通过“空闲队列”循环使用，nullptr 作为流结束标记
+    QVector<AVPacket *> m_packetStore;
+    QVector<AVFrame *> m_frameStore;
+    BoundedQueue<AVPacket *> m_freePackets;
+    BoundedQueue<AVPacket *> m_packetQueue;
+    BoundedQueue<AVFrame *> m_freeFrames;
+    BoundedQueue<AVFrame *> m_frameQueue;
+    QThread *m_readThread = nullptr;
+    QThread *m_decodeThread = nullptr;
+    QThread *m_convertThread = nullptr;
+
+    // 备用模式
+    QString m_url;
+    std::atomic<bool> m_standby { false };
+    bool m_readerStandby = false;               // 读包线程上次看到的模式
+    bool m_decoderStandby = false;              // 解码线程上次看到的模式
+    std::atomic<int> m_decodeQuality { FullQuality };
+    int m_appliedQuality = FullQuality;         // 解码线程已应用的质量（-1 表示需要重新应用）
+    DecodeGovernor m_governor;
+    std::atomic<bool> m_governorEnabled { true };
+    DecodeGovernor::Threading m_activeThreading;  // 当前解码器上下文的线程配置
+    bool m_reconfigurePending = false;          // 解码线程：等待关键帧重开解码器
+    QVector<AVPacket *> m_gop;                  // 最近一个 GOP（读包线程独占）
+    qint64 m_gopBytes = 0;
+    bool m_gopValid = false;
+    std::atomic<int64_t> m_catchupPts { AV_NOPTS_VALUE };  // 追帧恢复点
+
+    // 打开耗时：每次连接尝试（openInput）重新计时，首帧进入信箱时记录
+    QElapsedTimer m_openTimer;
+    std::atomic<bool> m_warmOpen { false };
+    std::atomic<qint64> m_ttffMs { -1 };
+    // 断流时长：会话结束或连接失败时开始计时（读包线程），恢复出帧时记录（转换线程）
+    QElapsedTimer m_outageTimer;
+    std::atomic<qint64> m_outageMs { -1 };
+    bool m_awaitKeyframe = false;               // 读包线程：首个关键帧之前的包直接丢弃
+    bool m_firstFrameChecked = false;           // 解码线程：首帧参数已与缓存核对
+
+    // 连接监督：中断回调截止时间（steady 时钟毫秒，0 表示不限）与健康统计
+    std::atomic<qint64> m_ioDeadlineMs { 0 };
+    std::atomic<bool> m_ioTimedOut { false };
+    quint64 m_sessionPackets = 0;               // 本次会话收到的视频包（读包线程独占）
+    std::atomic<quint64> m_stalls { 0 };
+    std::atomic<qint64> m_longestStallMs { 0 };
+    std::atomic<quint64> m_ptsGaps { 0 };
+    std::atomic<quint64> m_timeouts { 0 };
+    std::atomic<quint64> m_readErrors { 0 };
+    std::atomic<quint64> m_decodeErrors { 0 };
+    std::atomic<quint64> m_reconnects { 0 };
+
+    // 录像旁路（读包线程入队，录像线程写盘）
+    std::unique_ptr<VideoRecorder> m_recorder;
+    // 回放环（读包线程写入，回放引擎读取；共享所有权，解码器销毁后回放仍可进行）
+    std::shared_ptr<PacketRing> m_replayRing;
+
+    StageMeter m_demuxMeter;
+    StageMeter m_decodeMeter;
+    StageMeter m_convertMeter;
+    StageMeter m_handoffMeter;
+    LatencyTracker m_latency;
+
+    // RGB 输出缓冲池：swscale 直接写入池化缓冲区，界面释放后自动归还
+    std::shared_ptr<FramePool> m_framePool;
+
+    // 最新帧信箱：解码线程覆盖写入，界面取最新帧，旧帧直接丢弃
+    FrameMailbox m_mailbox;
+    std::atomic<quint64> m_decodedFrames { 0 };
 
     // 视频信息
     int m_videoWidth = 0;
     int m_videoHeight = 0;
 
     // 状态控制
-    volatile bool m_stopped = false;
-    volatile bool m_paused = false;
-    DecoderState m_state = Stopped;
+    std::atomic<bool> m_stopped { false };
+    std::atomic<bool> m_paused { false };
+    std::atomic<int> m_state { Stopped };
+    mutable QMutex m_errorMutex;
     QString m_errorString;
 
     QMutex m_mutex;
@@ -0,0 +1,71 @@
+#ifndef FRAMEMAILBOX_H
+#define FRAMEMAILBOX_H
+
+#include <QImage>
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @brief FrameMailbox —— 解码线程与界面之间的单槽“最新帧”信箱（无锁）
+ *
+ * 三缓冲实现：写端独占 back 槽，读端独占 front 槽，middle 槽通过原子交换传递。
+ *  - post()：写入 back 后与 middle 交换；若 middle 中的帧尚未被取走，则它被覆盖（丢帧）；
+ *  - take()：若 middle 有新帧，与 front 交换后返回。
+ * 任何时刻最多只有一帧在等待显示，界面繁忙时旧帧被直接丢弃，延迟有上界。
+ * 帧的时间戳与投递时刻和图像存放在同一槽中，取出时与图像一一对应。
+ *
+ * 仅支持单写者、单读者。
+ */
+class FrameMailbox
+{
+public:
+    FrameMailbox() = default;
+    FrameMailbox(const FrameMailbox &) = delete;
+    FrameMailbox &operator=(const FrameMailbox &) = delete;
+
+    /// 随帧传递的时间信息
+    struct Stamp {
+        int64_t pts = INT64_MIN;    // 帧时间戳（流时间基），默认即 AV_NOPTS_VALUE
+        qint64 postUs = 0;          // 投递时刻（steady 时钟，微秒）
+    };
+
+    /**
+     * @brief 写端：投递最新帧
+     * @return true 表示信箱此前为空（读端需要被唤醒）；
+     *         false 表示覆盖了一帧尚未显示的旧帧，读端已有待处理的唤醒
+     */
+    bool post(const QImage &frame, const Stamp &stamp = Stamp());
+
+    /**
+     * @brief 读端：取出最新帧
+     * @return 没有新帧时返回 false，frame 与 stamp 不变
+     */
+    bool take(QImage &frame, Stamp *stamp = nullptr);
+
+    /// 读端：丢弃信箱中所有帧（停止/切换流时释放缓冲区）
+    void clear();
+
+    quint64 posted() const { return m_posted.load(std::memory_order_relaxed); }
+    quint64 taken() const { return m_taken.load(std::memory_order_relaxed); }
+    quint64 overwritten() const { return m_overwritten.load(std::memory_order_relaxed); }
+
+private:
+    static constexpr int kIndexMask = 0x3;
+    static constexpr int kFreshBit = 0x4;    // middle 槽中有尚未取走的新帧
+
+    struct Slot {
+        QImage image;
+        Stamp stamp;
+    };
+
+    Slot m_slots[3];
+    int m_back = 0;                          // 写端独占
+    int m_front = 1;                         // 读端独占
+    std::atomic<int> m_middle { 2 };
+
+    std::atomic<quint64> m_posted { 0 };
+    std::atomic<quint64> m_taken { 0 };
+    std::atomic<quint64> m_overwritten { 0 };
+};
+
+#endif // FRAMEMAILBOX_H
@@ -0,0 +1,66 @@
+#ifndef FRAMEPOOL_H
+#define FRAMEPOOL_H
+
+#include <QImage>
+#include <QMutex>
+#include <QVector>
+#include <QAtomicInteger>
+#include <memory>
+
+/**
+ * @brief FramePool —— 固定容量的视频帧缓冲池
+ *
+ * acquire() 返回一个直接包装池内缓冲区的 QImage（不拷贝），
+ * 该 QImage 及其所有副本释放后，缓冲区通过 QImage 清理回调自动归还池中。
+ * 解码线程直接把 sws_scale 的输出写进该缓冲区，稳定播放时每帧零堆分配。
+ *
+ * 池耗尽（界面仍持有全部缓冲区）时 acquire() 返回空图像，由调用方丢帧，
+ * 而不是临时分配新缓冲区。
+ *
+ * 池由 std::shared_ptr 管理：解码器销毁后，仍在界面中的帧释放时会自行回收内存。
+ */
+class FramePool : public std::enable_shared_from_this<FramePool>
+{
+public:
+    static std::shared_ptr<FramePool> create(int capacity);
+    ~FramePool();
+
+    FramePool(const FramePool &) = delete;
+    FramePool &operator=(const FramePool &) = delete;
+
+    /**
+     * @brief 取一个空闲缓冲区
+     * 尺寸或格式变化时旧缓冲区逐步淘汰，仅在此时发生分配。
+     * @return 池耗尽时返回空 QImage
+     */
+    QImage acquire(const QSize &size, QImage::Format format);
+
+    int capacity() const { return m_capacity; }
+    int outstanding() const { return m_outstanding.loadRelaxed(); }
+    quint64 allocations() const { return m_allocations.loadRelaxed(); }   // 累计缓冲区分配次数
+    quint64 exhausted() const { return m_exhausted.loadRelaxed(); }       // 因池耗尽而失败的次数
+
+private:
+    struct Slot {
+        uchar *data = nullptr;
+        QSize size;
+        QImage::Format format = QImage::Format_Invalid;
+        qsizetype bytesPerLine = 0;
+        std::weak_ptr<FramePool> pool;
+    };
+
+    explicit FramePool(int capacity);
+
+    static void releaseImage(void *info);
+    void release(Slot *slot);
+    static void freeSlot(Slot *slot);
+
+    const int m_capacity;
+    QMutex m_mutex;
+    QVector<Slot *> m_free;                 // 空闲缓冲区（由池持有）
+    QAtomicInteger<int> m_outstanding = 0;  // 已借出数量
+    QAtomicInteger<quint64> m_allocations = 0;
+    QAtomicInteger<quint64> m_exhausted = 0;
+};
+
+#endif // FRAMEPOOL_H
@@ -0,0 +1,123 @@
+#ifndef INPUTSHAPING_H
+#define INPUTSHAPING_H
+
+#include <QString>
+#include <QMutex>
+#include <atomic>
+#include "backend/ruddercontroller.h"
+
+/**
+ * @brief 单轴整形参数
+ *
+ * 处理顺序：轴向死区 → 曲线 → 增益/反向 → 低通 → 限速。
+ */
+struct AxisShapingConfig {
+    enum Curve { Linear, Expo, Power };
+
+    float deadzone = 0.05f;         // 轴向死区（归一化）
+    bool deadzoneRescale = false;   // true：死区外重新映射到 [0, 1]；false：死区外原值输出
+    Curve curve = Linear;
+    float expo = 0.0f;              // Expo：out = (1 - e)·x + e·x³，e ∈ [0, 1]
+    float exponent = 1.0f;          // Power：out = sign(x)·|x|^p
+    float gain = 1.0f;              // 输出比例（限制最大推力 / 舵角）
+    bool invert = false;
+    float lowPassHz = 0.0f;         // 一阶低通截止频率，0 关闭
+    float slewPerSecond = 0.0f;     // 每秒最大变化量（满量程为 1），0 不限速
+
+    bool isFiltered() const { return lowPassHz > 0.0f || slewPerSecond > 0.0f; }
+};
+
+/**
+ * @brief 单摇杆整形参数：先做半径死区（X/Y 合成），再分别做单轴整形
+ */
+struct StickShapingConfig {
+    float radialDeadzone = 0.0f;    // 0 关闭；死区外按半径重新映射，方向不变
+    AxisShapingConfig x;
+    AxisShapingConfig y;
+};
+
+/**
+ * @brief 左右摇杆的整形配置，按船只保存在 input_shaping.ini
+ *
+ * 文件先读 [default] 组，再用 [船名] 组覆盖；键名如 left/radial_deadzone、
+ * left_y/curve（linear / expo / power）、left_y/expo、right_x/slew_per_second。
+ * 无配置时为默认值：0.05 轴向死区、线性，与原先的映射一致。
+ */
+struct InputShapingConfig {
+    StickShapingConfig left;
+    StickShapingConfig right;
+
+    static InputShapingConfig load(const QString &boatName);
+
+    /// 配置文件路径（命令行设置）；为空时使用应用配置目录下的 input_shaping.ini
+    static void setConfigFile(const QString &path);
+    static QString configFile();
+};
+
+/**
+ * @brief InputShaper —— 四轴输入整形流水线
+ *
+ * setConfig() 时把每个轴编译为一个特化的处理函数：曲线类型与是否带滤波为模板参数，
+ * 线性曲线不查表，Expo / Power 曲线预计算为 257 点查表（奇对称，线性插值），
+ * 不带滤波的轴没有滤波状态与分支。每周期四轴整形只有几次乘加与查表。
+ *
+ * 低通与限速依赖周期 dt：由固定频率控制循环调用时传入实际周期；
+ * dt 为 0（按变化发布的路径）时跳过这两级，只做无状态整形。
+ *
+ * shape() 只在一个线程调用；setConfig() 可在任意线程调用，新配置在下一次 shape() 生效，
+ * 平时每次 shape() 只多一次原子读。
+ */
+class InputShaper
+{
+public:
+    InputShaper();
+
+    void setConfig(const InputShapingConfig &config);
+    InputShapingConfig config() const;
+
+    RudderState shape(const RudderState &input, double dtSeconds);
+
+    /// 清除滤波状态（切换控制模式后从当前输入重新开始）
+    void reset();
+
+private:
+    static constexpr int kLutSize = 257;
+
+    struct CompiledAxis;
+    using AxisFn = float (*)(CompiledAxis &axis, float x, float dt);
+
+    struct CompiledAxis {
+        AxisFn fn = nullptr;
+        AxisShapingConfig config;
+        float scale = 1.0f;             // gain，反向时取负
+        float lut[kLutSize] = {};       // |x| ∈ [0, 1] 上的曲线值（仅 Expo / Power）
+        float filterState = 0.0f;       // 上一周期输出
+        float alphaDt = -1.0f;          // 低通系数对应的 dt（dt 不变时复用）
+        float alpha = 1.0f;
+    };
+
+    struct CompiledStick {
+        float radialDeadzone = 0.0f;
+        CompiledAxis x;
+        CompiledAxis y;
+    };
+
+    template <AxisShapingConfig::Curve C, bool Filtered>
+    static float processAxis(CompiledAxis &axis, float x, float dt);
+
+    static void compileAxis(CompiledAxis &axis, const AxisShapingConfig &config);
+    static void shapeStick(CompiledStick &stick, float &x, float &y, float dt);
+    void applyPending();
+
+    // 仅 shape() 所在线程访问
+    CompiledStick m_left;
+    CompiledStick m_right;
+    quint32 m_appliedVersion = 0;
+
+    // setConfig() 与 shape() 之间交接
+    mutable QMutex m_pendingMutex;
+    InputShapingConfig m_pending;
+    std::atomic<quint32> m_pendingVersion { 0 };
+};
+
+#endif // INPUTSHAPING_H
@@ -0,0 +1,102 @@
+#ifndef LATENCYTRACKER_H
+#define LATENCYTRACKER_H
+
+#include <QtGlobal>
+#include <QVector>
+#include <atomic>
+#include <cstdint>
+
+extern "C" {
+    #include <libavutil/rational.h>
+}
+
+/**
+ * @brief 延迟统计快照（最近一个窗口内的显示帧）
+ */
+struct LatencySnapshot {
+    int samples = 0;
+    bool glassToGlass = false;  // true：以 RTCP 发送端报告推算的采集时间为起点；false：以收包时间为起点
+    double p50Ms = 0.0;
+    double p95Ms = 0.0;
+    double p99Ms = 0.0;
+    double maxMs = 0.0;
+    double receiveToDisplayP50Ms = 0.0;     // 收包 → 显示（本机流水线部分）
+    double decodeP50Ms = 0.0;               // 收包 → 解码完成
+    double convertP50Ms = 0.0;              // 解码完成 → 转换完成（含帧队列等待）
+    double handoffP50Ms = 0.0;              // 转换完成 → 界面取走
+    double jitterMs = 0.0;                  // 到达抖动（RFC 3550 到达间隔抖动）
+    double bitrateKbps = 0.0;               // 自上次快照以来的接收码率
+};
+
+/**
+ * @brief LatencyTracker —— 逐帧延迟采集（收包、解码、转换、显示）
+ *
+ * 各级线程按 pts 在固定大小的时间戳表中记录各自的完成时间（steady 时钟微秒），
+ * 界面取帧时汇总成一个样本。流带有 RTCP 发送端报告时（RTSP 的 start_time_realtime），
+ * pts 可换算为摄像头采集时的墙钟时间，样本即为端到端（glass-to-glass）延迟；
+ * 否则只统计从收包开始的本机延迟。端到端延迟要求摄像头与本机时钟已同步（NTP）。
+ *
+ * 时间戳表无锁：每个字段原子读写，pts 冲突时新帧覆盖旧帧（统计用途，可接受）。
+ * 样本窗口与快照只在 GUI 线程访问。
+ */
+class LatencyTracker
+{
+public:
+    LatencyTracker();
+
+    /// 新连接会话（读包线程）
+    void beginSession(AVRational timeBase);
+    /// RTCP 映射：pts 为 0 时对应的墙钟时间（Unix 微秒）
+    void setRealtimeBase(qint64 startRealtimeUs);
+    bool hasRealtimeBase() const { return m_realtimeBaseUs.load(std::memory_order_relaxed) != kNone; }
+
+    void onPacket(int64_t pts, int bytes, qint64 nowUs);      // 读包线程
+    void onDecoded(int64_t pts, qint64 nowUs);                // 解码线程
+    void onConverted(int64_t pts, qint64 nowUs);              // 转换线程
+    void onDisplayed(int64_t pts, qint64 nowUs);              // GUI 线程
+
+    LatencySnapshot snapshot(qint64 nowUs);                   // GUI 线程
+
+private:
+    static constexpr qint64 kNone = INT64_MIN;
+    static constexpr int kSlots = 256;
+    static constexpr int kWindow = 300;     // 约 10 秒 @30fps
+
+    struct Slot {
+        std::atomic<int64_t> pts { kNone };
+        std::atomic<qint64> receivedUs { 0 };
+        std::atomic<qint64> decodedUs { 0 };
+        std::atomic<qint64> convertedUs { 0 };
+    };
+    struct Sample {
+        double latencyMs;
+        double receiveToDisplayMs;
+        double decodeMs;
+        double convertMs;
+        double handoffMs;
+    };
+
+    Slot *slotFor(int64_t pts);
+
+    Slot m_slots[kSlots];
+    const qint64 m_wallOffsetUs;                    // 墙钟 - steady 时钟
+    std::atomic<int> m_timeBaseNum { 1 };
+    std::atomic<int> m_timeBaseDen { 90000 };
+    std::atomic<qint64> m_realtimeBaseUs { kNone };
+
+    // 读包线程
+    int64_t m_lastPts = kNone;
+    qint64 m_lastArrivalUs = 0;
+    double m_jitterUs = 0.0;
+    std::atomic<qint64> m_jitterReportUs { 0 };
+    std::atomic<quint64> m_bytes { 0 };
+
+    // GUI 线程
+    QVector<Sample> m_window;
+    int m_windowPos = 0;
+    int64_t m_lastDisplayedPts = kNone;
+    quint64 m_lastBytes = 0;
+    qint64 m_lastSnapshotUs = 0;
+};
+
+#endif // LATENCYTRACKER_H
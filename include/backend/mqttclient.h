@@ -6,7 +6,9 @@
 #include <QJsonObject>
 #include <QJsonDocument>
 #include <QTimer>
+#include <QQueue>
 #include "waveconfig.h"
+#include "backend/controllatency.h"
 
 class MqttClient : public QObject
 {
@@ -25,6 +27,11 @@ public:
     void setCurrentBoat(const QString &boatName);
     QString getCurrentBoat() const;
 
+    // 船队监控：用通配符订阅所有船只的传感器主题
+    void setFleetMonitoring(bool enabled);
+    bool isFleetMonitoring() const { return m_fleetMonitoring; }
+    QString currentBoat() const { return m_currentBoat; }
+
     // 订阅管理
     void subscribeToAllSensors();
     void subscribeToTopic(const QString &topic);
@@ -32,9 +39,13 @@ public:
     void unsubscribeFromAll();
 
     // 发布消息
-    void publishThrusters(double leftThrust, double rightThrust, double leftPos, double rightPos);
+    // sampledUs / dispatchedUs：摇杆采样与 ControllerBridge 收到指令的时间（ControlLatencyTracker::nowUs），
+    // 非 0 时记录该指令的控制延迟
+    void publishThrusters(double leftThrust, double rightThrust, double leftPos, double rightPos,
+                          qint64 sampledUs = 0, qint64 dispatchedUs = 0);
     void publishControlStatus(const QString &states);
-    void publishMessage(const QString &topic, const QByteArray &message, quint8 qos = 0);
+    // 未连接或发布失败时发出 errorOccurred 并返回 false
+    bool publishMessage(const QString &topic, const QByteArray &message, quint8 qos = 0);
     void publishWaveConfig(const WaveConfig& config);
     // 修改方法签名，使用WaveConfig而不是QJsonObject
     void publishWaveEnvironment(const WaveConfig& config);
@@ -49,6 +60,10 @@ public:
     // 添加获取当前配置的方法
     WaveConfig getCurrentWaveConfig() const { return m_currentWaveConfig; }
 
+    // 控制延迟统计（GUI 线程）
+    ControlLatencySnapshot controlLatency() const { return m_controlLatency.snapshot(); }
+    QString controlLatencyReport() const { return m_controlLatency.report(); }
+
     // 获取状态信息
     QString connectionState() const;
     QList<QString> subscribedTopics() const;
@@ -66,6 +81,9 @@ signals:
     void gpsDataReceived(const QJsonObject &data);
     void speedDataReceived(const QJsonObject &data);
     void environmentDataReceived(const QJsonObject &data);
+    // 船队数据信号（仅船队监控模式下发射）：sensorType 为 "imu" / "gps" / "speed"
+    void fleetSensorDataReceived(const QString &boatName, const QString &sensorType,
+                                 const QJsonObject &data);
     // 船只切换信号
     void boatChanged(const QString& boatName);
     // 添加波浪配置变化信号
@@ -78,6 +96,7 @@ private slots:
     void onStateChanged(QMqttClient::ClientState state);
     void onMessageReceived(const QByteArray &message, const QMqttTopicName &topic);
     void onPingResponseReceived();
+    void onTransportBytesWritten();
 
 private:
     void setupMqttClient();
@@ -111,6 +130,16 @@ private:
 
     QList<QString> m_subscribedTopics;
     bool m_autoPublishEnabled = false;
+
+    // 已交给 QMqttClient、尚未写入套接字的推力指令时间戳
+    struct PendingControl {
+        qint64 sampledUs;
+        qint64 dispatchedUs;
+        qint64 serializedUs;
+    };
+    QQueue<PendingControl> m_pendingControl;
+    ControlLatencyTracker m_controlLatency;
+    bool m_fleetMonitoring = false;   // 船队监控（通配符订阅）
 };
 
 #endif // MQTTCLIENT_H
@@ -0,0 +1,112 @@
+#ifndef PACKETRING_H
+#define PACKETRING_H
+
+#include <QVector>
+#include <QMutex>
+#include <memory>
+
+extern "C" {
+    #include <libavcodec/avcodec.h>
+}
+
+/**
+ * @brief 从回放环中取出的压缩包（数据为独立拷贝，调用方负责 av_packet_free）
+ */
+struct ReplayPacket {
+    AVPacket *packet = nullptr;
+    qint64 wallMs = 0;
+    quint64 seq = 0;
+};
+
+/**
+ * @brief PacketRing —— 即时回放环：最近一段时间的压缩视频包
+ *
+ * 只保存解复用后的压缩包（几 Mbps），而不是解码后的 RGB 帧（每秒数百 MB）。
+ * 包数据写入按字节预算一次性分配的环形内存区，写满后从最旧的包开始淘汰，
+ * 并且始终淘汰到关键帧边界：环中最旧的包总是关键帧，任意时刻都能从中解码。
+ *
+ * 读包线程 append，回放引擎 extract（拷贝出所需 GOP 后立即释放锁）。
+ * 每个连接会话对应一组编码参数，会话变化（重连）时清空环。
+ */
+class PacketRing
+{
+public:
+    struct Span {
+        qint64 firstMs = 0;     // 最旧包的到达时间（Unix 毫秒）
+        qint64 lastMs = 0;      // 最新包的到达时间
+        int packets = 0;
+        qint64 bytes = 0;
+        bool isValid() const { return packets > 0; }
+    };
+
+    struct ExtractInfo {
+        quint64 generation = 0;
+        quint64 keySeq = 0;         // 所在 GOP 关键帧的序号
+        quint64 lastSeq = 0;        // 取出的最后一个包的序号
+        qint64 lastWallMs = 0;
+        bool resumed = false;       // true：只取出了 resumeAfterSeq 之后的包，可在现有解码状态上继续
+    };
+
+    explicit PacketRing(qint64 budgetBytes);
+    ~PacketRing();
+
+    PacketRing(const PacketRing &) = delete;
+    PacketRing &operator=(const PacketRing &) = delete;
+
+    /// 字节预算（0 表示关闭回放）；预算变化时清空并在下一个包到达时重新分配
+    void setBudget(qint64 bytes);
+    qint64 budget() const;
+
+    // ---- 读包线程 ----
+    void beginSession(const AVCodecParameters *par, AVRational timeBase);
+    void append(const AVPacket *pkt, qint64 wallMs);
+
+    // ---- 回放引擎 ----
+    Span span() const;
+    quint64 generation() const;
+    /// 当前会话的编码参数；环为空或未开始会话时返回 false
+    bool copyParams(AVCodecParameters *out, AVRational *timeBase, quint64 *generation) const;
+    /**
+     * @brief 取出解码到 targetMs 所需的包：targetMs 之前最近的关键帧起，到 targetMs 为止
+     * 若关键帧就是 resumeKeySeq，且 resumeAfterSeq 仍在环中并早于 targetMs，
+     * 只取出其后的包（向前拖动时不必重复解码整个 GOP）。
+     */
+    bool extract(qint64 targetMs, quint64 resumeKeySeq, quint64 resumeAfterSeq,
+                 QVector<ReplayPacket> &out, ExtractInfo *info) const;
+
+private:
+    struct Entry {
+        qint64 offset = 0;
+        int size = 0;
+        int flags = 0;
+        int64_t pts = 0;
+        int64_t dts = 0;
+        int64_t duration = 0;
+        qint64 wallMs = 0;
+        quint64 seq = 0;
+    };
+
+    const Entry &at(int i) const { return m_entries[(m_head + i) % m_entries.size()]; }
+    void clearLocked();
+    void evictOldestLocked();
+    bool overlapsOldestLocked(qint64 offset, int size) const;
+
+    mutable QMutex m_mutex;
+    qint64 m_budget;
+    std::unique_ptr<uint8_t[]> m_arena;     // 预分配的包数据区（首个包到达时分配）
+    qint64 m_arenaSize = 0;
+    qint64 m_writePos = 0;
+    qint64 m_bytes = 0;
+
+    QVector<Entry> m_entries;               // 固定容量的包索引环
+    int m_head = 0;
+    int m_count = 0;
+    quint64 m_nextSeq = 1;
+    bool m_needKey = true;
+
+    AVCodecParameters *m_params = nullptr;
+    AVRational m_timeBase { 0, 1 };
+    quint64 m_generation = 0;
+};
+
+#endif // PACKETRING_H
@@ -0,0 +1,79 @@
+#ifndef REPLAYENGINE_H
+#define REPLAYENGINE_H
+
+#include <QObject>
+#include <QImage>
+#include <QMutex>
+#include <QWaitCondition>
+#include <atomic>
+#include <memory>
+#include "backend/packetring.h"
+#include "backend/framepool.h"
+
+class QThread;
+
+extern "C" {
+    #include <libavcodec/avcodec.h>
+    #include <libswscale/swscale.h>
+}
+
+/**
+ * @brief ReplayEngine —— 即时回放：按需从回放环解码任意时刻的画面
+ *
+ * 拖动时只需要目标时刻的一帧：从目标之前最近的关键帧开始解码到目标为止，
+ * 不保留中间帧。继续向后拖动且仍在同一 GOP 内时，在现有解码状态上只解码新增的包。
+ *
+ * 解码在独立线程中进行，seek 请求合并：拖动过快时只处理最新的目标时刻。
+ * 使用独立的解码器实例，不影响实时画面。
+ */
+class ReplayEngine : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit ReplayEngine(QObject *parent = nullptr);
+    ~ReplayEngine();
+
+    /// 回放源（解码器的回放环）；切换源时重置解码状态
+    void setSource(const std::shared_ptr<PacketRing> &ring);
+    std::shared_ptr<PacketRing> source() const;
+
+    /// 请求显示 wallMs（Unix 毫秒）时刻的画面（线程安全，异步）
+    void seek(qint64 wallMs);
+    /// 输出尺寸（设备像素，保持宽高比），空尺寸表示源分辨率
+    void setOutputSize(const QSize &size);
+
+signals:
+    /// 目标时刻的画面；wallMs 为该帧对应包的到达时间
+    void frameReady(const QImage &frame, qint64 wallMs);
+
+private:
+    void workerLoop();
+    void decodeTo(qint64 targetMs);
+    bool openCodec(const std::shared_ptr<PacketRing> &ring);
+    void resetCodec();
+    void emitFrame(qint64 wallMs);
+
+    QThread *m_thread = nullptr;
+    mutable QMutex m_mutex;
+    QWaitCondition m_wake;
+    bool m_quit = false;
+    bool m_hasRequest = false;
+    qint64 m_requestMs = 0;
+    std::shared_ptr<PacketRing> m_ring;     // 受 m_mutex 保护
+    QSize m_outputSize;                     // 受 m_mutex 保护
+
+    // 工作线程独占
+    std::shared_ptr<PacketRing> m_activeRing;
+    AVCodecContext *m_codec = nullptr;
+    AVFrame *m_frame = nullptr;
+    AVFrame *m_lastFrame = nullptr;
+    bool m_haveFrame = false;
+    SwsContext *m_sws = nullptr;
+    quint64 m_generation = 0;
+    quint64 m_keySeq = 0;
+    quint64 m_lastSeq = 0;
+    std::shared_ptr<FramePool> m_framePool;
+};
+
+#endif // REPLAYENGINE_H
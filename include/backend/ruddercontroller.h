@@ -4,6 +4,8 @@
 #include <QThread>
 #include <QVector>
 #include <QMutex>
+#include <QElapsedTimer>
+#include <atomic>
 
 /**
  * @brief 表示左右摇杆的输入状态
@@ -13,6 +15,8 @@ struct RudderState {
     float leftY = 0.0f;
     float rightX = 0.0f;
     float rightY = 0.0f;
+    // 读到该输入时的 steady 时钟微秒（ControlLatencyTracker::nowUs），0 表示不参与延迟统计
+    qint64 sampledUs = 0;
 
     // 为了方便调试输出
     QString toString() const {
@@ -30,8 +34,80 @@ struct RudderState {
     }
 };
 
+/**
+ * @brief RudderStateSnapshot —— 摇杆状态的无锁快照（单写者顺序锁）
+ *
+ * 手柄线程每次采样都写入，其他线程随时读取最新值，双方都不加锁。
+ * 读取期间若发生写入则重试，保证四个轴来自同一次采样。
+ */
+class RudderStateSnapshot
+{
+public:
+    /// 写端：仅手柄线程调用
+    void store(const RudderState &state)
+    {
+        const quint32 seq = m_seq.load(std::memory_order_relaxed);
+        m_seq.store(seq + 1, std::memory_order_relaxed);        // 奇数：写入中
+        std::atomic_thread_fence(std::memory_order_release);
+        m_leftX.store(state.leftX, std::memory_order_relaxed);
+        m_leftY.store(state.leftY, std::memory_order_relaxed);
+        m_rightX.store(state.rightX, std::memory_order_relaxed);
+        m_rightY.store(state.rightY, std::memory_order_relaxed);
+        m_sampledUs.store(state.sampledUs, std::memory_order_relaxed);
+        m_seq.store(seq + 2, std::memory_order_release);
+    }
+
+    /// 读端：任意线程
+    RudderState load() const
+    {
+        RudderState state;
+        for (;;) {
+            const quint32 begin = m_seq.load(std::memory_order_acquire);
+            if (begin & 1)
+                continue;
+            state.leftX = m_leftX.load(std::memory_order_relaxed);
+            state.leftY = m_leftY.load(std::memory_order_relaxed);
+            state.rightX = m_rightX.load(std::memory_order_relaxed);
+            state.rightY = m_rightY.load(std::memory_order_relaxed);
+            state.sampledUs = m_sampledUs.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (m_seq.load(std::memory_order_relaxed) == begin)
+                return state;
+        }
+    }
+
+    /// 写入次数，读端可据此判断是否有新采样
+    quint32 version() const { return m_seq.load(std::memory_order_acquire) / 2; }
+
+private:
+    std::atomic<quint32> m_seq { 0 };
+    std::atomic<float> m_leftX { 0.0f };
+    std::atomic<float> m_leftY { 0.0f };
+    std::atomic<float> m_rightX { 0.0f };
+    std::atomic<float> m_rightY { 0.0f };
+    std::atomic<qint64> m_sampledUs { 0 };
+};
+
+/**
+ * @brief RudderInputConfig —— 摇杆输入源选择（命令行设置，线程启动前生效）
+ */
+struct RudderInputConfig {
+    QString replayFile;         // 非空时回放录制文件，不读取手柄
+    double replaySpeed = 1.0;   // 回放倍速，0 表示尽快回放
+    bool replayLoop = false;
+    QString recordFile;         // 非空时把收到的输入写入录制文件
+    QString evdevDevice;        // Linux：指定 /dev/input/eventN，为空时自动查找
+};
+
+class RudderInputSource;
+class RudderInputRecorder;
+
 /**
  * @brief 手柄控制器类 - 实时检测摇杆输入
+ *
+ * 回放文件与 Linux evdev 输入为事件驱动（RudderInputSource）；Windows 仍由 SDL/XInput 定时读取。
+ * 每次采样只写入无锁快照（getCurrentState() 随时可读），rudderUpdated 仅在任一轴变化
+ * 超过阈值或回到零位时发出，静止时只有低频保活，避免每个采样都跨线程排队。
  */
 class RudderController : public QThread
 {
@@ -41,8 +117,12 @@ public:
     explicit RudderController(QObject *parent = nullptr);
     ~RudderController();
 
-    // 获取当前手柄状态（线程安全）
-    RudderState getCurrentState();
+    // 获取当前手柄状态（线程安全，无锁）
+    RudderState getCurrentState() const;
+
+    // 采样次数 / 实际发出 rudderUpdated 的次数
+    quint64 sampleCount() const { return m_samples.load(std::memory_order_relaxed); }
+    quint64 emitCount() const { return m_emits.load(std::memory_order_relaxed); }
 
     // 获取控制器连接状态
     bool isControllerConnected() const;
@@ -50,6 +130,10 @@ public:
     // 停止检测线程
     void stopDetection();
 
+    // 输入源配置（需在 start() 前设置）
+    static void setInputConfig(const RudderInputConfig &config);
+    static RudderInputConfig inputConfig();
+
 signals:
     // 手柄状态更新信号
     void rudderUpdated(const RudderState &state);
@@ -61,16 +145,31 @@ protected:
 
 private:
     // 当前手柄状态
-    RudderState m_currentState;
-    // 线程安全互斥锁
-    QMutex m_mutex;
+    RudderStateSnapshot m_snapshot;
     // 运行标志
-    volatile bool m_running;
+    std::atomic<bool> m_running;
     // 控制器连接状态
-    bool m_controllerConnected;
+    std::atomic<bool> m_controllerConnected;
+
+    // 以下仅手柄线程访问
+    RudderState m_lastEmitted;
+    bool m_hasEmitted = false;
+    QElapsedTimer m_sinceEmit;
+    RudderInputRecorder *m_recorder = nullptr;
+
+    std::atomic<quint64> m_samples { 0 };
+    std::atomic<quint64> m_emits { 0 };
+
+    // 当前事件驱动输入源，stopDetection() 通过它唤醒线程
+    RudderInputSource *m_source = nullptr;
+    QMutex m_sourceMutex;
 
-    // 更新状态（线程安全）
-    void updateState(const RudderState &newState);
+    // 写入快照；变化超过阈值、force 或保活到期时发出 rudderUpdated
+    bool publish(const RudderState &state, bool force = false);
+    // 距离下一次保活的毫秒数
+    int keepaliveRemainingMs() const;
+    // 事件驱动输入循环
+    void runSource(RudderInputSource *source);
 };
 
 #endif // RUDDERCONTROLLER_H
@@ -0,0 +1,93 @@
+#ifndef RUDDERINPUT_H
+#define RUDDERINPUT_H
+
+#include <QString>
+#include <QVector>
+#include <QFile>
+#include <QTextStream>
+#include <QElapsedTimer>
+#include <mutex>
+#include <condition_variable>
+#include "backend/ruddercontroller.h"
+
+/**
+ * @brief RudderInputSource —— 摇杆输入源（事件驱动）
+ *
+ * RudderController 的线程阻塞在 wait() 上，直到有新的输入、超时或被 interrupt() 唤醒，
+ * 不再固定周期轮询。实现：Linux evdev 设备（EvdevInputSource）、录制文件回放（ReplayInputSource）。
+ */
+class RudderInputSource
+{
+public:
+    enum WaitResult {
+        Updated,        // state 已更新为最新输入
+        Timeout,        // 超时或被 interrupt() 唤醒
+        Disconnected,   // 设备断开（state 清零）
+        Finished        // 输入结束（回放文件读完）
+    };
+
+    virtual ~RudderInputSource() = default;
+
+    /// 初始化；设备暂不存在不算失败（等待热插拔），只有无法工作时返回 false
+    virtual bool open(QString *error) = 0;
+    /// 阻塞等待下一次输入，最多 timeoutMs 毫秒
+    virtual WaitResult wait(RudderState &state, int timeoutMs) = 0;
+    /// 从其他线程唤醒正在 wait() 的线程（停止时调用）
+    virtual void interrupt() = 0;
+    virtual bool isConnected() const = 0;
+    virtual QString name() const = 0;
+};
+
+/**
+ * @brief ReplayInputSource —— 录制输入回放
+ *
+ * 文件为 RudderInputRecorder 写出的 CSV（毫秒,LX,LY,RX,RY），按录制时的时间间隔重放，
+ * 不需要手柄即可测试和测量控制链路。speed 为回放倍速，0 表示不等待、尽快回放。
+ */
+class ReplayInputSource : public RudderInputSource
+{
+public:
+    ReplayInputSource(const QString &path, double speed = 1.0, bool loop = false);
+
+    bool open(QString *error) override;
+    WaitResult wait(RudderState &state, int timeoutMs) override;
+    void interrupt() override;
+    bool isConnected() const override { return true; }
+    QString name() const override;
+
+private:
+    struct Sample {
+        qint64 ms = 0;
+        RudderState state;
+    };
+
+    QString m_path;
+    double m_speed;
+    bool m_loop;
+    QVector<Sample> m_samples;
+    int m_next = 0;
+    QElapsedTimer m_clock;          // 当前一轮回放的起点
+
+    std::mutex m_mutex;
+    std::condition_variable m_cond;
+    bool m_interrupted = false;
+};
+
+/**
+ * @brief RudderInputRecorder —— 把输入写入录制文件（供 ReplayInputSource 回放）
+ */
+class RudderInputRecorder
+{
+public:
+    bool open(const QString &path, QString *error);
+    void record(const RudderState &state);
+    void close();
+    bool isOpen() const { return m_file.isOpen(); }
+
+private:
+    QFile m_file;
+    QTextStream m_out;
+    QElapsedTimer m_clock;
+};
+
+#endif // RUDDERINPUT_H
@@ -0,0 +1,54 @@
+#ifndef SENSORMATH_H
+#define SENSORMATH_H
+
+#include <QJsonObject>
+#include <cmath>
+
+/**
+ * @brief 姿态角（单位：度）
+ */
+struct EulerAngles {
+    double roll = 0.0;
+    double pitch = 0.0;
+    double yaw = 0.0;
+};
+
+/**
+ * @brief 四元数 → 欧拉角（度）
+ */
+inline EulerAngles quaternionToEulerDeg(double x, double y, double z, double w)
+{
+    constexpr double kRadToDeg = 180.0 / M_PI;
+    EulerAngles e;
+
+    const double sinr_cosp = 2.0 * (w * x + y * z);
+    const double cosr_cosp = 1.0 - 2.0 * (x * x + y * y);
+    e.roll = std::atan2(sinr_cosp, cosr_cosp) * kRadToDeg;
+
+    const double sinp = 2.0 * (w * y - z * x);
+    if (std::abs(sinp) >= 1.0) {
+        e.pitch = std::copysign(M_PI / 2.0, sinp) * kRadToDeg;
+    } else {
+        e.pitch = std::asin(sinp) * kRadToDeg;
+    }
+
+    const double siny_cosp = 2.0 * (w * z + x * y);
+    const double cosy_cosp = 1.0 - 2.0 * (y * y + z * z);
+    e.yaw = std::atan2(siny_cosp, cosy_cosp) * kRadToDeg;
+
+    return e;
+}
+
+/**
+ * @brief 从 IMU 消息的 orientation 字段解析姿态角（度）
+ */
+inline EulerAngles eulerFromImuJson(const QJsonObject &data)
+{
+    const QJsonObject orientation = data.value("orientation").toObject();
+    return quaternionToEulerDeg(orientation.value("x").toDouble(0.0),
+                                orientation.value("y").toDouble(0.0),
+                                orientation.value("z").toDouble(0.0),
+                                orientation.value("w").toDouble(1.0));
+}
+
+#endif // SENSORMATH_H
@@ -0,0 +1,73 @@
+#ifndef STREAMMANAGER_H
+#define STREAMMANAGER_H
+
+#include <QObject>
+#include <QHash>
+#include <QSize>
+#include <QStringList>
+#include "backend/ffmpegdecoder.h"
+
+/**
+ * @brief StreamManager —— 多路摄像头流管理（热备切换）
+ *
+ * 每个 URL 对应一个 FFmpegDecoder。预置流（addStandby）启动后即在后台保持连接，
+ * 处于备用模式：只缓存最近一个 GOP 并解码关键帧。
+ * 切换时把原活动流转为备用、新流转为活动，界面立即拿到新流的最新关键帧，
+ * 随后解码器回放 GOP 追到实时画面，不再需要重新连接与探测。
+ *
+ * 只转发活动流的信号。即时回放环只为活动流开启，备用流与宫格中的其他流不占用回放内存。
+ */
+class StreamManager : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit StreamManager(QObject *parent = nullptr);
+
+    /// 登记预置流并在后台建立连接（备用）
+    void addStandby(const QString &url);
+
+    /// 切换显示的流；未登记的 URL 作为临时流新建
+    void activate(const QString &url);
+
+    /// 停止显示：预置流转为备用，临时流关闭
+    void deactivate();
+
+    FFmpegDecoder *activeDecoder() const;
+    QString activeUrl() const { return m_activeUrl; }
+    FFmpegDecoder *decoder(const QString &url) const;
+    QStringList standbyUrls() const { return m_standbyOrder; }
+
+    /// 宫格模式：所有预置流转为活动解码（质量与输出尺寸由各图块自行设置）
+    void setMosaicMode(bool enabled);
+    bool isMosaicMode() const { return m_mosaic; }
+
+    /// 显示尺寸同步给所有流（备用流的关键帧画面也按该尺寸输出，切换后可直接显示）
+    void setOutputSize(const QSize &size);
+
+    /// 显示表面后备缓冲的像素格式同步给所有流（宫格图块在同一窗口内，格式相同）
+    void setOutputFormat(QImage::Format format);
+
+signals:
+    void frameAvailable();
+    void stateChanged(int state);
+    void errorOccurred(const QString &errorMessage);
+
+private:
+    struct Entry {
+        FFmpegDecoder *decoder = nullptr;
+        bool persistent = false;    // 预置流：停用后保持备用连接
+    };
+
+    FFmpegDecoder *createDecoder(const QString &url, bool persistent);
+    void ensureRunning(FFmpegDecoder *decoder, const QString &url);
+
+    QHash<QString, Entry> m_streams;
+    QStringList m_standbyOrder;     // 预置流登记顺序
+    QString m_activeUrl;
+    bool m_mosaic = false;
+    QSize m_outputSize;
+    QImage::Format m_outputFormat = QImage::Format_RGB32;
+};
+
+#endif // STREAMMANAGER_H
@@ -0,0 +1,63 @@
+#ifndef STREAMPARAMCACHE_H
+#define STREAMPARAMCACHE_H
+
+#include <QString>
+#include <QByteArray>
+#include <QHash>
+#include <QMutex>
+
+extern "C" {
+    #include <libavcodec/avcodec.h>
+}
+
+/**
+ * @brief StreamParamCache —— 按 URL 缓存视频流的编码参数（持久化到磁盘）
+ *
+ * 首次（冷）打开时 avformat_find_stream_info 探测得到的编码参数与 extradata（SPS/PPS）
+ * 写入缓存；再次打开同一 URL（热）时直接填回 codecpar，跳过探测，
+ * 解码器从第一个关键帧开始工作。
+ *
+ * 缓存只是提示：SDP 中已有的 extradata 优先；首帧参数与缓存不一致时由解码器更新缓存。
+ * 多个解码器的读包线程会并发访问，内部加锁。
+ */
+class StreamParamCache
+{
+public:
+    static StreamParamCache &instance();
+
+    /// 用缓存填充 par；无缓存或编码类型不符时返回 false（需要完整探测）
+    bool apply(const QString &url, AVCodecParameters *par) const;
+
+    /// 记录探测 / 解码得到的参数并写盘
+    void store(const QString &url, const AVCodecParameters *par);
+
+    /// 缓存失效（热打开失败时调用）
+    void remove(const QString &url);
+
+private:
+    struct Entry {
+        int codecId = AV_CODEC_ID_NONE;
+        int width = 0;
+        int height = 0;
+        int format = -1;            // AVPixelFormat
+        int profile = 0;
+        int level = 0;
+        int sarNum = 0;
+        int sarDen = 1;
+        int colorRange = 0;
+        int colorSpace = 0;
+        int fieldOrder = 0;
+        QByteArray extradata;
+    };
+
+    StreamParamCache();
+    void load();
+    void save(const QString &url, const Entry &entry) const;
+    static QString groupFor(const QString &url);
+
+    QString m_path;
+    mutable QMutex m_mutex;
+    QHash<QString, Entry> m_entries;
+};
+
+#endif // STREAMPARAMCACHE_H
@@ -0,0 +1,124 @@
+#ifndef VIDEORECORDER_H
+#define VIDEORECORDER_H
+
+#include <QString>
+#include <QMutex>
+#include <atomic>
+#include "backend/boundedqueue.h"
+
+class QThread;
+
+extern "C" {
+    #include <libavformat/avformat.h>
+    #include <libavcodec/avcodec.h>
+}
+
+/**
+ * @brief 录像统计（累计值）
+ */
+struct VideoRecorderStats {
+    bool recording = false;
+    quint64 segments = 0;        // 已完成的分段数
+    quint64 bytesWritten = 0;
+    quint64 dropped = 0;         // 写入跟不上时丢弃的包（丢到下一个关键帧为止）
+    QString currentFile;
+};
+
+/**
+ * @brief VideoRecorder —— 零转码分段录像（fragmented MP4 流复制）
+ *
+ * 解码器读包线程把解复用后的视频包旁路给录像器（引用计数拷贝，不复制数据），
+ * 录像器在独立线程中用 avformat 原样封装为 fragmented MP4，不解码、不重新编码。
+ * 读包线程只做非阻塞入队：队列按包数与字节数双重限额，写盘跟不上时丢包
+ * 并等待下一个关键帧，绝不反压实时画面。
+ *
+ * 分段边界对齐遥测时间基准（Unix 毫秒，与 MQTT 传感器数据的时间戳一致）：
+ * 分段序号 = 墙钟时间 / 分段时长，跨入新序号后的第一个关键帧处切分。
+ * 包的墙钟时间由 pts 映射（首包到达时间为锚点，偏差过大时重新锚定），
+ * 每个分段关闭时在 <name>-index.csv 中追加一行：序号、文件、起止毫秒、包数、字节数，
+ * 用于与传感器日志对齐回放。
+ */
+class VideoRecorder
+{
+public:
+    VideoRecorder();
+    ~VideoRecorder();
+
+    VideoRecorder(const VideoRecorder &) = delete;
+    VideoRecorder &operator=(const VideoRecorder &) = delete;
+
+    /// 开始录像到 dir，文件名以 name 为前缀（GUI 线程）
+    bool start(const QString &dir, const QString &name);
+    /// 停止并关闭当前分段（GUI 线程）
+    void stop();
+    bool isRecording() const { return m_active.load(std::memory_order_relaxed); }
+
+    void setSegmentDuration(int seconds);
+
+    // ---- 以下由解码器读包线程调用，均不阻塞 ----
+    /// 新连接会话的视频流参数（重连后编码参数可能变化，录像器据此切分新段）
+    void beginSession(const AVCodecParameters *par, AVRational timeBase);
+    /// 旁路一个视频包；arrivalMs 为到达时的 Unix 毫秒
+    void push(const AVPacket *pkt, qint64 arrivalMs);
+
+    VideoRecorderStats stats() const;
+
+private:
+    struct Item {
+        AVPacket *packet = nullptr;             // 为空时表示停止标记
+        qint64 arrivalMs = 0;
+        quint64 session = 0;                    // 所属连接会话，对应 beginSession 的参数
+    };
+
+    void writerLoop();
+    bool adoptSession(quint64 session);
+    void writePacket(AVPacket *pkt, qint64 arrivalMs);
+    qint64 wallTimeFor(const AVPacket *pkt, qint64 arrivalMs);
+    bool openSegment(qint64 wallMs);
+    void closeSegment();
+    void appendIndex();
+    void drainQueue();
+
+    // 录像目标（start 时设置，写线程只读）
+    QString m_dir;
+    QString m_name;
+    std::atomic<int> m_segmentMs { 60 * 1000 };
+
+    // 生产者（读包线程）
+    std::atomic<bool> m_active { false };
+    bool m_producerNeedsKey = true;             // 丢包后等待关键帧
+    std::atomic<qint64> m_queuedBytes { 0 };
+    BoundedQueue<Item> m_queue;
+    QThread *m_thread = nullptr;
+
+    // 最近一次会话参数（读包线程写，写线程在遇到新会话的包时读取）；
+    // 同时串行化 push() 入队与 stop()
+    mutable QMutex m_mutex;
+    AVCodecParameters *m_latestParams = nullptr;
+    AVRational m_latestTimeBase { 0, 1 };
+    quint64 m_latestSession = 0;
+    QString m_currentFile;
+
+    // 写线程独占
+    quint64 m_session = 0;
+    AVCodecParameters *m_params = nullptr;
+    AVRational m_timeBase { 0, 1 };
+    AVFormatContext *m_output = nullptr;
+    qint64 m_segmentIndex = -1;
+    qint64 m_segmentStartMs = 0;
+    qint64 m_segmentEndMs = 0;
+    int64_t m_segmentFirstDts = AV_NOPTS_VALUE;
+    int64_t m_lastDts = AV_NOPTS_VALUE;
+    quint64 m_segmentPackets = 0;
+    quint64 m_segmentBytes = 0;
+    QString m_segmentFile;
+    int64_t m_anchorPts = AV_NOPTS_VALUE;       // pts → 墙钟映射锚点
+    qint64 m_anchorWallMs = 0;
+    bool m_writerNeedsKey = true;
+
+    std::atomic<quint64> m_segments { 0 };
+    std::atomic<quint64> m_bytesWritten { 0 };
+    std::atomic<quint64> m_dropped { 0 };
+};
+
+#endif // VIDEORECORDER_H
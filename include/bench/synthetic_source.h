@@ -0,0 +1,68 @@
+#ifndef SYNTHETIC_SOURCE_H
+#define SYNTHETIC_SOURCE_H
+
+#include <QString>
+#include <atomic>
+
+class QThread;
+
+/**
+ * @brief 合成测试片段参数
+ */
+struct SyntheticSpec {
+    QString name;           // 720p / 1080p / 4k
+    int width = 0;
+    int height = 0;
+    int fps = 30;
+    int seconds = 30;      // 文件源读完即结束计量，片段需足够长
+    qint64 bitRate = 0;
+    bool isValid() const { return width > 0 && height > 0; }
+
+    static SyntheticSpec forPreset(const QString &preset);
+};
+
+/**
+ * @brief SyntheticClip —— 生成确定性的 H.264 测试片段（用于基准测试）
+ *
+ * 画面由代码逐帧生成（移动的渐变与色块，每帧都有变化），编码参数与船上摄像头一致：
+ * 无 B 帧、2 秒 GOP。同一参数的片段只生成一次并缓存在目录中，
+ * 不同构建的基准结果因此基于完全相同的输入，可以直接比较。
+ */
+class SyntheticClip
+{
+public:
+    /// 返回片段路径（已存在时直接复用）；失败时返回空字符串并设置 error
+    static QString ensure(const SyntheticSpec &spec, const QString &dir, QString *error);
+};
+
+/**
+ * @brief LoopbackStreamServer —— 本机网络流替身
+ *
+ * 在 127.0.0.1 上监听 TCP 端口，按实时速率把片段流复制为 MPEG-TS 推给连接的客户端，
+ * 播完后无缝循环。解码器以 tcp:// 地址连接，走与摄像头相同的网络读包、
+ * 实时节奏与重连路径（FFmpeg 没有可供客户端拉流的 RTSP 服务端，以 TCP/MPEG-TS 代替）。
+ */
+class LoopbackStreamServer
+{
+public:
+    LoopbackStreamServer() = default;
+    ~LoopbackStreamServer();
+
+    LoopbackStreamServer(const LoopbackStreamServer &) = delete;
+    LoopbackStreamServer &operator=(const LoopbackStreamServer &) = delete;
+
+    bool start(const QString &file, int port);
+    void stop();
+    QString url() const;
+
+private:
+    void serve();
+    static int interruptCallback(void *opaque);
+
+    QString m_file;
+    int m_port = 0;
+    QThread *m_thread = nullptr;
+    std::atomic<bool> m_stopped { false };
+};
+
+#endif // SYNTHETIC_SOURCE_H
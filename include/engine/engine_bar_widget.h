@@ -1,17 +1,21 @@
 #pragma once
-#include <QWidget>
 #include <QTimer>
+#include "render/threaded_gauge_widget.h"
 
-class EngineBarWidget : public QWidget {
+class EngineBarWidget : public ThreadedGaugeWidget {
     Q_OBJECT
 public:
     explicit EngineBarWidget(QWidget* parent = nullptr);
     void setValue(double v);   // 设置目标值（外部调用）
 
 protected:
-    void paintEvent(QPaintEvent*) override;
+    SceneFn snapshotScene() const override;
 
 private:
+    // 场景绘制（只依赖参数，可在任意线程执行）
+    static void paintScene(QPainter& p, const QSize& size, double displayValue);
+
     double value_ = 0.0;        // 目标值（真实输入）
     double displayValue_ = 0.0; // 用于平滑显示的值
+    QTimer* smoothTimer_;       // 平滑定时器（到达目标后停止）
 };
@@ -1,14 +1,15 @@
 #pragma once
-#include <QWidget>
 #include <QTimer>
+#include "render/threaded_gauge_widget.h"
 
 /**
  * @brief RudderGaugeWidget —— 平滑舵角仪表
  *
  *  - 舵角指针平滑过渡显示
  *  - 类似真实船舶舵机带惯性/阻尼效果
+ *  - 支持后台光栅化（见 ThreadedGaugeWidget）
  */
-class RudderGaugeWidget : public QWidget {
+class RudderGaugeWidget : public ThreadedGaugeWidget {
     Q_OBJECT
 public:
     explicit RudderGaugeWidget(QWidget* parent = nullptr);
@@ -17,9 +18,12 @@ public:
     void setRudderAngle(double val);
 
 protected:
-    void paintEvent(QPaintEvent*) override;
+    SceneFn snapshotScene() const override;
 
 private:
+    // 场景绘制（只依赖参数，可在任意线程执行）
+    static void paintScene(QPainter& p, const QSize& size, double displayAngle);
+
     double targetAngle_ = 0.0;     // 外部传入的舵角目标值
     double displayAngle_ = 0.0;    // 平滑显示值（内部缓动）
     QTimer* smoothTimer_;          // 平滑定时器
@@ -0,0 +1,69 @@
+#pragma once
+#include <QAbstractScrollArea>
+#include <QPixmap>
+#include <QFont>
+#include <QTimer>
+
+class FleetState;
+struct BoatTelemetry;
+
+/**
+ * @brief FleetOverviewWidget —— 船队总览（N 艘船紧凑实时卡片）
+ *
+ * 每张卡片显示：船名、链路状态灯、航向指针、航速、横滚/俯仰。
+ *
+ * 性能设计：
+ *  - 虚拟化：只绘制视口内可见的卡片，滚动区域按行计算；
+ *  - 共享静态资源：卡片边框、刻度圈、标题文字预渲染为一张位图，所有卡片复用；
+ *  - 批量重绘：数据到达只在 FleetState 中打脏标记，
+ *    由帧定时器（~30 Hz）取走脏卡片并合并为一个重绘区域；
+ *  - 记录每帧绘制耗时，在窗口标题中显示，便于核对帧预算。
+ */
+class FleetOverviewWidget : public QAbstractScrollArea
+{
+    Q_OBJECT
+public:
+    explicit FleetOverviewWidget(FleetState *fleet, QWidget *parent = nullptr);
+
+    double lastPaintMs() const { return lastPaintMs_; }
+    double maxPaintMs() const { return maxPaintMs_; }
+
+signals:
+    void boatActivated(const QString &boatName);   // 双击卡片选择船只
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
+    void scrollContentsBy(int dx, int dy) override;
+    void mouseDoubleClickEvent(QMouseEvent *event) override;
+    void showEvent(QShowEvent *event) override;
+    void hideEvent(QHideEvent *event) override;
+
+private:
+    void onFrameTick();
+    void updateScrollRange();
+    int columns() const;
+    QRect tileRect(int index) const;          // 视口坐标
+    int tileAt(const QPoint &pos) const;
+    const QPixmap &tileBackground();
+    void drawTile(QPainter &p, const QRect &rc, int index);
+
+    FleetState *fleet_;
+    QTimer *frameTimer_;
+
+    QPixmap tileBg_;                 // 共享卡片底图
+    QFont nameFont_;
+    QFont valueFont_;
+
+    int knownCount_ = 0;             // 上次布局时的船只数量
+    int frameCounter_ = 0;
+
+    double lastPaintMs_ = 0.0;
+    double maxPaintMs_ = 0.0;
+    qint64 titleUpdatedMs_ = 0;
+
+    static constexpr int kTileW = 220;
+    static constexpr int kTileH = 110;
+    static constexpr int kSpacing = 8;
+    static constexpr int kFrameIntervalMs = 33;   // 批量重绘周期
+};
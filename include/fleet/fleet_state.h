@@ -0,0 +1,72 @@
+#pragma once
+#include <QObject>
+#include <QHash>
+#include <QVector>
+#include <QJsonObject>
+#include <QElapsedTimer>
+
+/**
+ * @brief BoatTelemetry —— 单船紧凑遥测状态（船队总览使用）
+ */
+struct BoatTelemetry {
+    QString name;
+    double heading  = 0.0;   // 航向（°，0~360，来自 IMU 偏航）
+    double speedKn  = 0.0;   // 航速（节）
+    double roll     = 0.0;   // 横滚（°）
+    double pitch    = 0.0;   // 俯仰（°）
+    double latitude = 0.0;
+    double longitude = 0.0;
+
+    qint64 lastUpdateMs = -1;   // 最近一次收到任意数据（单调时钟，ms）
+    double msgRate = 0.0;       // 最近 1 秒消息速率（条/秒）
+
+    // 速率统计窗口
+    qint64 rateWindowStartMs = 0;
+    int rateWindowCount = 0;
+
+    bool dirty = false;         // 自上次取走后是否有变化
+};
+
+/**
+ * @brief FleetState —— 多船共享遥测状态
+ *
+ *  - 接收 MqttClient::fleetSensorDataReceived，按船名 O(1) 更新；
+ *  - 新船自动登记并发射 boatAdded；
+ *  - 只记录“脏”船只索引，由视图按帧批量取走（takeDirty），
+ *    高频消息不会直接触发重绘。
+ */
+class FleetState : public QObject
+{
+    Q_OBJECT
+public:
+    enum class LinkHealth { Good, Stale, Lost };
+
+    explicit FleetState(QObject *parent = nullptr);
+
+    int count() const { return boats_.size(); }
+    const BoatTelemetry &boat(int index) const { return boats_.at(index); }
+    int indexOf(const QString &name) const { return index_.value(name, -1); }
+
+    /// 取走自上次调用以来有更新的船只索引
+    QVector<int> takeDirty();
+
+    /// 链路健康度：2 秒内有数据为 Good，5 秒内为 Stale，否则 Lost
+    LinkHealth linkHealth(int index) const;
+
+    /// 单调时钟（ms），与 BoatTelemetry::lastUpdateMs 同基准
+    qint64 nowMs() const { return clock_.elapsed(); }
+
+signals:
+    void boatAdded(const QString &name);
+
+public slots:
+    void onSensorData(const QString &boatName, const QString &sensorType, const QJsonObject &data);
+
+private:
+    int ensureBoat(const QString &name);
+
+    QVector<BoatTelemetry> boats_;
+    QHash<QString, int> index_;
+    QVector<int> dirty_;
+    QElapsedTimer clock_;
+};
@@ -6,6 +6,7 @@
 #include <QLabel>
 #include <QMap>
 #include "dashboard.h"
+#include "trend/trend_chart_widget.h"
 #include "wave_config_dialog.h"
 #include "backend/waveconfig.h"
 
@@ -26,6 +27,8 @@ public:
     void updatePropulsion(double bowThrust, double mainSpeed, double sternThrust);
     void updateSpeedAndRudder(double accel, double mainSpeed,
                               double rudder_port, double rudder_stbd);
+    // 状态栏常驻的控制诊断（text 为摘要，detail 为悬停提示中的完整报告）
+    void setControlDiagnostics(const QString& text, const QString& detail);
 
 signals:
     // 对外信号 —— 发给 MQTT 模块
@@ -34,6 +37,8 @@ signals:
     void sendControlStatusToMqtt(const QString& status); // 控制状态更新
     void boatChanged(const QString& boatName); // 船只切换信号，用于通知视频窗口
     void showVideoWindowRequested(); // 请求显示视频窗口信号
+    void showFleetWindowRequested(); // 请求显示船队总览窗口信号
+    void showTrackWindowRequested(); // 请求显示航迹图窗口信号
 
 public slots:
     void onBoatChanged(const QString& name);          // 当切换船只时触发
@@ -45,6 +50,12 @@ public slots:
     void onManualClicked();
     void onStopClicked();
     void onShowVideoClicked();                        // 显示视频窗口按钮槽函数
+    void onShowFleetClicked();                        // 显示船队总览按钮槽函数
+    void onShowTrendClicked();                        // 显示趋势图按钮槽函数
+    void onShowTrackClicked();                        // 显示航迹图按钮槽函数
+    // 船队
+    void addBoat(const QString& boatName);            // 船队中发现新船只时加入下拉框
+    void selectBoat(const QString& boatName);         // 从船队总览选择控制船只
 
 private:
     // 保存和恢复船只控制状态
@@ -58,11 +69,22 @@ private:
     QComboBox* boatSelector_;     // 下拉框组件
     QPushButton* waveConfigBtn_;  // 波浪配置对话框按钮
     QPushButton* videoWindowBtn_; // 视频窗口按钮
+    QPushButton* fleetWindowBtn_; // 船队总览按钮
+    QPushButton* trendWindowBtn_; // 趋势图按钮
+    QPushButton* trackWindowBtn_; // 航迹图按钮
     QPushButton* autoBtn_;        // AUTO按钮
     QPushButton* manualBtn_;      // MANUAL按钮
     QPushButton* stopBtn_;        // STOP按钮
 
     DashBoard* dashboard_;        // 仪表盘组件
+    QLabel* controlDiagLabel_;    // 状态栏：控制延迟与控制周期诊断
+
+    // 趋势图（独立窗口，隐藏时也持续记录历史）
+    TrendChartWidget* trendWindow_;
+    int trendRoll_ = -1;
+    int trendPitch_ = -1;
+    int trendSpeed_ = -1;
+    int trendWind_ = -1;
 
     QMap<QString, QString> boatControlStates_; // 存储各船只控制状态的映射表
 };
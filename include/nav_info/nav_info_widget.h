@@ -10,6 +10,7 @@
 // 前向声明 Pitch 仪表组件
 // ======================
 class PitchGaugeWidget;
+class NumericReadout;
 
 /**
  * @brief NavInfoWidget —— 航海信息显示控件
@@ -25,6 +26,7 @@ class PitchGaugeWidget;
  *   - 黑底白字风格；
  *   - 自动伸缩布局；
  *   - 经纬度根据正负显示 N/S、E/W；
+ *   - 数值使用 NumericReadout，显示内容不变时不重绘、不重新布局；
  *   - 俯仰仪表底部独立显示（内部自带标题与角度）。
  */
 class NavInfoWidget : public QWidget
@@ -43,11 +45,11 @@ public:
 
 private:
     // ==== UI元素声明 ====
-    QLabel *altLabel; QLabel *altValue;   // 高度
-    QLabel *lonLabel; QLabel *lonValue;   // 经度
-    QLabel *latLabel; QLabel *latValue;   // 纬度
-    QLabel *cogLabel; QLabel *cogValue;   // 航向
-    QLabel *sogLabel; QLabel *sogValue;   // 航速
+    QLabel *altLabel; NumericReadout *altValue;   // 高度
+    QLabel *lonLabel; NumericReadout *lonValue;   // 经度
+    QLabel *latLabel; NumericReadout *latValue;   // 纬度
+    QLabel *cogLabel; NumericReadout *cogValue;   // 航向
+    QLabel *sogLabel; NumericReadout *sogValue;   // 航速
 
     PitchGaugeWidget *pitchGauge;         // 保留俯仰仪表
 
@@ -1,7 +1,7 @@
 #pragma once
 
-#include <QWidget>
 #include <QPropertyAnimation>
+#include "render/threaded_gauge_widget.h"
 
 /**
  * @brief PitchGaugeWidget —— 俯仰角仪表控件
@@ -14,9 +14,10 @@
  *  - 白色三角形指针随 pitch_ 动态转动；
  *  - 平滑动画显示，使用 QPropertyAnimation 实现；
  *  - 可自适应大小缩放；
- *  - 自动抗锯齿绘制。
+ *  - 自动抗锯齿绘制；
+ *  - 支持后台光栅化（见 ThreadedGaugeWidget）。
  */
-class PitchGaugeWidget : public QWidget {
+class PitchGaugeWidget : public ThreadedGaugeWidget {
     Q_OBJECT
     // 定义可动画属性 pitchValue，对应 getPitchValue/setPitchValue
     Q_PROPERTY(double pitchValue READ getPitchValue WRITE setPitchValue)
@@ -38,9 +39,12 @@ public:
     void setPitchValue(double val);
 
 protected:
-    void paintEvent(QPaintEvent*) override;
+    SceneFn snapshotScene() const override;
 
 private:
+    // 场景绘制（只依赖参数，可在任意线程执行）
+    static void paintScene(QPainter& p, const QSize& size, double pitch);
+
     double pitch_ = 0.0;                 ///< 当前俯仰角值（单位°）
     QPropertyAnimation* anim_ = nullptr; ///< 动画控制器
 
@@ -1,9 +1,9 @@
 #pragma once
-#include <QWidget>
+#include "render/threaded_gauge_widget.h"
 
 class QPainter;
 
-class SpeedLogWidget : public QWidget
+class SpeedLogWidget : public ThreadedGaugeWidget
 {
     Q_OBJECT
 public:
@@ -28,20 +28,27 @@ public:
     void setRudders(double rudder_port, double rudder_stbd);
 
 protected:
-    void paintEvent(QPaintEvent*) override;
+    SceneFn snapshotScene() const override;
 
 private:
-    // 数值模型
-    double accel_        = 0.0;  // 上/下两行显示的同一个加速度
-    double speed_        = 0.0;  // 中间显示的当前船速
-    double rudder_port_  = 0.0;  // 左舵角
-    double rudder_stbd_  = 0.0;  // 右舵角
+    // 数值模型（同时作为后台绘制的不可变快照）
+    struct Snapshot {
+        double accel        = 0.0;  // 上/下两行显示的同一个加速度
+        double speed        = 0.0;  // 中间显示的当前船速
+        double rudder_port  = 0.0;  // 左舵角
+        double rudder_stbd  = 0.0;  // 右舵角
+    };
+    Snapshot data_;
+
+    // 场景绘制（只依赖参数，可在任意线程执行）
+    static void paintScene(QPainter& p, const QSize& size, const Snapshot& s);
 
     // 封装的三角绘制逻辑（白色常显 + 条件绿色高亮）
-    void drawIndicatorTriangles(QPainter& p,
-                                int cx,          // 中线 x（船体中心）
-                                int yTopText,    // 上行数值的基线 y
-                                int yMidText,    // 中间数值的基线 y
-                                int yBotText,    // 下行数值的基线 y
-                                int bodyWidth);  // 船体宽，用于算外侧三角的 x
+    static void drawIndicatorTriangles(QPainter& p,
+                                       const Snapshot& s,
+                                       int cx,          // 中线 x（船体中心）
+                                       int yTopText,    // 上行数值的基线 y
+                                       int yMidText,    // 中间数值的基线 y
+                                       int yBotText,    // 下行数值的基线 y
+                                       int bodyWidth);  // 船体宽，用于算外侧三角的 x
 };
@@ -1,11 +1,11 @@
 #pragma once
-#include <QWidget>
+#include "render/threaded_gauge_widget.h"
 
 /**
  * @brief ThrusterGaugeWidget —— 推力刻度仪
  * 水平显示从 -10 ~ 10 的推力值刻度。
  */
-class ThrusterGaugeWidget : public QWidget {
+class ThrusterGaugeWidget : public ThreadedGaugeWidget {
     Q_OBJECT
 public:
     explicit ThrusterGaugeWidget(QWidget* parent = nullptr);
@@ -15,9 +15,12 @@ public:
     void setLabel(const QString& text);
 
 protected:
-    void paintEvent(QPaintEvent*) override;
+    SceneFn snapshotScene() const override;
 
 private:
+    // 场景绘制（只依赖参数，可在任意线程执行）
+    static void paintScene(QPainter& p, const QSize& size, const QString& title);
+
     double thrust_ = 0.0;  ///< 当前推力值（-10~10）
     QString label_ = "BOW";  // 默认显示 BOW
 };
@@ -0,0 +1,63 @@
+#pragma once
+#include <QWidget>
+#include <QStaticText>
+#include <QFont>
+#include <QColor>
+
+/**
+ * @brief NumericReadout —— 轻量数值显示控件（替代频繁 setText 的 QLabel）
+ *
+ * 特点：
+ *  - setValue() 先按显示精度取整比较，显示内容不变时直接返回（不格式化、不重绘）；
+ *  - 文本用 QStaticText 预先排版，重绘时只贴已成形的字形；
+ *  - sizeHint 由“宽度模板”一次性确定，数值变化不触发布局失效；
+ *  - 不透明绘制，只重绘自身区域。
+ */
+class NumericReadout : public QWidget {
+    Q_OBJECT
+public:
+    explicit NumericReadout(const QString& placeholder, QWidget* parent = nullptr);
+
+    void setTextFont(const QFont& font);
+    void setTextColor(const QColor& color);
+    void setBackgroundColor(const QColor& color);
+    void setAlignment(Qt::Alignment align);
+
+    /// 设置宽度模板（如 "000.0°N"），决定控件的固定 sizeHint
+    void setWidthTemplate(const QString& sample);
+
+    /**
+     * @brief 设置数值
+     * @param value     原始数值
+     * @param decimals  小数位数
+     * @param suffix    单位/方向后缀（建议传入常量字符串，避免每次构造）
+     */
+    void setValue(double value, int decimals, const QString& suffix);
+
+    /// 直接设置文本（内容相同时忽略）
+    void setText(const QString& text);
+
+    QSize sizeHint() const override;
+    QSize minimumSizeHint() const override;
+
+protected:
+    void paintEvent(QPaintEvent*) override;
+
+private:
+    void applyText(const QString& text);
+    void updateHint();
+
+    QStaticText staticText_;
+    QFont font_;
+    QColor textColor_{Qt::white};
+    QColor background_{Qt::black};
+    Qt::Alignment align_ = Qt::AlignLeft | Qt::AlignVCenter;
+    QString widthTemplate_;
+    QSize hint_;
+
+    // 变化抑制：上一次显示内容的取整键值
+    bool hasValue_ = false;
+    qint64 lastKey_ = 0;
+    int lastDecimals_ = -1;
+    QString lastSuffix_;
+};
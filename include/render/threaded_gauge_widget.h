@@ -0,0 +1,54 @@
+#pragma once
+#include <QWidget>
+#include <QImage>
+#include <QFutureWatcher>
+#include <functional>
+
+class QPainter;
+class QThreadPool;
+
+/**
+ * @brief ThreadedGaugeWidget —— 支持后台光栅化的仪表基类
+ *
+ * 子类把绘制逻辑写成“场景函数”：snapshotScene() 在 GUI 线程按值捕获当前数据，
+ * 返回的函数只依赖这份不可变快照，因此可以在任意线程执行。
+ *
+ *  - 默认模式：paintEvent 中直接在控件上执行场景函数（与原先行为一致）；
+ *  - 后台模式：场景函数提交到专用线程池，在 QImage 上光栅化，
+ *    GUI 线程只把最近一次完成的图像贴到屏幕上（双缓冲交接）。
+ *    前台 / 后台两块缓冲轮换使用，尺寸不变时不再分配新图像。
+ *
+ * 子类用 requestRepaint() 代替 update()。
+ */
+class ThreadedGaugeWidget : public QWidget {
+    Q_OBJECT
+public:
+    using SceneFn = std::function<void(QPainter&, const QSize&)>;
+
+    explicit ThreadedGaugeWidget(QWidget* parent = nullptr);
+    ~ThreadedGaugeWidget() override = default;
+
+    /// 全局开关：是否启用后台光栅化（默认关闭）
+    static void setThreadedRendering(bool enabled);
+    static bool threadedRendering();
+
+protected:
+    /// 捕获当前数据快照，返回可在任意线程执行的绘制函数
+    virtual SceneFn snapshotScene() const = 0;
+
+    /// 请求重绘：同步模式下等价于 update()，后台模式下提交光栅化任务
+    void requestRepaint();
+
+    void paintEvent(QPaintEvent*) override;
+    void resizeEvent(QResizeEvent*) override;
+
+private:
+    void submitRender();
+    void onRenderFinished();
+    static QThreadPool* renderPool();
+
+    QImage front_;                              ///< 最近完成的帧（GUI 线程只读）
+    QImage back_;                               ///< 空闲的后台缓冲，下一帧在其上光栅化
+    QFutureWatcher<QImage>* watcher_ = nullptr; ///< 正在进行的后台帧
+    bool pending_ = false;                      ///< 渲染期间又有新请求，完成后补一帧
+};
@@ -0,0 +1,55 @@
+#pragma once
+#include <QWidget>
+#include <QTimer>
+#include <QPolygonF>
+#include "track/track_store.h"
+
+/**
+ * @brief TrackPlotWidget —— 多船 GPS 航迹图
+ *
+ *  - 视口查询经 TrackStore 网格索引裁剪，只绘制可见分块；
+ *  - 按当前比例选择简化级别（误差不超过半个像素）；
+ *  - 新定位只打脏标记，由定时器以 10 Hz 合并重绘；窗口隐藏时定时器停止（航迹照常记录）。
+ *
+ * 交互：滚轮以光标为中心缩放，左键拖动平移，双击恢复自动适配全部航迹。
+ */
+class TrackPlotWidget : public QWidget
+{
+    Q_OBJECT
+public:
+    explicit TrackPlotWidget(TrackStore *store, QWidget *parent = nullptr);
+
+    QSize sizeHint() const override { return QSize(800, 600); }
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void wheelEvent(QWheelEvent *event) override;
+    void mousePressEvent(QMouseEvent *event) override;
+    void mouseMoveEvent(QMouseEvent *event) override;
+    void mouseReleaseEvent(QMouseEvent *event) override;
+    void mouseDoubleClickEvent(QMouseEvent *event) override;
+    void showEvent(QShowEvent *event) override;
+    void hideEvent(QHideEvent *event) override;
+
+private:
+    void fitToTracks();
+    QPointF toScreen(const QPointF &world) const;
+    QPointF toWorld(const QPointF &screen) const;
+    void drawScaleBar(QPainter &p);
+
+    TrackStore *store_;
+    QTimer *refreshTimer_;
+    bool dirty_ = false;
+
+    QPointF center_;                 // 视口中心（本地平面坐标，米）
+    double metersPerPixel_ = 1.0;
+    bool autoFit_ = true;            // 未手动操作前自动适配全部航迹
+
+    bool dragging_ = false;
+    QPointF dragLast_;
+
+    QVector<TrackStore::ChunkRef> visible_;   // 复用的查询缓冲区
+    QPolygonF polyBuf_;                       // 复用的折线缓冲区
+
+    static constexpr int kRefreshIntervalMs = 100;
+};
@@ -0,0 +1,97 @@
+#pragma once
+#include <QObject>
+#include <QHash>
+#include <QVector>
+#include <QPointF>
+#include <QRectF>
+#include <QJsonObject>
+#include <QElapsedTimer>
+
+/**
+ * @brief TrackChunk —— 一段连续的航迹点（定长分块）
+ *
+ * 分块写满后“封存”：计算包围盒并按各级容差做一次 Douglas–Peucker 简化，
+ * 之后不再修改。相邻分块共享端点，折线在分块之间保持连续。
+ */
+struct TrackChunk {
+    QVector<QPointF> raw;                 // 原始点（本地平面坐标，米）
+    QVector<QVector<QPointF>> levels;     // 各级简化结果，与 TrackStore::tolerances() 对应（第 0 级即 raw，不重复存储）
+    QRectF bounds;
+    bool sealed = false;
+};
+
+/**
+ * @brief BoatTrack —— 单船航迹
+ */
+struct BoatTrack {
+    QString name;
+    QVector<TrackChunk> chunks;
+    QPointF lastPos;
+    qint64 lastFixMs = 0;       // 最近一次接受定位的时刻（TrackStore 内部单调时钟）
+    qint64 fixCount = 0;
+    qint64 rejectedFixes = 0;   // 隐含速度不可能而丢弃的定位
+};
+
+/**
+ * @brief TrackStore —— 多船 GPS 航迹存储
+ *
+ *  - 经纬度以首个定位点为原点投影到本地平面（等距圆柱，米）；
+ *  - 航迹按定长分块，封存时做多级 Douglas–Peucker 简化（增量：只处理新封存的分块）；
+ *  - 封存分块登记到均匀网格索引，视口查询只访问相交网格内的分块；
+ *    包围盒覆盖网格过多的分块不登记到网格，单独列出，每次查询都检查；
+ *  - 相对上一点隐含速度不可能的定位（GPS 跳点）直接丢弃。
+ */
+class TrackStore : public QObject
+{
+    Q_OBJECT
+public:
+    /// 可见分块引用：第几艘船的第几个分块
+    struct ChunkRef {
+        int boat;
+        int chunk;
+    };
+
+    explicit TrackStore(QObject *parent = nullptr);
+
+    int boatCount() const { return tracks_.size(); }
+    const BoatTrack &track(int index) const { return tracks_.at(index); }
+
+    /// 简化容差（米），第 0 级为原始数据
+    static const QVector<double> &tolerances();
+    /// 选择不超过给定误差的最粗一级
+    static int levelFor(double maxErrorMeters);
+
+    /// 查询与视口相交的分块（含未封存的尾块）
+    void query(const QRectF &view, QVector<ChunkRef> &out) const;
+
+    QRectF bounds() const { return bounds_; }
+    qint64 totalFixes() const { return totalFixes_; }
+
+    void appendFix(const QString &boatName, double latitude, double longitude);
+
+signals:
+    void trackUpdated();
+
+public slots:
+    void onSensorData(const QString &boatName, const QString &sensorType, const QJsonObject &data);
+
+private:
+    QPointF project(double latitude, double longitude) const;
+    void seal(int boat, int chunk);
+    static quint64 cellKey(int cx, int cy);
+
+    QVector<BoatTrack> tracks_;
+    QHash<QString, int> index_;
+    QHash<quint64, QVector<ChunkRef>> grid_;   // 网格 → 封存分块
+    QVector<ChunkRef> oversized_;              // 覆盖网格过多、未登记到网格的封存分块
+    QElapsedTimer clock_;
+    int sealedCount_ = 0;
+
+    bool hasOrigin_ = false;
+    double lat0_ = 0.0;
+    double lon0_ = 0.0;
+    double cosLat0_ = 1.0;
+
+    QRectF bounds_;
+    qint64 totalFixes_ = 0;
+};
@@ -0,0 +1,73 @@
+#pragma once
+#include <QtGlobal>
+#include <QVector>
+#include <deque>
+
+/**
+ * @brief TrendBucket —— 一段时间内样本的聚合（最小/最大/首/末值）
+ */
+struct TrendBucket {
+    double t0 = 0.0;        // 首样本时间（ms）
+    double t1 = 0.0;        // 末样本时间（ms）
+    float vmin = 0.0f;
+    float vmax = 0.0f;
+    float first = 0.0f;
+    float last = 0.0f;
+};
+
+/**
+ * @brief TrendColumn —— 单个像素列的聚合结果
+ */
+struct TrendColumn {
+    float vmin = 0.0f;
+    float vmax = 0.0f;
+    float first = 0.0f;
+    float last = 0.0f;
+    bool valid = false;
+};
+
+/**
+ * @brief MinMaxPyramid —— 增量构建的最小/最大值金字塔
+ *
+ * 第 0 层保存原始样本，第 k 层每个桶合并第 k-1 层的两个桶，
+ * 样本到达时逐层向上传递，摊还 O(1)。
+ *
+ * 查询时选择“桶数量不超过若干倍像素列数”的最细一层，
+ * 再按像素列聚合 —— 绘制成本只与像素宽度相关，与样本总数无关。
+ *
+ * 每层容量有限：细层只保留最近的数据，更早的历史只在粗层中保留，
+ * 内存有上界，同时仍可浏览数小时的历史。
+ */
+class MinMaxPyramid
+{
+public:
+    explicit MinMaxPyramid(int levelCapacity = 1 << 15, int levels = 16);
+
+    void append(double tMs, double value);
+    void clear();
+
+    bool isEmpty() const { return levels_.front().empty(); }
+    double firstTime() const;
+    double lastTime() const { return isEmpty() ? 0.0 : levels_.front().back().t1; }
+    double lastValue() const { return isEmpty() ? 0.0 : levels_.front().back().last; }
+
+    /**
+     * @brief 按像素列聚合
+     * @param t0        第 0 列起始时间（ms）
+     * @param msPerCol  每列时间宽度（ms）
+     * @param columns   列数
+     * @param out       输出，大小被设置为 columns
+     */
+    void decimate(double t0, double msPerCol, int columns, QVector<TrendColumn> &out) const;
+
+private:
+    void push(int level, const TrendBucket &b);
+    static void merge(TrendBucket &into, const TrendBucket &b);
+    static void accumulate(TrendColumn &c, const TrendBucket &b);
+
+    using Level = std::deque<TrendBucket>;
+    QVector<Level> levels_;
+    QVector<TrendBucket> pending_;      // 第 k 层尚未凑满两个的半成品桶
+    QVector<bool> hasPending_;
+    int capacity_;
+};
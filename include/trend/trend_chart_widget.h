@@ -0,0 +1,87 @@
+#pragma once
+#include <QWidget>
+#include <QElapsedTimer>
+#include <QTimer>
+#include <QColor>
+#include <QVector>
+#include "trend/minmax_pyramid.h"
+
+/**
+ * @brief TrendChartWidget —— 多通道遥测趋势图（走纸记录仪）
+ *
+ * 每个通道一条横向泳道，最新数据在右侧。
+ *  - 数据存入 MinMaxPyramid，按像素列做最小/最大值抽取，
+ *    绘制成本与像素宽度成正比，可显示数小时历史；
+ *  - 像素列边界对齐到时间网格，滚动时只做亚像素平移，
+ *    避免抽取结果随帧抖动；
+ *  - 跟随实时数据时由 ~60 Hz 定时器驱动平滑滚动，关闭抗锯齿以适配软件光栅化。
+ *
+ * 交互：滚轮缩放时间窗口，左键拖动回看历史，双击回到实时跟随。
+ */
+class TrendChartWidget : public QWidget
+{
+    Q_OBJECT
+public:
+    explicit TrendChartWidget(QWidget *parent = nullptr);
+
+    /// 添加通道，返回通道编号；未设定量程时自动缩放
+    int addChannel(const QString &name, const QString &unit, const QColor &color);
+    void setChannelRange(int channel, double minValue, double maxValue);
+
+    /// 追加样本，时间戳取内部单调时钟
+    void addSample(int channel, double value);
+
+    void setTimeSpan(double spanMs);
+    double timeSpan() const { return spanMs_; }
+
+    QSize sizeHint() const override { return QSize(900, 520); }
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void wheelEvent(QWheelEvent *event) override;
+    void mousePressEvent(QMouseEvent *event) override;
+    void mouseMoveEvent(QMouseEvent *event) override;
+    void mouseReleaseEvent(QMouseEvent *event) override;
+    void mouseDoubleClickEvent(QMouseEvent *event) override;
+    void showEvent(QShowEvent *event) override;
+    void hideEvent(QHideEvent *event) override;
+
+private:
+    struct Channel {
+        QString name;
+        QString unit;
+        QColor color;
+        bool autoScale = true;
+        double minValue = 0.0;
+        double maxValue = 1.0;
+        MinMaxPyramid data;
+        QVector<TrendColumn> columns;   // 复用的抽取缓冲区
+    };
+
+    void setFollowing(bool follow);
+    double viewEnd() const;
+    QRect plotRect() const;
+    void drawTimeGrid(QPainter &p, const QRect &plot, double tStart, double msPerCol, double shift);
+    void drawLane(QPainter &p, Channel &ch, const QRect &lane,
+                  double tStart, double msPerCol, int cols, double shift);
+
+    QVector<Channel> channels_;
+    QElapsedTimer clock_;
+    QTimer *scrollTimer_;
+
+    double spanMs_ = 60000.0;       // 可见时间窗口
+    bool following_ = true;         // 是否跟随实时数据
+    double frozenEnd_ = 0.0;        // 回看模式下的右边界时间
+    int dragStartX_ = 0;
+    double dragStartEnd_ = 0.0;
+    bool dragging_ = false;
+
+    QVector<QLineF> lineBuf_;       // 复用的线段缓冲区
+
+    static constexpr int kLeftMargin = 110;
+    static constexpr int kRightMargin = 10;
+    static constexpr int kTopMargin = 8;
+    static constexpr int kBottomMargin = 22;
+    static constexpr int kLaneGap = 6;
+    static constexpr int kScrollIntervalMs = 16;
+};
@@ -0,0 +1,80 @@
+#ifndef VIDEO_HUD_H
+#define VIDEO_HUD_H
+
+#include <QPixmap>
+#include <QStaticText>
+#include <QFont>
+#include <QRect>
+#include <climits>
+
+class QPainter;
+
+/**
+ * @brief HudTelemetry —— 叠加到视频上的遥测快照（来自 SensorDataBridge）
+ */
+struct HudTelemetry {
+    double roll = 0.0;          // 横滚（度，右舷下沉为正）
+    double pitch = 0.0;         // 俯仰（度，船首抬起为正）
+    double heading = 0.0;       // 航向（度，0~360）
+    double speedKnots = 0.0;    // 航速（节）
+    qint64 timestampMs = 0;     // 数据时间（Unix 毫秒），0 表示尚无数据
+};
+
+/**
+ * @brief VideoHud —— 视频画面上的平视显示（地平线、俯仰梯、横滚刻度、航向带、航速）
+ *
+ * 不是控件，由 VideoSurfaceWidget 在贴完视频帧后调用 paint() 叠加。
+ * 为了不拖慢视频帧率，绘制分两部分：
+ *  - 静态部分（准星、横滚刻度弧、航向带外框、航速框）以及可平移的刻度
+ *    （俯仰梯、0~360° 航向刻度带）只在画面尺寸或 DPR 变化时光栅化成 QPixmap；
+ *  - 每帧只做贴图（航向带按航向截取、俯仰梯按姿态平移/旋转）、
+ *    一条地平线、一个横滚指针和几段预排版的数值文字（QStaticText，数值变化才重排）。
+ */
+class VideoHud
+{
+public:
+    /// 更新遥测数据；显示内容（按显示精度取整后）有变化时返回 true
+    bool setTelemetry(const HudTelemetry &telemetry);
+
+    /// 在 area（视频画面矩形，逻辑坐标）上叠加 HUD
+    void paint(QPainter &p, const QRect &area, qreal dpr, qint64 nowMs);
+
+    static constexpr qint64 kStaleMs = 5000;     // 超过此时长无新数据视为遥测中断
+
+private:
+    void rebuild(const QSize &size, qreal dpr);
+    void drawReadout(QPainter &p, const QPointF &center, const QStaticText &text) const;
+    void updateTexts();
+
+    HudTelemetry m_data;
+
+    // ---- 按尺寸缓存的图层 ----
+    QSize m_cacheSize;
+    qreal m_cacheDpr = 0.0;
+    QPixmap m_static;           // 准星、横滚刻度弧、航向带外框、各读数框
+    QPixmap m_ladder;           // 俯仰梯（±kLadderRange°，不含 0° 线）
+    QPixmap m_tape;             // 航向刻度带：覆盖 -kTapeHalfSpan ~ 360+kTapeHalfSpan 度
+    qreal m_ladderPxPerDeg = 0.0;
+    qreal m_tapePxPerDeg = 0.0;
+    qreal m_rollRadius = 0.0;
+    QRectF m_tapeRect;          // 航向带在画面内的位置（相对 area 左上角）
+    QPointF m_headingBox;       // 各读数框中心（相对 area 左上角）
+    QPointF m_speedBox;
+    QPointF m_rollBox;
+    QFont m_font;
+
+    // ---- 预排版的数值文字 ----
+    QStaticText m_headingText;
+    QStaticText m_speedText;
+    QStaticText m_rollText;
+    int m_headingKey = -1;      // 取整后的显示值，-1/INT_MIN 表示需要重排
+    int m_speedKey = -1;
+    int m_rollKey = INT_MIN;
+
+    static constexpr double kLadderRange = 30.0;     // 俯仰梯覆盖 ±30°
+    static constexpr double kLadderVisible = 25.0;   // 画面高度对应 ±25°
+    static constexpr double kTapeHalfSpan = 30.0;    // 航向带可见 ±30°
+    static constexpr double kRollLimit = 45.0;       // 横滚指针最大偏转
+};
+
+#endif // VIDEO_HUD_H
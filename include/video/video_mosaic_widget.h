@@ -0,0 +1,55 @@
+#ifndef VIDEO_MOSAIC_WIDGET_H
+#define VIDEO_MOSAIC_WIDGET_H
+
+#include <QWidget>
+#include <QVector>
+#include <QHash>
+#include "backend/streammanager.h"
+#include "video/video_surface_widget.h"
+
+/**
+ * @brief VideoMosaicWidget —— 多摄像头宫格视图
+ *
+ * 每路预置流一个图块，各自直接从对应解码器的帧信箱取帧。
+ * 解码成本随图块像素自适应：
+ *  - 每路输出尺寸即图块尺寸（缩放在解码器转换线程中完成）；
+ *  - 图块远小于源分辨率时降低解码质量（关闭环路滤波、丢弃非参考帧）；
+ *  - 单击图块放大，被放大的图块恢复完整质量，再次单击恢复均分。
+ */
+class VideoMosaicWidget : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit VideoMosaicWidget(StreamManager *streams, QWidget *parent = nullptr);
+
+    /// 进入 / 退出宫格模式（图块按当前预置流重建）
+    void setMosaicActive(bool active);
+
+    /// 预置流的显示名称（未设置时显示 URL）
+    void setStreamName(const QString &url, const QString &name);
+
+protected:
+    void resizeEvent(QResizeEvent *event) override;
+    bool eventFilter(QObject *watched, QEvent *event) override;
+
+private:
+    struct Tile {
+        QString url;
+        FFmpegDecoder *decoder = nullptr;
+        VideoSurfaceWidget *surface = nullptr;
+        QMetaObject::Connection frameConn;
+    };
+
+    void buildTiles();
+    void clearTiles();
+    void layoutTiles();
+    void updateTileQuality(Tile &tile, const QSize &devicePixelSize);
+
+    StreamManager *m_streams;
+    QVector<Tile> m_tiles;
+    QHash<QString, QString> m_names;
+    int m_focused = -1;     // 放大的图块，-1 表示均分
+};
+
+#endif // VIDEO_MOSAIC_WIDGET_H
@@ -8,7 +8,14 @@
 #include <QComboBox>
 #include <QHBoxLayout>
 #include <QVBoxLayout>
-#include "backend/ffmpegdecoder.h"
+#include <QTimer>
+#include <QPointer>
+#include <QSlider>
+#include <QElapsedTimer>
+#include "backend/streammanager.h"
+#include "backend/replayengine.h"
+#include "video/video_surface_widget.h"
+#include "video/video_mosaic_widget.h"
 
 class VideoPlayerWidget : public QWidget
 {
@@ -21,35 +28,68 @@ public:
     // 根据当前选择的船只自动切换摄像头
     void setCurrentBoat(const QString &boatName);
 
+    // 最新的遥测快照，HUD 打开时叠加到画面上
+    void setHudTelemetry(const HudTelemetry &telemetry);
+
 private slots:
     void onPlayClicked();
     void onStopClicked();
     void onCameraPresetChanged(int index);
-    void onFrameReady(const QImage &frame);
+    void onRecordToggled(bool checked);
+    void onOverlayToggled(bool checked);
+    void onOverlayTimer();
+    void onReplayToggled(bool checked);
+    void onReplaySliderMoved(int offsetMs);
+    void onReplayFrame(const QImage &frame, qint64 wallMs);
+    void onMosaicToggled(bool checked);
+    void onFrameAvailable();
+    void onStatsTimer();
     void onStateChanged(int state);
     void onErrorOccurred(const QString &errorMessage);
 
 private:
     void setupUI();
     void setupConnections();
-    void resizeEvent(QResizeEvent *event) override;
     void playSelectedCamera(); // 播放选中的摄像头
 
-    FFmpegDecoder *m_decoder;
-    QLabel *m_videoLabel;
+    StreamManager *m_streams;   // 各船摄像头流（热备）
+    VideoSurfaceWidget *m_videoSurface;
+    VideoMosaicWidget *m_mosaic;       // 多路宫格视图
     QLabel *m_statusLabel;
     QPushButton *m_playButton;
     QPushButton *m_stopButton;
+    QPushButton *m_recordButton;
+    QPushButton *m_overlayButton;
+    QPushButton *m_hudButton;
+    QPushButton *m_replayButton;
+    QPushButton *m_mosaicButton;
     QLineEdit *m_urlEdit;
     QComboBox *m_cameraPresets;
 
     QVBoxLayout *m_mainLayout;
     QHBoxLayout *m_controlLayout;
 
-    QSize m_lastFrameSize;
-    QPixmap m_cachedPixmap;
-
     QString m_currentCameraUrl; // 记录当前播放的摄像头URL
+    QPointer<FFmpegDecoder> m_recordingDecoder;    // 正在录像的流（由 StreamManager 持有，临时流关闭后自动置空）
+
+    // 帧率统计（每秒刷新状态栏）
+    QTimer *m_statsTimer;
+    VideoFrameStats m_lastStats;
+    QString m_stateText;
+
+    // 即时回放（拖动条偏移相对于进入回放时的最新包）
+    ReplayEngine *m_replay;
+    QWidget *m_replayBar;
+    QSlider *m_replaySlider;
+    QLabel *m_replayLabel;
+    qint64 m_replayEdgeMs = 0;
+    bool m_replayMode = false;
+
+    // 统计浮层（4 Hz 刷新）
+    QTimer *m_overlayTimer;
+    QElapsedTimer m_overlayClock;
+    FFmpegDecoder *m_overlayDecoder = nullptr;     // 只用于检测流切换，不解引用
+    VideoFrameStats m_overlayFrames;
 };
 
 #endif // VIDEO_PLAYER_WIDGET_H
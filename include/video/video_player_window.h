@@ -15,6 +15,9 @@ public:
     // 根据当前选择的船只自动切换摄像头
     void setCurrentBoat(const QString &boatName);
 
+    // 转发遥测快照给视频画面的 HUD
+    void setHudTelemetry(const HudTelemetry &telemetry);
+
 protected:
     void closeEvent(QCloseEvent *event) override;
 
@@ -0,0 +1,60 @@
+#ifndef VIDEO_SURFACE_WIDGET_H
+#define VIDEO_SURFACE_WIDGET_H
+
+#include <QWidget>
+#include <QImage>
+#include <QElapsedTimer>
+#include "video/video_hud.h"
+
+/**
+ * @brief VideoSurfaceWidget —— 视频显示表面
+ *
+ * 直接持有解码器给出的 QImage（池化缓冲区，不拷贝），
+ * 在 paintEvent 中按保持宽高比的矩形绘制，不经过 QPixmap 转换。
+ * 下一帧到达时旧帧被替换，其缓冲区随之归还帧池。
+ *
+ * 尺寸变化时发出 displaySizeChanged（设备像素），解码器据此直接输出显示尺寸的帧，
+ * 此时绘制是 1:1 贴图，不再缩放。
+ * 首次绘制时检测窗口后备缓冲的像素格式并发出 backingFormatChanged，解码器据此选择输出格式，
+ * 帧以 Source 合成模式绘制，格式一致时是逐行拷贝，不做格式转换也不做透明混合。
+ *
+ * 可选叠加遥测 HUD（VideoHud）：随视频帧一起重绘，遥测更新本身不额外触发重绘，
+ * 只有画面停滞（暂停、断流）时才单独刷新。
+ */
+class VideoSurfaceWidget : public QWidget
+{
+    Q_OBJECT
+
+public:
+    explicit VideoSurfaceWidget(QWidget *parent = nullptr);
+
+    void setFrame(const QImage &frame);
+    void clear(const QString &placeholder);
+    void setCaption(const QString &caption);     // 画面左上角标题（宫格图块用）
+    void setOverlayLines(const QStringList &lines); // 右上角统计浮层，空列表时隐藏
+    void setHudEnabled(bool enabled);
+    void setHudTelemetry(const HudTelemetry &telemetry);
+
+    /// 当前帧在控件中的显示矩形（保持宽高比、居中）
+    QRect frameRect() const;
+
+signals:
+    void displaySizeChanged(const QSize &devicePixelSize);
+    void backingFormatChanged(QImage::Format format);
+
+protected:
+    void paintEvent(QPaintEvent *event) override;
+    void resizeEvent(QResizeEvent *event) override;
+
+private:
+    QImage m_frame;
+    QImage::Format m_backingFormat = QImage::Format_Invalid;
+    QString m_placeholder;
+    QString m_caption;
+    QStringList m_overlay;
+    VideoHud m_hud;
+    bool m_hudEnabled = false;
+    QElapsedTimer m_sinceFrame;     // 距上一帧到达的时间，判断视频是否仍在驱动重绘
+};
+
+#endif // VIDEO_SURFACE_WIDGET_H
@@ -1,6 +1,6 @@
 #pragma once
-#include <QWidget>
 #include <QPropertyAnimation>
+#include "render/threaded_gauge_widget.h"
 
 /**
  * @brief RollGaugeWidget —— 横滚角指示器
@@ -11,8 +11,9 @@
  *  - 绿色倒三角指针表示当前横滚角；
  *  - 动画平滑滑动；
  *  - 右上角显示实时横滚角值；
+ *  - 支持后台光栅化（见 ThreadedGaugeWidget）。
  */
-class RollGaugeWidget : public QWidget {
+class RollGaugeWidget : public ThreadedGaugeWidget {
     Q_OBJECT
     // 定义可动画属性 rollValue
     Q_PROPERTY(double rollValue READ getRollValue WRITE setRollValue)
@@ -31,7 +32,7 @@ public:
     void setRollValue(double val); // 动画中每帧调用
 
 protected:
-    void paintEvent(QPaintEvent*) override;
+    SceneFn snapshotScene() const override;
     QSize sizeHint() const override;
     QSize minimumSizeHint() const override;
 
@@ -39,6 +40,9 @@ private:
     double roll_deg_{0.0};              ///< 当前横滚角
     QPropertyAnimation* anim_{nullptr}; ///< 动画控制器
 
+    // 场景绘制（只依赖参数，可在任意线程执行）
+    static void paintScene(QPainter& p, const QSize& size, double rollDeg);
+
     // 辅助函数：根据圆心坐标与角度计算圆周点
     static QPointF pointOnCirclePhi(const QPointF& c, double r, double phi_deg);
     // 将 roll 值(-25°~+25°)映射到弧线角(200°~340°)
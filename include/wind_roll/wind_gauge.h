@@ -8,6 +8,8 @@
 #include "wind_rose_widget.h"
 #include "roll_gauge_widget.h"
 
+class NumericReadout;
+
 /**
  * @brief WindGauge —— 综合风向、风速、横滚角仪表
  *
@@ -40,8 +42,8 @@ private:
     QLabel *dirLabel;            // “WDIR” 标签
     QLabel *spdLabel;            // “WSPD” 标签
 
-    QLabel *dirValueLabel;       // 风向数值（°）
-    QLabel *spdValueLabel;       // 风速数值（m/s）
+    NumericReadout *dirValueLabel;  // 风向数值（°）
+    NumericReadout *spdValueLabel;  // 风速数值（m/s）
 
     WindRoseWidget *windRose;    // 风向图
     RollGaugeWidget *rollGauge;  // 横滚角仪表（半圆）
@@ -53,7 +55,7 @@ private:
 
     // ===== 辅助函数 =====
     void setupLayout();          // 初始化布局
-    void updateLabels();         // 刷新显示数值
+    void updateLabels();         // 刷新显示数值（未变化时由 NumericReadout 跳过）
 };
 
 #endif // WIND_GAUGE_H
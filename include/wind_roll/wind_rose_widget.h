@@ -1,20 +1,20 @@
 #pragma once
-#include <QWidget>
+#include "render/threaded_gauge_widget.h"
 
 /**
- * WindRoseWidget —— 风向盘控件
+ * WindRoseWidget —— 风向盘控件（支持后台光栅化）
  */
-class WindRoseWidget : public QWidget {
+class WindRoseWidget : public ThreadedGaugeWidget {
     Q_OBJECT
 public:
     explicit WindRoseWidget(QWidget* parent = nullptr);
     ~WindRoseWidget() override = default;
 
-    void setTrueDirectionDeg(double deg)      { true_dir_deg_ = deg; update(); }
-    void setTrueSpeed(double kn)              { true_spd_kn_  = kn; update(); }
+    void setTrueDirectionDeg(double deg)      { true_dir_deg_ = deg; requestRepaint(); }
+    void setTrueSpeed(double kn)              { true_spd_kn_  = kn; requestRepaint(); }
 
 protected:
-    void paintEvent(QPaintEvent*) override;
+    SceneFn snapshotScene() const override;
 
 private:
     double true_dir_deg_{270.0};   // 真风向
@@ -26,9 +26,11 @@ private:
     // 工具函数：角度→圆上的点
     static QPointF polarPoint(const QPointF& c, double r, double deg_from_top_cw);
 
+    // 场景绘制（只依赖参数，可在任意线程执行）
+    static void paintScene(QPainter& p, const QSize& size, double dirDeg, const QColor& color);
     // 绘制刻度与数字
-    void drawScale(QPainter& p, const QRectF& rc, double r, double& scale_outer_radius);
+    static void drawScale(QPainter& p, const QRectF& rc, double r, double& scale_outer_radius);
     // 绘制倒三角指针
-    void drawPointerTriangle(QPainter& p, const QPointF& c, double r, double deg_from_top_cw, const QColor& color);
+    static void drawPointerTriangle(QPainter& p, const QPointF& c, double r, double deg_from_top_cw, const QColor& color);
 
 };
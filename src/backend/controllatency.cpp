@@ -0,0 +1,141 @@
+#include "backend/controllatency.h"
+#include <QStringList>
+#include <chrono>
+#include <cmath>
+
+ControlLatencyTracker::ControlLatencyTracker()
+{
+    reset();
+}
+
+qint64 ControlLatencyTracker::nowUs()
+{
+    using namespace std::chrono;
+    return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+int ControlLatencyTracker::bucketFor(qint64 us)
+{
+    if (us < kFirstUs)
+        return 0;
+    const int bucket = int(std::floor(kStepsPerOctave * std::log2(us / kFirstUs))) + 1;
+    return qMin(bucket, kBuckets - 1);
+}
+
+double ControlLatencyTracker::bucketLowerUs(int bucket)
+{
+    if (bucket <= 0)
+        return 0.0;
+    return kFirstUs * std::exp2(double(bucket - 1) / kStepsPerOctave);
+}
+
+void ControlLatencyTracker::Histogram::add(qint64 us)
+{
+    us = qMax<qint64>(0, us);
+    ++counts[bucketFor(us)];
+    ++count;
+    sumUs += us;
+    maxUs = qMax(maxUs, us);
+}
+
+double ControlLatencyTracker::Histogram::percentileUs(double p) const
+{
+    if (count == 0)
+        return 0.0;
+    const double target = p * count;
+    double cumulative = 0.0;
+    for (int i = 0; i < kBuckets; ++i) {
+        if (counts[i] == 0)
+            continue;
+        if (cumulative + counts[i] >= target) {
+            // 档内按均匀分布插值，最后一档的上界取实测最大值
+            const double lower = bucketLowerUs(i);
+            const double upper = i + 1 < kBuckets ? bucketLowerUs(i + 1) : double(maxUs);
+            const double fraction = (target - cumulative) / counts[i];
+            return qMin(lower + fraction * (upper - lower), double(maxUs));
+        }
+        cumulative += counts[i];
+    }
+    return double(maxUs);
+}
+
+ControlLatencyStage ControlLatencyTracker::Histogram::stage() const
+{
+    ControlLatencyStage s;
+    s.count = count;
+    if (count == 0)
+        return s;
+    s.meanMs = sumUs / count / 1000.0;
+    s.p50Ms = percentileUs(0.50) / 1000.0;
+    s.p99Ms = percentileUs(0.99) / 1000.0;
+    s.maxMs = maxUs / 1000.0;
+    return s;
+}
+
+void ControlLatencyTracker::record(qint64 sampledUs, qint64 dispatchedUs,
+                                   qint64 serializedUs, qint64 writtenUs)
+{
+    if (sampledUs <= 0)
+        return;
+    m_stages[SampleToDispatch].add(dispatchedUs - sampledUs);
+    m_stages[DispatchToSerialize].add(serializedUs - dispatchedUs);
+    m_stages[SerializeToSocket].add(writtenUs - serializedUs);
+    m_stages[Total].add(writtenUs - sampledUs);
+}
+
+void ControlLatencyTracker::reset()
+{
+    for (Histogram &h : m_stages)
+        h = Histogram();
+}
+
+ControlLatencySnapshot ControlLatencyTracker::snapshot() const
+{
+    ControlLatencySnapshot s;
+    s.sampleToDispatch = m_stages[SampleToDispatch].stage();
+    s.dispatchToSerialize = m_stages[DispatchToSerialize].stage();
+    s.serializeToSocket = m_stages[SerializeToSocket].stage();
+    s.total = m_stages[Total].stage();
+    return s;
+}
+
+QString ControlLatencyTracker::report() const
+{
+    const ControlLatencySnapshot s = snapshot();
+    QStringList lines;
+    lines << QString("控制延迟（%1 条指令）").arg(s.total.count);
+    auto stageLine = [&lines](const QString &name, const ControlLatencyStage &stage) {
+        lines << QString("  %1  平均 %2 ms  p50 %3 ms  p99 %4 ms  最大 %5 ms")
+                     .arg(name)
+                     .arg(stage.meanMs, 0, 'f', 2)
+                     .arg(stage.p50Ms, 0, 'f', 2)
+                     .arg(stage.p99Ms, 0, 'f', 2)
+                     .arg(stage.maxMs, 0, 'f', 2);
+    };
+    stageLine("采样→桥接  ", s.sampleToDispatch);
+    stageLine("桥接→序列化", s.dispatchToSerialize);
+    stageLine("序列化→发送", s.serializeToSocket);
+    stageLine("端到端     ", s.total);
+
+    const Histogram &total = m_stages[Total];
+    quint64 peak = 0;
+    for (quint64 c : total.counts)
+        peak = qMax(peak, c);
+    if (peak == 0)
+        return lines.join('\n');
+
+    lines << "  端到端分布:";
+    for (int i = 0; i < kBuckets; ++i) {
+        if (total.counts[i] == 0)
+            continue;
+        const double lowerMs = bucketLowerUs(i) / 1000.0;
+        const double upperMs = (i + 1 < kBuckets ? bucketLowerUs(i + 1) : double(total.maxUs)) / 1000.0;
+        const int bar = qMax(1, int(40 * total.counts[i] / peak));
+        lines << QString("  %1 – %2 ms %3 %4")
+                     .arg(lowerMs, 8, 'f', 3)
+                     .arg(upperMs, 8, 'f', 3)
+                     .arg(total.counts[i], 7)
+                     .arg(QString(bar, QChar('#')));
+    }
+    return lines.join('\n');
+}
@@ -0,0 +1,202 @@
+#include "backend/controlscheduler.h"
+#include <QVector>
+#include <QDebug>
+#include <algorithm>
+#include <cmath>
+
+#ifdef Q_OS_WIN
+#include <windows.h>
+#include <timeapi.h>
+#endif
+
+namespace {
+std::atomic<double> g_defaultRate { 20.0 };
+
+constexpr double kMinRateHz = 1.0;
+constexpr double kMaxRateHz = 500.0;
+constexpr qint64 kStatsWindowUs = 1000000;
+#ifdef Q_OS_WIN
+constexpr auto kSpinMargin = std::chrono::microseconds(1500);
+#else
+constexpr auto kSpinMargin = std::chrono::microseconds(300);
+#endif
+
+double percentile(QVector<double> &sorted, double p)
+{
+    if (sorted.isEmpty())
+        return 0.0;
+    const int index = qBound(0, int(std::ceil(p * sorted.size())) - 1, int(sorted.size()) - 1);
+    return sorted.at(index);
+}
+}
+
+ControlScheduler::ControlScheduler(const RudderController *input, QObject *parent)
+    : QThread(parent)
+    , m_input(input)
+    , m_rate(qBound(kMinRateHz, defaultRate(), kMaxRateHz))
+{
+}
+
+ControlScheduler::~ControlScheduler()
+{
+    stop();
+    wait();
+}
+
+void ControlScheduler::setDefaultRate(double hz)
+{
+    g_defaultRate.store(qMax(0.0, hz), std::memory_order_relaxed);
+}
+
+double ControlScheduler::defaultRate()
+{
+    return g_defaultRate.load(std::memory_order_relaxed);
+}
+
+void ControlScheduler::setRate(double hz)
+{
+    m_rate.store(qBound(kMinRateHz, hz, kMaxRateHz), std::memory_order_relaxed);
+}
+
+void ControlScheduler::setShaper(Shaper shaper)
+{
+    m_shaper = std::move(shaper);
+}
+
+void ControlScheduler::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_waitMutex);
+        m_running.store(false, std::memory_order_relaxed);
+    }
+    m_wake.notify_all();
+}
+
+ControlSchedulerStats ControlScheduler::stats() const
+{
+    QMutexLocker locker(&m_statsMutex);
+    return m_stats;
+}
+
+void ControlScheduler::sleepUntil(Clock::time_point deadline)
+{
+    // 粗睡到计划时刻前 kSpinMargin，剩余部分让出 CPU 等待
+    {
+        std::unique_lock<std::mutex> lock(m_waitMutex);
+        m_wake.wait_until(lock, deadline - kSpinMargin, [this] {
+            return !m_running.load(std::memory_order_relaxed);
+        });
+    }
+    while (m_running.load(std::memory_order_relaxed) && Clock::now() < deadline)
+        QThread::yieldCurrentThread();
+}
+
+void ControlScheduler::run()
+{
+    using namespace std::chrono;
+
+#ifdef Q_OS_WIN
+    timeBeginPeriod(1);
+#endif
+
+    auto periodFor = [](double hz) {
+        return duration_cast<Clock::duration>(duration<double>(1.0 / hz));
+    };
+
+    double rateHz = rate();
+    Clock::duration period = periodFor(rateHz);
+    Clock::time_point deadline = Clock::now() + period;
+    Clock::time_point lastWake;
+    Clock::time_point windowStart = Clock::now();
+
+    QVector<double> lateUs;
+    QVector<double> intervalUs;
+    quint64 ticks = 0;
+    quint64 missed = 0;
+    quint64 commands = 0;
+    qint64 lastSampledUs = 0;
+    qDebug() << "控制循环启动:" << rateHz << "Hz";
+
+    while (m_running.load(std::memory_order_relaxed)) {
+        sleepUntil(deadline);
+        if (!m_running.load(std::memory_order_relaxed))
+            break;
+
+        const Clock::time_point now = Clock::now();
+        lateUs.append(duration<double, std::micro>(now - deadline).count());
+        if (lastWake != Clock::time_point())
+            intervalUs.append(duration<double, std::micro>(now - lastWake).count());
+        lastWake = now;
+        ++ticks;
+
+        if (isActive()) {
+            const RudderState state = m_input->getCurrentState();
+            // 传设定周期而非实测间隔：计划时刻不漂移，平均周期即设定值，滤波系数可复用
+            ThrusterCommand command = m_shaper ? m_shaper(state, 1.0 / rateHz) : ThrusterCommand();
+            command.sampledUs = state.sampledUs != lastSampledUs ? state.sampledUs : 0;
+            lastSampledUs = state.sampledUs;
+            emit commandReady(command);
+            ++commands;
+        }
+
+        // 下一个计划时刻；频率变化时从当前计划时刻重新起算
+        const double newRate = rate();
+        if (newRate != rateHz) {
+            rateHz = newRate;
+            period = periodFor(rateHz);
+        }
+        deadline += period;
+        if (now >= deadline) {
+            const auto behind = (now - deadline) / period + 1;
+            missed += quint64(behind);
+            deadline += behind * period;
+        }
+
+        // 每秒汇总一次统计
+        if (duration_cast<microseconds>(now - windowStart).count() < kStatsWindowUs)
+            continue;
+        const double windowS = duration<double>(now - windowStart).count();
+        double lateSum = 0.0;
+        for (double v : std::as_const(lateUs))
+            lateSum += v;
+        double intervalSum = 0.0;
+        double intervalSq = 0.0;
+        for (double v : std::as_const(intervalUs)) {
+            intervalSum += v;
+            intervalSq += v * v;
+        }
+        const int intervals = int(intervalUs.size());
+        const double intervalMean = intervals > 0 ? intervalSum / intervals : 0.0;
+        const quint64 missedBefore = stats().missedTicks;
+        std::sort(lateUs.begin(), lateUs.end());
+        {
+            QMutexLocker locker(&m_statsMutex);
+            m_stats.rateHz = rateHz;
+            m_stats.actualHz = lateUs.size() / windowS;
+            m_stats.ticks = ticks;
+            m_stats.missedTicks = missed;
+            m_stats.commands = commands;
+            m_stats.lateMeanUs = lateUs.isEmpty() ? 0.0 : lateSum / lateUs.size();
+            m_stats.lateP50Us = percentile(lateUs, 0.50);
+            m_stats.lateP99Us = percentile(lateUs, 0.99);
+            m_stats.lateMaxUs = lateUs.isEmpty() ? 0.0 : lateUs.last();
+            m_stats.periodJitterUs = intervals > 1
+                ? std::sqrt(qMax(0.0, intervalSq / intervals - intervalMean * intervalMean)) : 0.0;
+        }
+        if (missed > missedBefore)
+            qWarning() << "控制循环跳过" << (missed - missedBefore) << "个周期（线程被挂起或负载过高）";
+        lateUs.clear();
+        intervalUs.clear();
+        windowStart = now;
+    }
+
+#ifdef Q_OS_WIN
+    timeEndPeriod(1);
+#endif
+
+    const ControlSchedulerStats s = stats();
+    qDebug().noquote() << QString("控制循环结束: %1 个周期，跳过 %2，延后 p50 %3 µs / p99 %4 µs / 最大 %5 µs")
+                              .arg(s.ticks).arg(s.missedTicks)
+                              .arg(s.lateP50Us, 0, 'f', 0).arg(s.lateP99Us, 0, 'f', 0)
+                              .arg(s.lateMaxUs, 0, 'f', 0);
+}
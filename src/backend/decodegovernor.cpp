@@ -0,0 +1,233 @@
+#include "backend/decodegovernor.h"
+#include <QThread>
+#include <QDebug>
+
+namespace {
+constexpr qint64 kWindowUs = 1000000;           // 评估窗口
+constexpr int kOverWindows = 2;                 // 连续过载窗口数达到后降级
+constexpr int kIdleWindows = 5;                 // 连续空闲窗口数达到后恢复
+constexpr qint64 kHoldUs = 3000000;             // 每次动作后的冷却
+constexpr qint64 kUpgradeDelayBaseUs = 0;
+constexpr qint64 kUpgradeDelayMinUs = 30000000; // 恢复后 30 秒内又过载视为恢复过早
+constexpr qint64 kUpgradeDelayMaxUs = 600000000;
+constexpr int kMaxThreads = 16;
+constexpr int kMaxSkipLevel = 2;
+constexpr int kBacklogPackets = 30;             // 包队列积压超过该值视为解码跟不上
+constexpr double kOverLoad = 0.9;
+constexpr double kIdleLoad = 0.5;
+constexpr double kGuiOverLoad = 1.5;            // 界面只取走不到 2/3 的帧
+constexpr double kGuiIdleLoad = 1.2;
+constexpr double kDefaultIntervalS = 0.04;      // 尚未测出帧间隔时按 25 fps
+}
+
+void DecodeGovernor::begin(bool sliceCapable, bool frameCapable, bool adaptive)
+{
+    m_adaptive = adaptive;
+    m_sliceCapable = sliceCapable;
+    m_frameCapable = frameCapable;
+
+    const int cores = qMax(1, QThread::idealThreadCount());
+    m_maxThreads = qMin(cores, kMaxThreads);
+    if (!sliceCapable && !frameCapable) {
+        m_threading = Threading{ 1, false };
+    } else if (!adaptive || !sliceCapable) {
+        // 本地文件等非实时源：吞吐优先，固定帧级多线程
+        m_threading = Threading{ frameCapable ? qMin(cores, 8) : qMin(cores, 4), !frameCapable };
+    } else {
+        // 实时流：延迟优先，从片级多线程开始
+        m_threading = Threading{ qBound(1, cores / 2, 4), true };
+    }
+    m_baseThreads = m_threading.threads;
+    m_skipLevel.store(0, std::memory_order_relaxed);
+
+    m_windowStartUs = 0;
+    m_windowBusyNs = 0;
+    m_windowPackets = 0;
+    m_lastDts = -1.0;
+    m_intervalS = 0.0;
+    m_overWindows = 0;
+    m_idleWindows = 0;
+    m_holdUntilUs = 0;
+    m_lastDowngradeUs = 0;
+    m_lastUpgradeUs = 0;
+    m_upgradeDelayUs = kUpgradeDelayBaseUs;
+    m_posted.store(0, std::memory_order_relaxed);
+    m_takeIntervalSumUs.store(0, std::memory_order_relaxed);
+    m_takeCount.store(0, std::memory_order_relaxed);
+
+    QMutexLocker locker(&m_statsMutex);
+    m_stats.adaptive = adaptive;
+    m_stats.threads = m_threading.threads;
+    m_stats.sliceThreading = m_threading.slice;
+    m_stats.skipLevel = 0;
+    m_stats.decodeLoad = 0.0;
+    m_stats.guiLoad = 0.0;
+    m_stats.guiFrameMs = 0.0;
+    m_stats.lastDecision = QString("初始：%1多线程 ×%2")
+                               .arg(m_threading.slice ? "片级" : "帧级").arg(m_threading.threads);
+}
+
+void DecodeGovernor::onPacketDecoded(qint64 busyNs, double dtsSeconds)
+{
+    m_windowBusyNs += busyNs;
+    ++m_windowPackets;
+
+    // 帧间隔按解码顺序的时间戳估计（B 帧重排不影响），跳变与重复时间戳忽略
+    if (dtsSeconds >= 0.0) {
+        if (m_lastDts >= 0.0) {
+            const double d = dtsSeconds - m_lastDts;
+            if (d > 0.001 && d < 1.0)
+                m_intervalS = m_intervalS > 0.0 ? m_intervalS * 0.9 + d * 0.1 : d;
+        }
+        m_lastDts = dtsSeconds;
+    }
+}
+
+void DecodeGovernor::onFrameTaken(qint64 nowUs)
+{
+    if (m_lastTakeUs > 0) {
+        const qint64 d = nowUs - m_lastTakeUs;
+        if (d < 2 * kWindowUs) {
+            m_takeIntervalSumUs.fetch_add(d, std::memory_order_relaxed);
+            m_takeCount.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    m_lastTakeUs = nowUs;
+}
+
+DecodeGovernor::Action DecodeGovernor::evaluate(qint64 nowUs, int queuedPackets)
+{
+    if (m_windowStartUs == 0) {
+        m_windowStartUs = nowUs;
+        return NoAction;
+    }
+    if (nowUs - m_windowStartUs < kWindowUs)
+        return NoAction;
+
+    // ---- 本窗口的负载 ----
+    const double interval = m_intervalS > 0.0 ? m_intervalS : kDefaultIntervalS;
+    const double load = m_windowPackets > 0
+        ? double(m_windowBusyNs) / m_windowPackets / 1e9 / interval : 0.0;
+    const int posted = m_posted.exchange(0, std::memory_order_relaxed);
+    const int takes = m_takeCount.exchange(0, std::memory_order_relaxed);
+    const qint64 takeSumUs = m_takeIntervalSumUs.exchange(0, std::memory_order_relaxed);
+    const double guiLoad = posted > 0 ? double(posted) / qMax(1, takes) : 0.0;
+    m_windowStartUs = nowUs;
+    m_windowBusyNs = 0;
+    m_windowPackets = 0;
+    {
+        QMutexLocker locker(&m_statsMutex);
+        m_stats.decodeLoad = load;
+        m_stats.guiLoad = guiLoad;
+        m_stats.guiFrameMs = takes > 0 ? takeSumUs / 1000.0 / takes : 0.0;
+        m_stats.frameIntervalMs = interval * 1000.0;
+    }
+    if (!m_adaptive)
+        return NoAction;
+
+    const bool decodeOver = load > kOverLoad || queuedPackets > kBacklogPackets;
+    const bool guiOver = posted >= 10 && guiLoad > kGuiOverLoad;
+    const bool idle = load < kIdleLoad && guiLoad < kGuiIdleLoad && queuedPackets < 5;
+    if (decodeOver || guiOver) {
+        ++m_overWindows;
+        m_idleWindows = 0;
+    } else if (idle) {
+        ++m_idleWindows;
+        m_overWindows = 0;
+    } else {
+        m_overWindows = 0;
+        m_idleWindows = 0;
+    }
+    if (nowUs < m_holdUntilUs)
+        return NoAction;
+
+    Action action = NoAction;
+    if (m_overWindows >= kOverWindows) {
+        QString why = decodeOver
+            ? QString("解码占用 %1%").arg(qRound(load * 100))
+            : QString("界面只显示了 %1% 的帧").arg(qRound(100.0 / guiLoad));
+        if (queuedPackets > kBacklogPackets)
+            why += QString("，积压 %1 包").arg(queuedPackets);
+
+        // 恢复后很快又过载：下次恢复前等待加倍
+        if (m_lastUpgradeUs > 0 && nowUs - m_lastUpgradeUs < kUpgradeDelayMinUs)
+            m_upgradeDelayUs = qBound(kUpgradeDelayMinUs, m_upgradeDelayUs * 2, kUpgradeDelayMaxUs);
+        m_lastDowngradeUs = nowUs;
+
+        if (decodeOver && m_threading.slice && m_frameCapable) {
+            // 片级多线程对单片编码的流没有并行度；改为帧级，多 threads-1 帧延迟换吞吐
+            m_threading = Threading{ qMax(2, m_threading.threads), false };
+            decide(QString("片级→帧级多线程 ×%1").arg(m_threading.threads), why, true);
+            action = Reconfigure;
+        } else if (decodeOver && !m_threading.slice && m_threading.threads < m_maxThreads) {
+            m_threading.threads = qMin(m_threading.threads * 2, m_maxThreads);
+            decide(QString("帧级多线程 ×%1").arg(m_threading.threads), why, true);
+            action = Reconfigure;
+        } else if (skipLevel() < kMaxSkipLevel) {
+            const int level = skipLevel() + 1;
+            m_skipLevel.store(level, std::memory_order_relaxed);
+            decide(level == 1 ? QString("丢弃非参考帧") : QString("关闭环路滤波"), why, true);
+            action = ChangeSkip;
+        }
+    } else if (m_idleWindows >= kIdleWindows && nowUs - m_lastDowngradeUs >= m_upgradeDelayUs) {
+        const QString why = QString("解码占用 %1%").arg(qRound(load * 100));
+        if (skipLevel() > 0) {
+            // 先恢复画质
+            const int level = skipLevel() - 1;
+            m_skipLevel.store(level, std::memory_order_relaxed);
+            decide(level == 0 ? QString("恢复完整解码") : QString("恢复环路滤波"), why, false);
+            action = ChangeSkip;
+        } else if (!m_threading.slice && m_sliceCapable && load * m_threading.threads < kIdleLoad) {
+            // 帧级下的占用乘以线程数估计单线程耗时，估计跟得上才回到低延迟的片级
+            m_threading = Threading{ m_baseThreads, true };
+            decide(QString("帧级→片级多线程 ×%1（降低延迟）").arg(m_threading.threads), why, false);
+            action = Reconfigure;
+        } else if (!m_threading.slice && m_threading.threads > m_baseThreads) {
+            m_threading.threads = qMax(m_baseThreads, m_threading.threads / 2);
+            decide(QString("帧级多线程 ×%1（释放 CPU）").arg(m_threading.threads), why, false);
+            action = Reconfigure;
+        }
+        if (action != NoAction)
+            m_lastUpgradeUs = nowUs;
+    } else if (m_lastUpgradeUs > 0 && nowUs - m_lastUpgradeUs > kUpgradeDelayMaxUs) {
+        m_upgradeDelayUs = kUpgradeDelayBaseUs;     // 长期稳定，恢复等待归零
+    }
+
+    if (action != NoAction) {
+        m_overWindows = 0;
+        m_idleWindows = 0;
+        m_holdUntilUs = nowUs + kHoldUs;
+    }
+    return action;
+}
+
+void DecodeGovernor::revertThreading(const Threading &previous)
+{
+    m_threading = previous;
+    QMutexLocker locker(&m_statsMutex);
+    m_stats.threads = previous.threads;
+    m_stats.sliceThreading = previous.slice;
+    m_stats.lastDecision += "（重开解码器失败，已退回）";
+}
+
+void DecodeGovernor::decide(const QString &what, const QString &why, bool downgrade)
+{
+    QMutexLocker locker(&m_statsMutex);
+    if (downgrade)
+        ++m_stats.downgrades;
+    else
+        ++m_stats.upgrades;
+    if (m_threading.threads != m_stats.threads || m_threading.slice != m_stats.sliceThreading)
+        ++m_stats.reconfigures;
+    m_stats.threads = m_threading.threads;
+    m_stats.sliceThreading = m_threading.slice;
+    m_stats.skipLevel = skipLevel();
+    m_stats.lastDecision = QString("%1（%2）").arg(what, why);
+    qDebug() << "Decode governor:" << m_stats.lastDecision;
+}
+
+DecodeGovernorStats DecodeGovernor::stats() const
+{
+    QMutexLocker locker(&m_statsMutex);
+    return m_stats;
+}
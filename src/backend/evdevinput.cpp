@@ -0,0 +1,316 @@
+#include "backend/evdevinput.h"
+
+#ifdef Q_OS_LINUX
+
+#include <QDir>
+#include <QDebug>
+#include <QElapsedTimer>
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <fcntl.h>
+#include <linux/input.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+namespace {
+constexpr int kLongBits = 8 * sizeof(unsigned long);
+constexpr int kEventBatch = 64;
+
+bool testBit(const unsigned long *bits, int bit)
+{
+    return bits[bit / kLongBits] & (1UL << (bit % kLongBits));
+}
+
+int eventNumber(const QString &name)
+{
+    return name.mid(5).toInt();     // "eventN"
+}
+}
+
+EvdevInputSource::EvdevInputSource(const QString &devicePath)
+    : m_fixedPath(devicePath)
+{
+}
+
+EvdevInputSource::~EvdevInputSource()
+{
+    closeDevice();
+    if (m_notifyFd >= 0)
+        ::close(m_notifyFd);
+    if (m_wakeFd >= 0)
+        ::close(m_wakeFd);
+}
+
+QString EvdevInputSource::name() const
+{
+    if (m_fd < 0)
+        return QString("evdev（未连接）");
+    return QString("evdev %1 (%2)").arg(m_deviceName, m_devicePath);
+}
+
+bool EvdevInputSource::open(QString *error)
+{
+    m_wakeFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if (m_wakeFd < 0) {
+        if (error)
+            *error = QString("eventfd 创建失败: %1").arg(QString::fromLocal8Bit(std::strerror(errno)));
+        return false;
+    }
+
+    // 热插拔：/dev/input 下新建节点或 udev 修改权限后重新查找设备
+    m_notifyFd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_notifyFd >= 0 && ::inotify_add_watch(m_notifyFd, "/dev/input", IN_CREATE | IN_ATTRIB) < 0) {
+        ::close(m_notifyFd);
+        m_notifyFd = -1;
+    }
+    if (m_notifyFd < 0)
+        qWarning() << "无法监视 /dev/input，手柄拔出后不会自动重连";
+
+    if (!openDevice())
+        qWarning() << "未找到 evdev 手柄，等待设备接入";
+    return true;
+}
+
+bool EvdevInputSource::openDevice()
+{
+    if (!m_fixedPath.isEmpty())
+        return tryDevice(m_fixedPath);
+
+    QStringList nodes = QDir("/dev/input").entryList({ "event*" }, QDir::System);
+    std::sort(nodes.begin(), nodes.end(), [](const QString &a, const QString &b) {
+        return eventNumber(a) < eventNumber(b);
+    });
+    for (const QString &node : std::as_const(nodes)) {
+        if (tryDevice("/dev/input/" + node))
+            return true;
+    }
+    return false;
+}
+
+bool EvdevInputSource::tryDevice(const QString &path)
+{
+    const int fd = ::open(QFile::encodeName(path).constData(), O_RDONLY | O_NONBLOCK | O_CLOEXEC);
+    if (fd < 0) {
+        if (errno == EACCES && !m_warnedAccess) {
+            qWarning() << "无权限读取" << path << "（需要加入 input 组或配置 udev 规则）";
+            m_warnedAccess = true;
+        }
+        return false;
+    }
+
+    unsigned long absBits[ABS_MAX / kLongBits + 1] = {};
+    unsigned long keyBits[KEY_MAX / kLongBits + 1] = {};
+    if (::ioctl(fd, EVIOCGBIT(EV_ABS, sizeof(absBits)), absBits) < 0
+        || ::ioctl(fd, EVIOCGBIT(EV_KEY, sizeof(keyBits)), keyBits) < 0) {
+        ::close(fd);
+        return false;
+    }
+
+    // 手柄 / 摇杆：有 X/Y 绝对轴和手柄或摇杆按键；触摸板也有 X/Y，但带 BTN_TOUCH
+    const bool stick = testBit(absBits, ABS_X) && testBit(absBits, ABS_Y);
+    const bool buttons = testBit(keyBits, BTN_GAMEPAD) || testBit(keyBits, BTN_JOYSTICK);
+    if (!stick || !buttons || testBit(keyBits, BTN_TOUCH)) {
+        ::close(fd);
+        return false;
+    }
+
+    const int codes[AxisCount] = {
+        ABS_X,
+        ABS_Y,
+        testBit(absBits, ABS_RX) ? ABS_RX : ABS_Z,
+        testBit(absBits, ABS_RY) ? ABS_RY : ABS_RZ,
+    };
+    for (int i = 0; i < AxisCount; ++i) {
+        m_axes[i] = Axis();
+        input_absinfo info {};
+        if (!testBit(absBits, codes[i]) || ::ioctl(fd, EVIOCGABS(codes[i]), &info) < 0
+            || info.maximum <= info.minimum)
+            continue;
+        m_axes[i].code = codes[i];
+        m_axes[i].minimum = info.minimum;
+        m_axes[i].maximum = info.maximum;
+        m_axes[i].flat = info.flat;
+    }
+
+    char name[256] = {};
+    ::ioctl(fd, EVIOCGNAME(sizeof(name) - 1), name);
+
+    m_fd = fd;
+    m_devicePath = path;
+    m_deviceName = QString::fromLocal8Bit(name);
+    m_dropped = false;
+    resync();
+    m_reported = m_pending;
+    m_dirty = false;
+    qDebug() << "evdev 手柄:" << m_deviceName << path;
+    return true;
+}
+
+void EvdevInputSource::closeDevice()
+{
+    if (m_fd < 0)
+        return;
+    ::close(m_fd);
+    m_fd = -1;
+    m_pending = RudderState();
+    m_reported = RudderState();
+    m_dirty = false;
+    m_dropped = false;
+    qWarning() << "evdev 手柄已断开:" << m_deviceName;
+}
+
+void EvdevInputSource::resync()
+{
+    // 丢失事件后当前值不可信，直接读取各轴的内核状态
+    for (const Axis &axis : m_axes) {
+        input_absinfo info {};
+        if (axis.code >= 0 && ::ioctl(m_fd, EVIOCGABS(axis.code), &info) >= 0)
+            applyAxis(axis.code, info.value);
+    }
+}
+
+void EvdevInputSource::applyAxis(int code, int value)
+{
+    for (int i = 0; i < AxisCount; ++i) {
+        if (m_axes[i].code != code)
+            continue;
+        const float v = normalize(m_axes[i], value);
+        switch (i) {
+        case LeftX:  m_pending.leftX = v; break;
+        case LeftY:  m_pending.leftY = v; break;
+        case RightX: m_pending.rightX = v; break;
+        case RightY: m_pending.rightY = v; break;
+        default: break;
+        }
+        m_dirty = true;
+    }
+}
+
+float EvdevInputSource::normalize(const Axis &axis, int value) const
+{
+    const double center = (axis.minimum + axis.maximum) / 2.0;
+    const double half = (axis.maximum - axis.minimum) / 2.0;
+    const double offset = value - center;
+    if (std::abs(offset) <= axis.flat)
+        return 0.0f;
+    return float(qBound(-1.0, offset / half, 1.0));
+}
+
+RudderInputSource::WaitResult EvdevInputSource::wait(RudderState &state, int timeoutMs)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    for (;;) {
+        const int remaining = timeoutMs - int(timer.elapsed());
+        if (remaining <= 0)
+            return Timeout;
+
+        pollfd fds[3];
+        int count = 0;
+        int notifyIndex = -1;
+        int deviceIndex = -1;
+        fds[count++] = pollfd{ m_wakeFd, POLLIN, 0 };
+        if (m_notifyFd >= 0) {
+            notifyIndex = count;
+            fds[count++] = pollfd{ m_notifyFd, POLLIN, 0 };
+        }
+        if (m_fd >= 0) {
+            deviceIndex = count;
+            fds[count++] = pollfd{ m_fd, POLLIN, 0 };
+        }
+
+        const int ready = ::poll(fds, nfds_t(count), remaining);
+        if (ready < 0) {
+            if (errno == EINTR)
+                continue;
+            qWarning() << "evdev poll 失败:" << std::strerror(errno);
+            return Timeout;
+        }
+        if (ready == 0)
+            return Timeout;
+
+        if (fds[0].revents & POLLIN) {
+            quint64 value = 0;
+            if (::read(m_wakeFd, &value, sizeof(value)) < 0) {
+                // eventfd 已被其他唤醒读空，忽略
+            }
+            return Timeout;
+        }
+
+        if (notifyIndex >= 0 && (fds[notifyIndex].revents & POLLIN)) {
+            char buffer[4096];
+            while (::read(m_notifyFd, buffer, sizeof(buffer)) > 0) {
+            }
+            if (m_fd < 0 && openDevice()) {
+                state = m_reported;
+                return Updated;
+            }
+        }
+
+        if (deviceIndex < 0 || !fds[deviceIndex].revents)
+            continue;
+
+        bool lost = (fds[deviceIndex].revents & (POLLERR | POLLHUP | POLLNVAL)) != 0;
+        bool report = false;
+        input_event events[kEventBatch];
+        while (!lost) {
+            const ssize_t bytes = ::read(m_fd, events, sizeof(events));
+            if (bytes < 0) {
+                if (errno != EAGAIN && errno != EINTR)
+                    lost = true;    // ENODEV：设备已拔出
+                break;
+            }
+            const int n = int(bytes / ssize_t(sizeof(input_event)));
+            for (int i = 0; i < n; ++i) {
+                const input_event &ev = events[i];
+                if (ev.type == EV_ABS) {
+                    if (!m_dropped)
+                        applyAxis(ev.code, ev.value);
+                } else if (ev.type == EV_SYN && ev.code == SYN_DROPPED) {
+                    m_dropped = true;
+                } else if (ev.type == EV_SYN && ev.code == SYN_REPORT) {
+                    if (m_dropped) {
+                        m_dropped = false;
+                        resync();
+                    }
+                    // 一批事件以 SYN_REPORT 结束；同一次读取中的多批只交出最新一批
+                    if (m_dirty) {
+                        m_reported = m_pending;
+                        m_dirty = false;
+                        report = true;
+                    }
+                }
+            }
+            if (n < kEventBatch)
+                break;
+        }
+
+        if (lost) {
+            closeDevice();
+            state = RudderState();
+            return Disconnected;
+        }
+        if (report) {
+            state = m_reported;
+            return Updated;
+        }
+    }
+}
+
+void EvdevInputSource::interrupt()
+{
+    if (m_wakeFd < 0)
+        return;
+    const quint64 one = 1;
+    if (::write(m_wakeFd, &one, sizeof(one)) < 0) {
+        // 计数器已满时 poll 必然可读，无需处理
+    }
+}
+
+#endif // Q_OS_LINUX
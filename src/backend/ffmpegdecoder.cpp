@@ -1,9 +1,134 @@
 #include "backend/ffmpegdecoder.h"
+#include "backend/streamparamcache.h"
 #include <QDebug>
-#include <QtConcurrent>
 #include <QThread>
+#include <QElapsedTimer>
+#include <QDateTime>
+#include <QDeadlineTimer>
+#include <QRandomGenerator>
+#include <chrono>
 
-FFmpegDecoder::FFmpegDecoder(QObject *parent) : QObject(parent)
+extern "C" {
+    #include <libavutil/opt.h>
+    #include <libavutil/pixdesc.h>
+}
+
+namespace {
+// 帧池容量：转换中 1 + 信箱中 1 + 显示中 1 + 余量 1
+constexpr int kFramePoolCapacity = 4;
+// 包队列容量：足以吸收一个 GOP 的网络突发
+constexpr int kPacketQueueCapacity = 256;
+// 解码帧队列容量：只做短暂缓冲，转换跟不上时尽快形成背压
+constexpr int kFrameQueueCapacity = 3;
+// 备用模式 GOP 缓存上限；超出（GOP 过长）时放弃本 GOP，等待下一个关键帧
+constexpr int kMaxGopPackets = 600;
+constexpr qint64 kMaxGopBytes = 16 * 1024 * 1024;
+// 阻塞调用截止时间：连接 / 探测、单次读包、断开
+constexpr int kOpenTimeoutMs = 5000;
+constexpr int kReadTimeoutMs = 3000;
+constexpr int kCloseTimeoutMs = 1000;
+// 连续读错误达到该值时视为连接损坏，重新连接
+constexpr int kMaxConsecutiveReadErrors = 50;
+// 重连退避：起始间隔与上限
+constexpr int kReconnectBaseMs = 250;
+constexpr int kReconnectMaxMs = 8000;
+// 帧间隔检测：包到达间隔超过该值记为一次网络卡顿；时间戳前跳超过该值记为源端丢帧
+constexpr qint64 kStallThresholdMs = 500;
+constexpr int64_t kPtsGapMs = 1000;
+// 颜色转换切片：每个线程至少分到约 180 行输出；最多用一半逻辑核，其余留给解码线程与其他流
+constexpr int kConvertRowsPerThread = 180;
+constexpr int kMaxConvertThreads = 8;
+
+int autoConvertThreads(int dstHeight)
+{
+    const int byRows = dstHeight / kConvertRowsPerThread;
+    const int byCores = QThread::idealThreadCount() / 2;
+    return qBound(1, qMin(byRows, byCores), kMaxConvertThreads);
+}
+
+// 显示表面后备缓冲格式 → 内存布局相同的不透明格式。
+// 视频帧不透明，同布局的不透明格式贴图时是直接拷贝，不做格式转换也不做混合
+QImage::Format opaqueOutputFormat(QImage::Format display)
+{
+    switch (display) {
+    case QImage::Format_RGBX8888:
+    case QImage::Format_RGBA8888:
+    case QImage::Format_RGBA8888_Premultiplied:
+        return QImage::Format_RGBX8888;
+    case QImage::Format_RGB16:
+        return QImage::Format_RGB16;
+    case QImage::Format_RGB888:
+        return QImage::Format_RGB888;
+    case QImage::Format_BGR888:
+        return QImage::Format_BGR888;
+    default:
+        return QImage::Format_RGB32;    // RGB32 / ARGB32(_Premultiplied) 及其余格式
+    }
+}
+
+AVPixelFormat avPixelFormat(QImage::Format format)
+{
+    switch (format) {
+    case QImage::Format_RGBX8888: return AV_PIX_FMT_RGBA;       // 字节序 R,G,B,A，A 写 255
+    case QImage::Format_RGB16:    return AV_PIX_FMT_RGB565;     // 本机字节序
+    case QImage::Format_RGB888:   return AV_PIX_FMT_RGB24;
+    case QImage::Format_BGR888:   return AV_PIX_FMT_BGR24;
+    default:                      return AV_PIX_FMT_RGB32;      // 本机字节序 0xAARRGGBB
+    }
+}
+
+// 输出缓冲区属于帧池，AVBufferRef 只是借用
+void borrowedBufferFree(void *, uint8_t *) {}
+}
+
+// ============================================================
+// StageMeter
+// ============================================================
+void StageMeter::add(qint64 ns)
+{
+    const quint64 v = quint64(qMax<qint64>(0, ns));
+    m_count.fetch_add(1, std::memory_order_relaxed);
+    m_totalNs.fetch_add(v, std::memory_order_relaxed);
+    quint64 prev = m_maxNs.load(std::memory_order_relaxed);
+    while (v > prev && !m_maxNs.compare_exchange_weak(prev, v, std::memory_order_relaxed)) {
+    }
+}
+
+VideoStageStats StageMeter::snapshot()
+{
+    const quint64 count = m_count.load(std::memory_order_relaxed);
+    const quint64 total = m_totalNs.load(std::memory_order_relaxed);
+    VideoStageStats stats;
+    stats.count = count - m_lastCount;
+    if (stats.count > 0)
+        stats.avgMs = double(total - m_lastTotalNs) / stats.count / 1e6;
+    stats.maxMs = m_maxNs.exchange(0, std::memory_order_relaxed) / 1e6;
+    m_lastCount = count;
+    m_lastTotalNs = total;
+    return stats;
+}
+
+void StageMeter::reset()
+{
+    m_count = 0;
+    m_totalNs = 0;
+    m_maxNs = 0;
+    m_lastCount = 0;
+    m_lastTotalNs = 0;
+}
+
+// ============================================================
+// FFmpegDecoder
+// ============================================================
+FFmpegDecoder::FFmpegDecoder(QObject *parent)
+    : QObject(parent)
+    , m_framePool(FramePool::create(kFramePoolCapacity))
+    , m_freePackets(kPacketQueueCapacity)
+    , m_packetQueue(kPacketQueueCapacity + 1)     // +1 给流结束标记
+    , m_freeFrames(kFrameQueueCapacity + 1)
+    , m_frameQueue(kFrameQueueCapacity + 2)
+    , m_recorder(std::make_unique<VideoRecorder>())
+    , m_replayRing(std::make_shared<PacketRing>(0))
 {
     initFFmpeg();
 }
@@ -27,20 +152,54 @@ bool FFmpegDecoder::initFFmpeg()
 
 bool FFmpegDecoder::openStream(const QString &url)
 {
-    QMutexLocker locker(&m_mutex);
-
-    if (m_state == Playing || m_state == Connecting) {
-        m_errorString = "Stream is already open";
+    const DecoderState state = getState();
+    if (state == Playing || state == Connecting || state == Reconnecting) {
+        setErrorString("Stream is already open");
         return false;
     }
 
-    setState(Connecting);
+    // 回收上一次流水线（自然结束、出错或暂停中）的线程
+    requestStop();
+    stopPipeline();
     cleanup();
 
+    m_url = url;
+    m_stopped = false;
+    m_paused = false;
+    m_warmOpen = false;
+    m_ttffMs = -1;
+    m_outageMs = -1;
+    m_outageTimer.invalidate();
+    setState(Connecting);
+
+    // 连接与探测在读包线程中进行，不阻塞界面（备用流可同时在后台建立）
+    m_readThread = QThread::create([this]() { readerMain(); });
+    m_readThread->setObjectName("VideoDemux");
+    m_readThread->start(QThread::HighPriority);
+
+    return true;
+}
+
+bool FFmpegDecoder::openInput()
+{
+    // 首帧耗时按本次连接计：不含之前失败的尝试与退避等待
+    m_warmOpen = false;
+    m_ttffMs = -1;
+    m_openTimer.start();
+
+    // 中断回调：stop() 后阻塞中的 FFmpeg 调用立即返回
+    m_formatContext = avformat_alloc_context();
+    if (!m_formatContext) {
+        setErrorString("Failed to allocate format context");
+        return false;
+    }
+    m_formatContext->interrupt_callback.callback = &FFmpegDecoder::interruptCallback;
+    m_formatContext->interrupt_callback.opaque = this;
+
     // 优化RTSP选项
         AVDictionary *options = nullptr;
         av_dict_set(&options, "rtsp_transport", "tcp", 0);
-        av_dict_set(&options, "stimeout", "3000000", 0);    // 3秒超时
+        av_dict_set(&options, "timeout", "3000000", 0);     // 套接字 I/O 超时（微秒）
         av_dict_set(&options, "max_delay", "100000", 0);    // 减少延迟
         av_dict_set(&options, "fflags", "nobuffer", 0);     // 无缓冲
         av_dict_set(&options, "flags", "low_delay", 0);     // 低延迟模式
@@ -49,55 +208,72 @@ bool FFmpegDecoder::openStream(const QString &url)
         // 对于实时流，跳过帧以提高响应速度
         av_dict_set(&options, "skip_frame", "default", 0);
 
-    // 打开输入流
-    int ret = avformat_open_input(&m_formatContext, url.toUtf8().constData(), nullptr, &options);
+    // 打开输入流（连接 + RTSP 握手受截止时间约束）
+    armDeadline(kOpenTimeoutMs);
+    // "lavfi:<滤镜图>" 为合成测试源（需要 libavdevice 已注册，见 video_bench）
+    const AVInputFormat *inputFormat = nullptr;
+    QString location = m_url;
+    if (m_url.startsWith("lavfi:")) {
+        inputFormat = av_find_input_format("lavfi");
+        location = m_url.mid(6);
+    }
+    int ret = avformat_open_input(&m_formatContext, location.toUtf8().constData(), inputFormat, &options);
     av_dict_free(&options);
 
     if (ret != 0) {
-        m_errorString = QString("Failed to open stream: %1").arg(ret);
-        setState(Error);
+        setErrorString(QString("Failed to open stream: %1").arg(ret));
         return false;
     }
 
-    // 获取流信息
-    if (avformat_find_stream_info(m_formatContext, nullptr) < 0) {
-        m_errorString = "Failed to retrieve stream information";
-        setState(Error);
+    // 查找视频流（RTSP 的流列表在 SDP 中已经给出，无需探测）
+    m_videoStreamIndex = av_find_best_stream(m_formatContext, AVMEDIA_TYPE_VIDEO, -1, -1, nullptr, 0);
+
+    // 热打开：用缓存的编码参数代替 avformat_find_stream_info
+    StreamParamCache &cache = StreamParamCache::instance();
+    bool warm = m_videoStreamIndex >= 0
+        && cache.apply(m_url, m_formatContext->streams[m_videoStreamIndex]->codecpar);
+    if (!warm && !probeStreamInfo()) {
         return false;
     }
 
-    // 查找视频流
-    m_videoStreamIndex = -1;
-    for (unsigned int i = 0; i < m_formatContext->nb_streams; i++) {
-        if (m_formatContext->streams[i]->codecpar->codec_type == AVMEDIA_TYPE_VIDEO) {
-            m_videoStreamIndex = i;
-            break;
+    // 初始化解码器；缓存的参数打不开解码器时作废缓存，退回完整探测
+    if (!initCodec()) {
+        if (!warm) {
+            return false;
+        }
+        qDebug() << "Cached stream parameters rejected, probing:" << m_url;
+        cache.remove(m_url);
+        avcodec_free_context(&m_codecContext);
+        warm = false;
+        if (!probeStreamInfo() || !initCodec()) {
+            return false;
         }
     }
 
-    if (m_videoStreamIndex == -1) {
-        m_errorString = "No video stream found";
-        setState(Error);
-        return false;
-    }
+    m_warmOpen = warm;
+    m_awaitKeyframe = true;
+    m_firstFrameChecked = false;
 
-    // 初始化解码器
-    if (!initCodec()) {
+    // 分配流水线缓冲
+    return initBuffers();
+}
+
+bool FFmpegDecoder::probeStreamInfo()
+{
+    // 获取流信息
+    armDeadline(kOpenTimeoutMs);
+    if (avformat_find_stream_info(m_formatContext, nullptr) < 0) {
+        setErrorString("Failed to retrieve stream information");
         return false;
     }
 
-    // 初始化图像转换上下文
-    if (!initSwsContext()) {
+    m_videoStreamIndex = av_find_best_stream(m_formatContext, AVMEDIA_TYPE_VIDEO, -1, -1, nullptr, 0);
+    if (m_videoStreamIndex < 0) {
+        setErrorString("No video stream found");
         return false;
     }
 
-    m_stopped = false;
-    m_paused = false;
-
-    // 在单独的线程中开始解码
-    // 正确的Qt6写法
-    QtConcurrent::run(&FFmpegDecoder::run, this);
-
+    StreamParamCache::instance().store(m_url, m_formatContext->streams[m_videoStreamIndex]->codecpar);
     return true;
 }
 
@@ -107,152 +283,830 @@ bool FFmpegDecoder::initCodec()
     const AVCodec *codec = avcodec_find_decoder(codecParams->codec_id);
 
     if (!codec) {
-        m_errorString = "Unsupported codec";
-        setState(Error);
+        setErrorString("Unsupported codec");
         return false;
     }
 
-    m_codecContext = avcodec_alloc_context3(codec);
-    if (!m_codecContext) {
-        m_errorString = "Failed to allocate codec context";
-        setState(Error);
+    // 线程配置由调控器决定：实时流从片级多线程开始，本地文件固定帧级多线程
+    m_governor.begin(codec->capabilities & AV_CODEC_CAP_SLICE_THREADS,
+                     codec->capabilities & AV_CODEC_CAP_FRAME_THREADS,
+                     isLiveSource() && m_governorEnabled.load(std::memory_order_relaxed));
+    m_codecContext = createCodecContext(m_governor.threading());
+    if (!m_codecContext)
         return false;
+    m_activeThreading = m_governor.threading();
+    m_reconfigurePending = false;
+
+    m_videoWidth = m_codecContext->width;
+    m_videoHeight = m_codecContext->height;
+
+    return true;
+}
+
+AVCodecContext *FFmpegDecoder::createCodecContext(const DecodeGovernor::Threading &threading)
+{
+    AVCodecParameters *codecParams = m_formatContext->streams[m_videoStreamIndex]->codecpar;
+    const AVCodec *codec = avcodec_find_decoder(codecParams->codec_id);
+    if (!codec) {
+        setErrorString("Unsupported codec");
+        return nullptr;
     }
 
-    if (avcodec_parameters_to_context(m_codecContext, codecParams) < 0) {
-        m_errorString = "Failed to copy codec parameters";
-        setState(Error);
-        return false;
+    AVCodecContext *ctx = avcodec_alloc_context3(codec);
+    if (!ctx) {
+        setErrorString("Failed to allocate codec context");
+        return nullptr;
     }
 
-    // 优化解码器参数
-        m_codecContext->flags2 |= AV_CODEC_FLAG2_FAST;    // 启用快速解码
-        m_codecContext->thread_count = 4;                // 多线程解码
-        m_codecContext->thread_type = FF_THREAD_FRAME;   // 帧级多线程
+    if (avcodec_parameters_to_context(ctx, codecParams) < 0) {
+        setErrorString("Failed to copy codec parameters");
+        avcodec_free_context(&ctx);
+        return nullptr;
+    }
 
-        // 设置低延迟参数
-        m_codecContext->flags |= AV_CODEC_FLAG_LOW_DELAY;
+    // 片级多线程不增加延迟，配合 LOW_DELAY 立即输出；
+    // 帧级多线程与 LOW_DELAY 互斥（同时设置时 FFmpeg 会退回单线程），只在片级时设置
+    ctx->thread_count = threading.threads;
+    ctx->thread_type = threading.slice ? FF_THREAD_SLICE : FF_THREAD_FRAME;
+    if (threading.slice)
+        ctx->flags |= AV_CODEC_FLAG_LOW_DELAY;
 
-    if (avcodec_open2(m_codecContext, codec, nullptr) < 0) {
-        m_errorString = "Failed to open codec";
-        setState(Error);
-        return false;
+    // 低分辨率解码只能在打开解码器前设置，且只有少数编码（如 MJPEG）支持；
+    // 以打开时的解码质量为准，H.264/HEVC 的 max_lowres 为 0，不受影响
+    if (m_decodeQuality.load(std::memory_order_relaxed) != FullQuality && codec->max_lowres > 0) {
+        ctx->lowres = qMin(1, int(codec->max_lowres));
     }
 
-    m_videoWidth = m_codecContext->width;
-    m_videoHeight = m_codecContext->height;
+    if (avcodec_open2(ctx, codec, nullptr) < 0) {
+        setErrorString("Failed to open codec");
+        avcodec_free_context(&ctx);
+        return nullptr;
+    }
 
-    return true;
+    qDebug() << "Decoder threading:" << (threading.slice ? "slice" : "frame") << "x" << threading.threads
+             << "active:" << (ctx->active_thread_type == FF_THREAD_FRAME ? "frame"
+                              : ctx->active_thread_type == FF_THREAD_SLICE ? "slice" : "none");
+    return ctx;
+}
+
+void FFmpegDecoder::reopenCodec()
+{
+    m_reconfigurePending = false;
+    const DecodeGovernor::Threading threading = m_governor.threading();
+    AVCodecContext *ctx = createCodecContext(threading);
+    if (!ctx) {
+        qDebug() << "Decoder reconfiguration failed:" << getErrorString();
+        m_governor.revertThreading(m_activeThreading);
+        return;
+    }
+
+    // 切换发生在关键帧：旧解码器中尚未输出的在途帧直接丢弃，后续画面不依赖它们
+    avcodec_free_context(&m_codecContext);
+    m_codecContext = ctx;
+    m_activeThreading = threading;
+    m_appliedQuality = -1;      // 新上下文需要重新应用丢帧设置
 }
 
-bool FFmpegDecoder::initSwsContext()
+bool FFmpegDecoder::initBuffers()
 {
-    m_frame = av_frame_alloc();
-    m_frameRGB = av_frame_alloc();
-    m_packet = av_packet_alloc();
+    // 数据包与帧一次性分配，流水线运行期间循环使用
+    m_freePackets.reset();
+    m_packetQueue.reset();
+    m_freeFrames.reset();
+    m_frameQueue.reset();
 
-    if (!m_frame || !m_frameRGB || !m_packet) {
-        m_errorString = "Failed to allocate frames/packet";
-        setState(Error);
+    for (int i = 0; i < m_freePackets.capacity(); ++i) {
+        AVPacket *pkt = av_packet_alloc();
+        if (!pkt)
+            break;
+        m_packetStore.append(pkt);
+        m_freePackets.push(pkt);
+    }
+    for (int i = 0; i < m_freeFrames.capacity(); ++i) {
+        AVFrame *frame = av_frame_alloc();
+        if (!frame)
+            break;
+        m_frameStore.append(frame);
+        m_freeFrames.push(frame);
+    }
+
+    if (m_packetStore.size() != m_freePackets.capacity()
+        || m_frameStore.size() != m_freeFrames.capacity()) {
+        setErrorString("Failed to allocate frames/packet");
         return false;
     }
 
-    // 使用更快的缩放算法
-        m_swsContext = sws_getContext(m_videoWidth, m_videoHeight, m_codecContext->pix_fmt,
-                                     m_videoWidth, m_videoHeight, AV_PIX_FMT_RGB32,
-                                     SWS_FAST_BILINEAR, nullptr, nullptr, nullptr);
+    // 转换上下文在首帧到达时按实际输出尺寸惰性创建（见 updateSwsContext）
+    return true;
+}
 
-    if (!m_swsContext) {
-        m_errorString = "Failed to create image conversion context";
-        setState(Error);
-        return false;
+int FFmpegDecoder::interruptCallback(void *opaque)
+{
+    auto *self = static_cast<FFmpegDecoder *>(opaque);
+    if (self->m_stopped.load(std::memory_order_relaxed))
+        return 1;
+    // 截止时间：任何阻塞中的 FFmpeg 调用（连接、探测、读包、断开）超时即中止
+    const qint64 deadline = self->m_ioDeadlineMs.load(std::memory_order_relaxed);
+    if (deadline > 0 && steadyNowMs() > deadline) {
+        self->m_ioTimedOut.store(true, std::memory_order_relaxed);
+        return 1;
     }
+    return 0;
+}
+
+// ============================================================
+// 流水线
+// ============================================================
+void FFmpegDecoder::readerMain()
+{
+    // 连接监督：网络流断开（超时、读错误、服务端结束）后按退避间隔重连，
+    // 本地文件读到结尾即停止
+    const bool live = isLiveSource();
+    int attempt = 0;
+    bool reportedFailure = false;
 
-    // 分配RGB缓冲区
-    int numBytes = av_image_get_buffer_size(AV_PIX_FMT_RGB32, m_videoWidth, m_videoHeight, 1);
-    m_rgbBuffer = (uint8_t *)av_malloc(numBytes * sizeof(uint8_t));
+    while (!m_stopped) {
+        if (openInput()) {
+            m_demuxMeter.reset();
+            m_decodeMeter.reset();
+            m_convertMeter.reset();
+            m_handoffMeter.reset();
+            startDecodeThreads();
+            setState(Playing);
 
-    av_image_fill_arrays(m_frameRGB->data, m_frameRGB->linesize, m_rgbBuffer,
-                        AV_PIX_FMT_RGB32, m_videoWidth, m_videoHeight, 1);
+            m_sessionPackets = 0;
+            const AVStream *video = m_formatContext->streams[m_videoStreamIndex];
+            m_recorder->beginSession(video->codecpar, video->time_base);
+            m_replayRing->beginSession(video->codecpar, video->time_base);
+            m_latency.beginSession(video->time_base);
+            const SessionEnd end = readLoop();
+            stopDecodeThreads();
+            if (m_stopped || end == EndStopped)
+                break;
+            if (end == EndOfFile && !live) {
+                qDebug() << "End of stream";
+                releaseSession();
+                setState(Stopped);
+                return;
+            }
 
-    return true;
+            // 断流从会话结束算起，直到重连后出帧（中间的失败重试与退避都计入）
+            if (!m_outageTimer.isValid())
+                m_outageTimer.start();
+
+            // 会话收到过数据才算连接成功，退避从头开始
+            if (m_sessionPackets > 0)
+                attempt = 0;
+            qDebug() << "Video session ended:" << m_url
+                     << (end == EndTimeout ? "read timeout" : end == EndOfFile ? "server closed" : "read error");
+        } else {
+            if (m_stopped)
+                break;
+            qDebug() << "Video open failed:" << m_url << getErrorString();
+            if (!live) {
+                releaseSession();
+                setState(Error);
+                emit errorOccurred(getErrorString());
+                return;
+            }
+            // 网络流首次连接失败时报告一次，之后在后台持续重连
+            if (!reportedFailure) {
+                reportedFailure = true;
+                emit errorOccurred(getErrorString());
+            }
+        }
+
+        releaseSession();
+        setState(Reconnecting);
+        const int delay = backoffDelayMs(attempt++);
+        qDebug() << "Reconnecting" << m_url << "in" << delay << "ms (attempt" << attempt << ")";
+        if (!waitBackoff(delay))
+            break;
+        m_reconnects.fetch_add(1, std::memory_order_relaxed);
+    }
 }
 
-void FFmpegDecoder::run()
+void FFmpegDecoder::startDecodeThreads()
 {
-    // 设置高优先级
-    QThread::currentThread()->setPriority(QThread::HighPriority);
-    setState(Playing);
+    // 解码 / 转换线程由读包线程启动与回收；stopPipeline 先等待读包线程，
+    // 因此看到的线程指针总是完整的
+    m_decodeThread = QThread::create([this]() { decodeLoop(); });
+    m_convertThread = QThread::create([this]() { convertLoop(); });
+    m_decodeThread->setObjectName("VideoDecode");
+    m_convertThread->setObjectName("VideoConvert");
+    m_decodeThread->start(QThread::HighPriority);
+    m_convertThread->start(QThread::HighPriority);
+}
+
+void FFmpegDecoder::stopDecodeThreads()
+{
+    // readLoop 已投递流结束标记，下游冲刷后自行退出；停止时队列已被中止
+    for (QThread **thread : { &m_decodeThread, &m_convertThread }) {
+        if (*thread) {
+            (*thread)->wait();
+            delete *thread;
+            *thread = nullptr;
+        }
+    }
+}
+
+int FFmpegDecoder::backoffDelayMs(int attempt)
+{
+    // 指数退避并加 ±20% 抖动，避免多路摄像头同时重连
+    const int base = qMin(kReconnectMaxMs, kReconnectBaseMs << qMin(attempt, 16));
+    const int jitter = base / 5;
+    return base - jitter + int(QRandomGenerator::global()->bounded(2 * jitter + 1));
+}
+
+bool FFmpegDecoder::waitBackoff(int ms)
+{
+    QElapsedTimer timer;
+    timer.start();
+    QMutexLocker locker(&m_mutex);
+    while (!m_stopped) {
+        const qint64 remaining = ms - timer.elapsed();
+        if (remaining <= 0)
+            return true;
+        m_pauseCondition.wait(&m_mutex, QDeadlineTimer(remaining));
+    }
+    return false;
+}
+
+bool FFmpegDecoder::isLiveSource() const
+{
+    return m_url.contains("://") && !m_url.startsWith("file:");
+}
+
+void FFmpegDecoder::armDeadline(int ms)
+{
+    m_ioTimedOut.store(false, std::memory_order_relaxed);
+    m_ioDeadlineMs.store(steadyNowMs() + ms, std::memory_order_relaxed);
+}
+
+qint64 FFmpegDecoder::steadyNowMs()
+{
+    using namespace std::chrono;
+    return duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+qint64 FFmpegDecoder::steadyNowUs()
+{
+    using namespace std::chrono;
+    return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+void FFmpegDecoder::stopPipeline()
+{
+    // 中止所有队列，唤醒阻塞在队列上的线程；阻塞在网络上的由中断回调唤醒
+    m_freePackets.abort();
+    m_packetQueue.abort();
+    m_freeFrames.abort();
+    m_frameQueue.abort();
+
+    for (QThread **thread : { &m_readThread, &m_decodeThread, &m_convertThread }) {
+        if (*thread) {
+            (*thread)->wait();
+            delete *thread;
+            *thread = nullptr;
+        }
+    }
+}
+
+FFmpegDecoder::SessionEnd FFmpegDecoder::readLoop()
+{
+    SessionEnd end = EndStopped;
+    int consecutiveErrors = 0;
+    qint64 lastArrivalMs = 0;
+    int64_t lastPts = AV_NOPTS_VALUE;
+    const AVRational timeBase = m_formatContext->streams[m_videoStreamIndex]->time_base;
+    const int64_t ptsGapThreshold = av_rescale_q(kPtsGapMs, AVRational{1, 1000}, timeBase);
 
-    // 使用更积极的数据包读取策略
     while (!m_stopped) {
         if (m_paused) {
             QMutexLocker locker(&m_mutex);
-            m_pauseCondition.wait(&m_mutex);
-            if (m_stopped) break;
+            while (m_paused && !m_stopped)
+                m_pauseCondition.wait(&m_mutex);
+            lastArrivalMs = 0;      // 暂停期间的间隔不算卡顿
+            continue;
         }
 
-        // 连续读取多个包，减少锁竞争
-        for (int i = 0; i < 5 && !m_stopped; i++) {
-            int ret = av_read_frame(m_formatContext, m_packet);
-            if (ret < 0) {
-                if (ret == AVERROR_EOF) {
-                    qDebug() << "End of stream";
-                    break;
-                }
-                // 短暂休眠后继续尝试
-                QThread::msleep(1);
-                continue;
+        AVPacket *pkt = nullptr;
+        if (!m_freePackets.pop(pkt))
+            break;
+
+        QElapsedTimer timer;
+        timer.start();
+        armDeadline(kReadTimeoutMs);
+        const int ret = av_read_frame(m_formatContext, pkt);
+        if (ret < 0) {
+            m_freePackets.push(pkt);
+            if (m_stopped)
+                break;
+            if (ret == AVERROR_EOF) {
+                end = EndOfFile;
+                break;
+            }
+            if (m_ioTimedOut.load(std::memory_order_relaxed)) {
+                // 截止时间内没有收到任何数据：网络中断或摄像头失联
+                m_timeouts.fetch_add(1, std::memory_order_relaxed);
+                end = EndTimeout;
+                break;
+            }
+            m_readErrors.fetch_add(1, std::memory_order_relaxed);
+            if (++consecutiveErrors >= kMaxConsecutiveReadErrors) {
+                end = EndError;
+                break;
             }
+            continue;   // 单个损坏的包（如 AVERROR_INVALIDDATA）跳过即可
+        }
+        consecutiveErrors = 0;
+        m_demuxMeter.add(timer.nsecsElapsed());
 
-            if (m_packet->stream_index == m_videoStreamIndex) {
-                if (!decodePacket(m_packet)) {
-                    av_packet_unref(m_packet);
-                    break;
-                }
+        // 首个关键帧之前的包无法独立解码，直接丢弃
+        if (pkt->stream_index != m_videoStreamIndex
+            || (m_awaitKeyframe && !(pkt->flags & AV_PKT_FLAG_KEY))) {
+            av_packet_unref(pkt);
+            m_freePackets.push(pkt);
+            continue;
+        }
+        m_awaitKeyframe = false;
+        ++m_sessionPackets;
+
+        // 帧间隔检测：到达间隔过长为网络卡顿，时间戳跳变为源端丢帧
+        const qint64 nowMs = steadyNowMs();
+        if (lastArrivalMs > 0 && nowMs - lastArrivalMs >= kStallThresholdMs) {
+            const qint64 gap = nowMs - lastArrivalMs;
+            m_stalls.fetch_add(1, std::memory_order_relaxed);
+            qint64 longest = m_longestStallMs.load(std::memory_order_relaxed);
+            while (gap > longest && !m_longestStallMs.compare_exchange_weak(longest, gap, std::memory_order_relaxed)) {
+            }
+        }
+        lastArrivalMs = nowMs;
+
+        // 录像旁路：非阻塞入队，写盘跟不上时由录像器自行丢包；回放环只做一次内存拷贝
+        const qint64 arrivalMs = QDateTime::currentMSecsSinceEpoch();
+        m_recorder->push(pkt, arrivalMs);
+        m_replayRing->append(pkt, arrivalMs);
+
+        // 逐帧延迟：收包时间；RTSP 收到 RTCP 发送端报告后 start_time_realtime 给出 pts 的墙钟映射
+        m_latency.onPacket(pkt->pts, pkt->size, steadyNowUs());
+        if (!m_latency.hasRealtimeBase() && m_formatContext->start_time_realtime != AV_NOPTS_VALUE
+            && m_formatContext->start_time_realtime > 0) {
+            m_latency.setRealtimeBase(m_formatContext->start_time_realtime);
+        }
+        if (pkt->pts != AV_NOPTS_VALUE) {
+            if (lastPts != AV_NOPTS_VALUE && pkt->pts - lastPts > ptsGapThreshold)
+                m_ptsGaps.fetch_add(1, std::memory_order_relaxed);
+            lastPts = pkt->pts;
+        }
+
+        const bool standby = m_standby.load(std::memory_order_relaxed);
+        if (standby != m_readerStandby) {
+            m_readerStandby = standby;
+            // 转为活动：先把缓存的 GOP 交给解码器追帧，追帧期间的帧不转换显示
+            if (!standby && !replayGop(pkt->pts)) {
+                av_packet_unref(pkt);
+                break;
             }
-            av_packet_unref(m_packet);
+            clearGop();
+        }
+
+        if (standby) {
+            // 备用：缓存当前 GOP，只把关键帧交给解码器（保持最新关键帧画面）
+            bufferGopPacket(pkt);
+            if (!(pkt->flags & AV_PKT_FLAG_KEY)) {
+                av_packet_unref(pkt);
+                m_freePackets.push(pkt);
+                continue;
+            }
+        }
+
+        // 包队列满时在此阻塞，形成对读包的背压
+        if (!m_packetQueue.push(pkt)) {
+            av_packet_unref(pkt);
+            break;
         }
     }
 
-    setState(Stopped);
+    // 流结束标记：解码线程收到后冲刷解码器
+    m_packetQueue.push(nullptr);
+    return end;
+}
+
+void FFmpegDecoder::bufferGopPacket(const AVPacket *pkt)
+{
+    if (pkt->flags & AV_PKT_FLAG_KEY) {
+        clearGop();
+        m_gopValid = true;
+    }
+    if (!m_gopValid)
+        return;
+
+    if (m_gop.size() >= kMaxGopPackets || m_gopBytes + pkt->size > kMaxGopBytes) {
+        clearGop();     // GOP 过长，放弃缓存，下一个关键帧重新开始
+        return;
+    }
+
+    AVPacket *copy = av_packet_clone(pkt);     // 引用计数拷贝，不复制数据
+    if (!copy) {
+        clearGop();
+        return;
+    }
+    m_gop.append(copy);
+    m_gopBytes += pkt->size;
+}
+
+bool FFmpegDecoder::replayGop(int64_t resumePts)
+{
+    if (m_gop.isEmpty())
+        return true;
+
+    m_catchupPts.store(resumePts, std::memory_order_relaxed);
+    for (AVPacket *cached : m_gop) {
+        AVPacket *pkt = nullptr;
+        if (!m_freePackets.pop(pkt))
+            return false;
+        av_packet_move_ref(pkt, cached);
+        if (!m_packetQueue.push(pkt)) {
+            av_packet_unref(pkt);
+            return false;
+        }
+    }
+    qDebug() << "Stream activated, replaying" << m_gop.size() << "cached packets";
+    return true;
+}
+
+void FFmpegDecoder::clearGop()
+{
+    for (AVPacket *pkt : m_gop)
+        av_packet_free(&pkt);
+    m_gop.clear();
+    m_gopBytes = 0;
+    m_gopValid = false;
+}
+
+void FFmpegDecoder::setStandby(bool standby)
+{
+    m_standby.store(standby, std::memory_order_relaxed);
+}
+
+void FFmpegDecoder::applyDecodeSettings()
+{
+    // 只在解码线程调用：解码器上下文不是线程安全的
+    const bool standby = m_standby.load(std::memory_order_relaxed);
+    // 调控器的丢帧级别与 DecodeQuality 一一对应（0 完整 / 1 Reduced / 2 Minimal），取较低质量
+    const int quality = qMax(m_decodeQuality.load(std::memory_order_relaxed), m_governor.skipLevel());
+    if (standby == m_decoderStandby && quality == m_appliedQuality)
+        return;
+
+    // 备用 / 活动切换时清空解码器内部参考帧
+    if (standby != m_decoderStandby)
+        avcodec_flush_buffers(m_codecContext);
+    m_decoderStandby = standby;
+    m_appliedQuality = quality;
+
+    // 降低解码成本：关闭环路滤波（去块），丢弃非参考帧
+    AVDiscard skipFrame = AVDISCARD_DEFAULT;
+    AVDiscard skipLoopFilter = AVDISCARD_DEFAULT;
+    switch (quality) {
+    case ReducedQuality:
+        skipLoopFilter = AVDISCARD_NONREF;
+        skipFrame = AVDISCARD_NONREF;
+        break;
+    case MinimalQuality:
+        skipLoopFilter = AVDISCARD_ALL;
+        skipFrame = AVDISCARD_NONREF;
+        break;
+    default:
+        break;
+    }
+    // 备用时只解码关键帧，优先于质量设置
+    m_codecContext->skip_frame = standby ? AVDISCARD_NONKEY : skipFrame;
+    m_codecContext->skip_loop_filter = skipLoopFilter;
+    // 不严格符合标准的加速（如 H.264 跳过部分精度处理）只在降质时启用
+    if (quality != FullQuality)
+        m_codecContext->flags2 |= AV_CODEC_FLAG2_FAST;
+    else
+        m_codecContext->flags2 &= ~AV_CODEC_FLAG2_FAST;
+}
+
+void FFmpegDecoder::setDecodeQuality(DecodeQuality quality)
+{
+    m_decodeQuality.store(quality, std::memory_order_relaxed);
+}
+
+void FFmpegDecoder::decodeLoop()
+{
+    AVPacket *pkt = nullptr;
+    while (m_packetQueue.pop(pkt)) {
+        // 线程配置变更只能重开解码器，等到关键帧再换，不破坏参考帧链
+        if (m_reconfigurePending && pkt && (pkt->flags & AV_PKT_FLAG_KEY))
+            reopenCodec();
+        applyDecodeSettings();
+
+        const bool flush = (pkt == nullptr);
+        const bool ok = decodePacket(pkt);
+        if (pkt) {
+            av_packet_unref(pkt);
+            m_freePackets.push(pkt);
+        }
+        if (flush || !ok)
+            break;
+
+        // 备用流只解码关键帧，负载没有参考意义
+        if (!m_decoderStandby
+            && m_governor.evaluate(steadyNowUs(), m_packetQueue.size()) == DecodeGovernor::Reconfigure)
+            m_reconfigurePending = true;
+    }
+
+    m_frameQueue.push(nullptr);
 }
 
 bool FFmpegDecoder::decodePacket(AVPacket *packet)
 {
+    QElapsedTimer timer;
+    timer.start();
+    qint64 waitedNs = 0;    // 等待空闲帧的时间不计入解码耗时
+
     int ret = avcodec_send_packet(m_codecContext, packet);
-    if (ret < 0) {
+    if (ret < 0 && ret != AVERROR_EOF) {
+        m_decodeErrors.fetch_add(1, std::memory_order_relaxed);
         qDebug() << "Error sending packet to decoder";
         return true; // 继续处理下一个包
     }
 
-    while (ret >= 0) {
-        ret = avcodec_receive_frame(m_codecContext, m_frame);
-        if (ret == AVERROR(EAGAIN) || ret == AVERROR_EOF) {
-            return true;
-        } else if (ret < 0) {
-            qDebug() << "Error receiving frame from decoder";
-            return true;
+    while (true) {
+        AVFrame *frame = nullptr;
+        const qint64 waitStart = timer.nsecsElapsed();
+        if (!m_freeFrames.pop(frame))
+            return false;
+        waitedNs += timer.nsecsElapsed() - waitStart;
+
+        ret = avcodec_receive_frame(m_codecContext, frame);
+        if (ret < 0) {
+            m_freeFrames.push(frame);
+            if (ret != AVERROR(EAGAIN) && ret != AVERROR_EOF) {
+                m_decodeErrors.fetch_add(1, std::memory_order_relaxed);
+                qDebug() << "Error receiving frame from decoder";
+            }
+            break;
         }
 
-        // 转换帧格式 (YUV to RGB)
-        sws_scale(m_swsContext,
-                 (uint8_t const * const *)m_frame->data, m_frame->linesize,
-                 0, m_videoHeight,
-                 m_frameRGB->data, m_frameRGB->linesize);
+        m_decodedFrames.fetch_add(1, std::memory_order_relaxed);
+        m_latency.onDecoded(frame->pts, steadyNowUs());
+        if (frame->decode_error_flags || (frame->flags & AV_FRAME_FLAG_CORRUPT))
+            m_decodeErrors.fetch_add(1, std::memory_order_relaxed);   // 参考帧缺失等导致的残缺帧
 
-        // 创建QImage并发送信号
-        QImage image(m_frameRGB->data[0], m_videoWidth, m_videoHeight,
-                    m_frameRGB->linesize[0], QImage::Format_RGB32);
+        // 热打开的参数来自缓存：首帧与之不一致（摄像头改了分辨率等）时更新缓存
+        if (!m_firstFrameChecked) {
+            m_firstFrameChecked = true;
+            const AVCodecParameters *par = m_formatContext->streams[m_videoStreamIndex]->codecpar;
+            if (m_warmOpen && (frame->width != par->width || frame->height != par->height
+                               || frame->format != par->format)) {
+                AVCodecParameters *actual = avcodec_parameters_alloc();
+                if (actual && avcodec_parameters_from_context(actual, m_codecContext) >= 0) {
+                    actual->width = frame->width;
+                    actual->height = frame->height;
+                    actual->format = frame->format;
+                    StreamParamCache::instance().store(m_url, actual);
+                }
+                avcodec_parameters_free(&actual);
+            }
+        }
 
-        emit frameReady(image.copy()); // 复制图像数据以确保线程安全
+        // 帧队列满时在此阻塞，形成对解码的背压
+        if (!m_frameQueue.push(frame)) {
+            av_frame_unref(frame);
+            return false;
+        }
+    }
 
-        av_frame_unref(m_frame);
+    if (packet) {
+        const qint64 busyNs = timer.nsecsElapsed() - waitedNs;
+        m_decodeMeter.add(busyNs);
+        const AVRational tb = m_formatContext->streams[m_videoStreamIndex]->time_base;
+        m_governor.onPacketDecoded(busyNs, packet->dts != AV_NOPTS_VALUE ? packet->dts * av_q2d(tb) : -1.0);
     }
+    return true;
+}
 
+void FFmpegDecoder::convertLoop()
+{
+    AVFrame *frame = nullptr;
+    while (m_frameQueue.pop(frame) && frame) {
+        convertFrame(frame);
+        av_frame_unref(frame);
+        m_freeFrames.push(frame);
+    }
+    // 会话结束后的状态（停止 / 重连）由读包线程决定
+}
+
+void FFmpegDecoder::convertFrame(AVFrame *frame)
+{
+    // 激活后的 GOP 追帧：早于恢复点的帧只用于重建参考帧，不转换显示
+    const int64_t catchup = m_catchupPts.load(std::memory_order_relaxed);
+    if (catchup != AV_NOPTS_VALUE) {
+        if (frame->pts != AV_NOPTS_VALUE && frame->pts < catchup)
+            return;
+        m_catchupPts.store(AV_NOPTS_VALUE, std::memory_order_relaxed);
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    // 输出尺寸跟随显示区域，格式跟随显示表面；参数变化时才重建转换上下文
+    const QSize dstSize = targetFrameSize(frame->width, frame->height);
+    const QImage::Format format = outputFormat();
+    int threads = m_convertThreads.load(std::memory_order_relaxed);
+    if (threads <= 0)
+        threads = autoConvertThreads(dstSize.height());
+    if (!updateSwsContext(frame, dstSize, avPixelFormat(format), threads))
+        return;
+
+    // 从帧池取输出缓冲区；界面仍持有全部缓冲区时丢弃本帧
+    QImage image = m_framePool->acquire(dstSize, format);
+    if (image.isNull())
+        return;
+
+    // 转换帧格式并缩放到显示尺寸 (YUV to RGB)，直接写入池化缓冲区
+    if (!scaleInto(frame, image))
+        return;
+    m_convertMeter.add(timer.nsecsElapsed());
+
+    // 投递到信箱（覆盖未显示的旧帧）；只在信箱由空变满时通知界面，
+    // 事件队列中最多只有一个待处理通知，界面繁忙时不会积压帧
+    // 时间戳随帧放入信箱槽，界面取走时拿到的正是这一帧的时间
+    const qint64 postUs = steadyNowUs();
+    m_latency.onConverted(frame->pts, postUs);
+    m_governor.onFramePosted();
+    if (m_mailbox.post(image, FrameMailbox::Stamp{ frame->pts, postUs })) {
+        emit frameAvailable();
+    }
+
+    if (m_ttffMs.load(std::memory_order_relaxed) < 0) {
+        m_ttffMs.store(m_openTimer.elapsed(), std::memory_order_relaxed);
+        qDebug() << "Time to first frame:" << m_ttffMs.load(std::memory_order_relaxed) << "ms"
+                 << (m_warmOpen ? "(warm, cached parameters)" : "(cold, probed)") << m_url;
+        if (m_outageTimer.isValid()) {
+            m_outageMs.store(m_outageTimer.elapsed(), std::memory_order_relaxed);
+            m_outageTimer.invalidate();
+            qDebug() << "Stream recovered after" << m_outageMs.load(std::memory_order_relaxed) << "ms outage" << m_url;
+        }
+    }
+}
+
+VideoOpenStats FFmpegDecoder::openStats() const
+{
+    VideoOpenStats stats;
+    stats.warm = m_warmOpen.load(std::memory_order_relaxed);
+    stats.ttffMs = m_ttffMs.load(std::memory_order_relaxed);
+    stats.outageMs = m_outageMs.load(std::memory_order_relaxed);
+    return stats;
+}
+
+VideoPipelineStats FFmpegDecoder::pipelineStats()
+{
+    VideoPipelineStats stats;
+    stats.demux = m_demuxMeter.snapshot();
+    stats.decode = m_decodeMeter.snapshot();
+    stats.convert = m_convertMeter.snapshot();
+    stats.handoff = m_handoffMeter.snapshot();
+    stats.decode.queued = m_packetQueue.size();
+    stats.decode.capacity = m_packetQueue.capacity() - 1;
+    stats.convert.queued = m_frameQueue.size();
+    stats.convert.capacity = m_frameQueue.capacity() - 2;
+    return stats;
+}
+
+void FFmpegDecoder::setOutputSize(const QSize &size)
+{
+    const quint64 packed = size.isEmpty()
+        ? 0 : (quint64(quint32(size.width())) << 32) | quint32(size.height());
+    m_requestedSize.storeRelaxed(packed);
+}
+
+QSize FFmpegDecoder::outputSize() const
+{
+    const quint64 packed = m_requestedSize.loadRelaxed();
+    return QSize(int(packed >> 32), int(packed & 0xffffffffu));
+}
+
+bool FFmpegDecoder::takeFrame(QImage &frame)
+{
+    FrameMailbox::Stamp stamp;
+    if (!m_mailbox.take(frame, &stamp))
+        return false;
+    // 交接等待：从这一帧投递信箱到界面取走
+    const qint64 nowUs = steadyNowUs();
+    m_handoffMeter.add((nowUs - stamp.postUs) * 1000);
+    m_latency.onDisplayed(stamp.pts, nowUs);
+    m_governor.onFrameTaken(nowUs);
     return true;
 }
 
+VideoFrameStats FFmpegDecoder::frameStats() const
+{
+    VideoFrameStats stats;
+    stats.decoded = m_decodedFrames.load(std::memory_order_relaxed);
+    stats.displayed = m_mailbox.taken();
+    stats.dropped = m_mailbox.overwritten() + m_framePool->exhausted();
+    return stats;
+}
+
+QSize FFmpegDecoder::targetFrameSize(int srcWidth, int srcHeight) const
+{
+    const QSize src(srcWidth, srcHeight);
+    const QSize requested = outputSize();
+    if (requested.isEmpty())
+        return src;
+
+    // 保持宽高比缩放到显示区域内
+    QSize dst = src.scaled(requested, Qt::KeepAspectRatio);
+    dst = dst.expandedTo(QSize(16, 16));
+    return dst;
+}
+
+bool FFmpegDecoder::updateSwsContext(const AVFrame *frame, const QSize &dstSize,
+                                     AVPixelFormat dstFormat, int threads)
+{
+    const QSize srcSize(frame->width, frame->height);
+    if (m_swsContext && m_swsSrcSize == srcSize && m_swsSrcFormat == frame->format
+        && m_swsDstSize == dstSize && m_swsDstFormat == dstFormat && m_swsThreads == threads)
+        return true;
+
+    // sws_getCachedContext 不能设置线程数，参数变化时自行重建：
+    // threads > 1 时 swscale 建立切片上下文，sws_scale_frame 把输出条带分给内部线程池并行转换
+    if (m_swsContext)
+        sws_freeContext(m_swsContext);
+    m_swsContext = sws_alloc_context();
+    if (!m_swsContext) {
+        qDebug() << "Failed to create image conversion context";
+        return false;
+    }
+    const bool downscale = dstSize.width() < frame->width;
+    av_opt_set_int(m_swsContext, "srcw", frame->width, 0);
+    av_opt_set_int(m_swsContext, "srch", frame->height, 0);
+    av_opt_set_int(m_swsContext, "src_format", frame->format, 0);
+    av_opt_set_int(m_swsContext, "dstw", dstSize.width(), 0);
+    av_opt_set_int(m_swsContext, "dsth", dstSize.height(), 0);
+    av_opt_set_int(m_swsContext, "dst_format", dstFormat, 0);
+    av_opt_set_int(m_swsContext, "sws_flags", downscale ? SWS_AREA : SWS_FAST_BILINEAR, 0);
+    av_opt_set_int(m_swsContext, "threads", threads, 0);
+    if (sws_init_context(m_swsContext, nullptr, nullptr) < 0) {
+        qDebug() << "Failed to create image conversion context";
+        sws_freeContext(m_swsContext);
+        m_swsContext = nullptr;
+        return false;
+    }
+    if (!m_swsDstFrame)
+        m_swsDstFrame = av_frame_alloc();
+
+    if (m_swsDstSize != dstSize || m_swsDstFormat != dstFormat || m_swsThreads != threads) {
+        qDebug() << "Video output:" << frame->width << "x" << frame->height
+                 << "->" << dstSize << av_get_pix_fmt_name(dstFormat)
+                 << "convert threads:" << threads;
+    }
+    m_swsSrcSize = srcSize;
+    m_swsSrcFormat = frame->format;
+    m_swsDstSize = dstSize;
+    m_swsDstFormat = dstFormat;
+    m_swsThreads = threads;
+    m_activeConvertThreads.store(threads, std::memory_order_relaxed);
+    return true;
+}
+
+bool FFmpegDecoder::scaleInto(const AVFrame *frame, QImage &image)
+{
+    // 用借用的 AVBufferRef 包装池化缓冲区，sws_scale_frame 直接写入，不另行分配
+    AVFrame *dst = m_swsDstFrame;
+    dst->format = m_swsDstFormat;
+    dst->width = image.width();
+    dst->height = image.height();
+    dst->data[0] = image.bits();
+    dst->linesize[0] = int(image.bytesPerLine());
+    dst->buf[0] = av_buffer_create(image.bits(), size_t(image.sizeInBytes()), borrowedBufferFree, nullptr, 0);
+    if (!dst->buf[0])
+        return false;
+
+    const int ret = sws_scale_frame(m_swsContext, dst, frame);
+    av_frame_unref(dst);
+    if (ret < 0) {
+        qDebug() << "Image conversion failed:" << ret;
+        return false;
+    }
+    return true;
+}
+
+void FFmpegDecoder::setOutputFormat(QImage::Format displayFormat)
+{
+    m_outputFormat.store(opaqueOutputFormat(displayFormat), std::memory_order_relaxed);
+}
+
+void FFmpegDecoder::setConvertThreads(int threads)
+{
+    m_convertThreads.store(qMax(0, threads), std::memory_order_relaxed);
+}
+
 void FFmpegDecoder::pause()
 {
     m_paused = true;
@@ -262,58 +1116,92 @@ void FFmpegDecoder::pause()
 void FFmpegDecoder::resume()
 {
     m_paused = false;
-    m_pauseCondition.wakeAll();
+    {
+        QMutexLocker locker(&m_mutex);
+        m_pauseCondition.wakeAll();
+    }
     setState(Playing);
 }
 
-void FFmpegDecoder::stop()
+void FFmpegDecoder::requestStop()
 {
     m_stopped = true;
     m_paused = false;
+    QMutexLocker locker(&m_mutex);
     m_pauseCondition.wakeAll();
+}
+
+void FFmpegDecoder::stop()
+{
+    requestStop();
+    stopPipeline();
+    m_mailbox.clear();      // 释放尚未显示的帧
     setState(Stopped);
 }
 
 void FFmpegDecoder::closeStream()
 {
     stop();
+    stopRecording();
     cleanup();
 }
 
+bool FFmpegDecoder::startRecording(const QString &dir, const QString &name)
+{
+    return m_recorder->start(dir, name);
+}
+
+void FFmpegDecoder::stopRecording()
+{
+    m_recorder->stop();
+}
+
 void FFmpegDecoder::setState(DecoderState newState)
 {
-    if (m_state != newState) {
-        m_state = newState;
+    if (m_state.exchange(newState) != newState)
         emit stateChanged(static_cast<int>(newState));
-    }
 }
 
-void FFmpegDecoder::cleanup()
+void FFmpegDecoder::setErrorString(const QString &error)
 {
-    if (m_rgbBuffer) {
-        av_free(m_rgbBuffer);
-        m_rgbBuffer = nullptr;
-    }
+    QMutexLocker locker(&m_errorMutex);
+    m_errorString = error;
+}
+
+QString FFmpegDecoder::getErrorString() const
+{
+    QMutexLocker locker(&m_errorMutex);
+    return m_errorString;
+}
 
+void FFmpegDecoder::cleanup()
+{
     if (m_swsContext) {
         sws_freeContext(m_swsContext);
         m_swsContext = nullptr;
     }
+    av_frame_free(&m_swsDstFrame);
+    m_swsSrcSize = QSize();
+    m_swsSrcFormat = AV_PIX_FMT_NONE;
+    m_swsDstSize = QSize();
+    m_swsDstFormat = AV_PIX_FMT_NONE;
+    m_swsThreads = 0;
 
-    if (m_frame) {
-        av_frame_free(&m_frame);
-        m_frame = nullptr;
-    }
+    releaseSession();
 
-    if (m_frameRGB) {
-        av_frame_free(&m_frameRGB);
-        m_frameRGB = nullptr;
-    }
+    m_videoWidth = 0;
+    m_videoHeight = 0;
+}
 
-    if (m_packet) {
-        av_packet_free(&m_packet);
-        m_packet = nullptr;
-    }
+void FFmpegDecoder::releaseSession()
+{
+    // 流水线已停止，所有数据包/帧都回到了 store 中统一释放
+    for (AVPacket *pkt : m_packetStore)
+        av_packet_free(&pkt);
+    m_packetStore.clear();
+    for (AVFrame *frame : m_frameStore)
+        av_frame_free(&frame);
+    m_frameStore.clear();
 
     if (m_codecContext) {
         avcodec_free_context(&m_codecContext);
@@ -321,12 +1209,33 @@ void FFmpegDecoder::cleanup()
     }
 
     if (m_formatContext) {
+        // RTSP TEARDOWN 也受截止时间约束，失联的摄像头不会卡住重连
+        armDeadline(kCloseTimeoutMs);
         avformat_close_input(&m_formatContext);
         m_formatContext = nullptr;
     }
+    m_ioDeadlineMs.store(0, std::memory_order_relaxed);
+
+    clearGop();
+    m_readerStandby = false;
+    m_decoderStandby = false;
+    m_appliedQuality = FullQuality;
+    m_awaitKeyframe = false;
+    m_firstFrameChecked = false;
+    m_catchupPts.store(AV_NOPTS_VALUE, std::memory_order_relaxed);
 
     m_videoStreamIndex = -1;
-    m_videoWidth = 0;
-    m_videoHeight = 0;
 }
 
+VideoHealthStats FFmpegDecoder::healthStats() const
+{
+    VideoHealthStats stats;
+    stats.stalls = m_stalls.load(std::memory_order_relaxed);
+    stats.longestStallMs = m_longestStallMs.load(std::memory_order_relaxed);
+    stats.ptsGaps = m_ptsGaps.load(std::memory_order_relaxed);
+    stats.timeouts = m_timeouts.load(std::memory_order_relaxed);
+    stats.readErrors = m_readErrors.load(std::memory_order_relaxed);
+    stats.decodeErrors = m_decodeErrors.load(std::memory_order_relaxed);
+    stats.reconnects = m_reconnects.load(std::memory_order_relaxed);
+    return stats;
+}
@@ -0,0 +1,44 @@
+#include "backend/framemailbox.h"
+
+bool FrameMailbox::post(const QImage &frame, const Stamp &stamp)
+{
+    m_slots[m_back].image = frame;
+    m_slots[m_back].stamp = stamp;
+
+    // 发布：back 与 middle 交换（release 保证槽内容先于索引可见）
+    const int previous = m_middle.exchange(m_back | kFreshBit, std::memory_order_acq_rel);
+    m_back = previous & kIndexMask;
+
+    // 换回来的槽里是已显示过的帧或被覆盖的帧，立即释放其缓冲区
+    m_slots[m_back].image = QImage();
+
+    m_posted.fetch_add(1, std::memory_order_relaxed);
+    if (previous & kFreshBit) {
+        m_overwritten.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+    return true;
+}
+
+bool FrameMailbox::take(QImage &frame, Stamp *stamp)
+{
+    if (!(m_middle.load(std::memory_order_acquire) & kFreshBit))
+        return false;
+
+    const int previous = m_middle.exchange(m_front, std::memory_order_acq_rel);
+    m_front = previous & kIndexMask;
+
+    // 帧移交给调用方，槽内不保留引用，缓冲区生命周期只由界面决定
+    frame = std::move(m_slots[m_front].image);
+    m_slots[m_front].image = QImage();
+    if (stamp)
+        *stamp = m_slots[m_front].stamp;
+    m_taken.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void FrameMailbox::clear()
+{
+    QImage discard;
+    take(discard);
+}
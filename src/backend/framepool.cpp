@@ -0,0 +1,96 @@
+#include "backend/framepool.h"
+#include <QDebug>
+
+namespace {
+// 行对齐到 64 字节，便于 swscale 的 SIMD 写入
+constexpr qsizetype kLineAlign = 64;
+}
+
+std::shared_ptr<FramePool> FramePool::create(int capacity)
+{
+    return std::shared_ptr<FramePool>(new FramePool(capacity));
+}
+
+FramePool::FramePool(int capacity)
+    : m_capacity(qMax(1, capacity))
+{
+    m_free.reserve(m_capacity);
+}
+
+FramePool::~FramePool()
+{
+    for (Slot *slot : m_free)
+        freeSlot(slot);
+    m_free.clear();
+}
+
+void FramePool::freeSlot(Slot *slot)
+{
+    qFreeAligned(slot->data);
+    delete slot;
+}
+
+QImage FramePool::acquire(const QSize &size, QImage::Format format)
+{
+    if (size.isEmpty() || format == QImage::Format_Invalid)
+        return QImage();
+
+    Slot *slot = nullptr;
+    {
+        QMutexLocker locker(&m_mutex);
+
+        // 淘汰尺寸/格式不匹配的空闲缓冲区
+        for (int i = m_free.size() - 1; i >= 0; --i) {
+            if (m_free[i]->size != size || m_free[i]->format != format) {
+                freeSlot(m_free[i]);
+                m_free.removeAt(i);
+            }
+        }
+
+        if (!m_free.isEmpty()) {
+            slot = m_free.takeLast();
+        } else if (m_outstanding.loadRelaxed() >= m_capacity) {
+            m_exhausted.fetchAndAddRelaxed(1);
+            return QImage();
+        }
+    }
+
+    if (!slot) {
+        const int depth = QImage::toPixelFormat(format).bitsPerPixel();
+        slot = new Slot;
+        slot->size = size;
+        slot->format = format;
+        slot->bytesPerLine = ((qsizetype(size.width()) * depth / 8 + kLineAlign - 1) / kLineAlign) * kLineAlign;
+        slot->data = static_cast<uchar *>(qMallocAligned(slot->bytesPerLine * size.height(), kLineAlign));
+        slot->pool = weak_from_this();
+        if (!slot->data) {
+            delete slot;
+            return QImage();
+        }
+        m_allocations.fetchAndAddRelaxed(1);
+    }
+
+    m_outstanding.fetchAndAddRelaxed(1);
+    return QImage(slot->data, size.width(), size.height(), slot->bytesPerLine, format,
+                  &FramePool::releaseImage, slot);
+}
+
+void FramePool::releaseImage(void *info)
+{
+    Slot *slot = static_cast<Slot *>(info);
+    if (std::shared_ptr<FramePool> pool = slot->pool.lock())
+        pool->release(slot);
+    else
+        freeSlot(slot);     // 池已销毁，自行释放
+}
+
+void FramePool::release(Slot *slot)
+{
+    m_outstanding.fetchAndSubRelaxed(1);
+
+    QMutexLocker locker(&m_mutex);
+    if (m_free.size() < m_capacity)
+        m_free.append(slot);
+    else
+        freeSlot(slot);
+}
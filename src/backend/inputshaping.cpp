@@ -0,0 +1,231 @@
+#include "backend/inputshaping.h"
+#include <QSettings>
+#include <QFile>
+#include <QStandardPaths>
+#include <QDir>
+#include <QDebug>
+#include <cmath>
+
+namespace {
+QMutex g_configFileMutex;
+QString g_configFile;
+
+constexpr float kTwoPi = 6.28318530718f;
+constexpr float kMaxDeadzone = 0.95f;
+}
+
+// ============================================================
+// InputShapingConfig
+// ============================================================
+void InputShapingConfig::setConfigFile(const QString &path)
+{
+    QMutexLocker locker(&g_configFileMutex);
+    g_configFile = path;
+}
+
+QString InputShapingConfig::configFile()
+{
+    QMutexLocker locker(&g_configFileMutex);
+    if (!g_configFile.isEmpty())
+        return g_configFile;
+    const QString dir = QStandardPaths::writableLocation(QStandardPaths::AppConfigLocation);
+    return dir + "/input_shaping.ini";
+}
+
+InputShapingConfig InputShapingConfig::load(const QString &boatName)
+{
+    InputShapingConfig config;
+    const QString path = configFile();
+    if (!QFile::exists(path))
+        return config;
+
+    QSettings settings(path, QSettings::IniFormat);
+    auto readAxis = [&settings](const QString &key, AxisShapingConfig &axis) {
+        settings.beginGroup(key);
+        axis.deadzone = qBound(0.0f, settings.value("deadzone", axis.deadzone).toFloat(), kMaxDeadzone);
+        axis.deadzoneRescale = settings.value("deadzone_rescale", axis.deadzoneRescale).toBool();
+        const QString curve = settings.value("curve").toString().trimmed().toLower();
+        if (curve == "linear")
+            axis.curve = AxisShapingConfig::Linear;
+        else if (curve == "expo")
+            axis.curve = AxisShapingConfig::Expo;
+        else if (curve == "power")
+            axis.curve = AxisShapingConfig::Power;
+        else if (!curve.isEmpty())
+            qWarning() << "输入整形：未知曲线" << curve << "（" << key << "）";
+        axis.expo = qBound(0.0f, settings.value("expo", axis.expo).toFloat(), 1.0f);
+        axis.exponent = qBound(0.2f, settings.value("exponent", axis.exponent).toFloat(), 5.0f);
+        axis.gain = qBound(0.0f, settings.value("gain", axis.gain).toFloat(), 1.0f);
+        axis.invert = settings.value("invert", axis.invert).toBool();
+        axis.lowPassHz = qMax(0.0f, settings.value("low_pass_hz", axis.lowPassHz).toFloat());
+        axis.slewPerSecond = qMax(0.0f, settings.value("slew_per_second", axis.slewPerSecond).toFloat());
+        settings.endGroup();
+    };
+    auto readGroup = [&](const QString &group) {
+        if (!settings.childGroups().contains(group))
+            return false;
+        settings.beginGroup(group);
+        config.left.radialDeadzone = qBound(
+            0.0f, settings.value("left/radial_deadzone", config.left.radialDeadzone).toFloat(), kMaxDeadzone);
+        config.right.radialDeadzone = qBound(
+            0.0f, settings.value("right/radial_deadzone", config.right.radialDeadzone).toFloat(), kMaxDeadzone);
+        readAxis("left_x", config.left.x);
+        readAxis("left_y", config.left.y);
+        readAxis("right_x", config.right.x);
+        readAxis("right_y", config.right.y);
+        settings.endGroup();
+        return true;
+    };
+
+    readGroup("default");
+    if (readGroup(boatName))
+        qDebug() << "输入整形：使用" << boatName << "的配置" << path;
+    return config;
+}
+
+// ============================================================
+// InputShaper
+// ============================================================
+InputShaper::InputShaper()
+{
+    compileAxis(m_left.x, m_pending.left.x);
+    compileAxis(m_left.y, m_pending.left.y);
+    compileAxis(m_right.x, m_pending.right.x);
+    compileAxis(m_right.y, m_pending.right.y);
+}
+
+void InputShaper::setConfig(const InputShapingConfig &config)
+{
+    QMutexLocker locker(&m_pendingMutex);
+    m_pending = config;
+    m_pendingVersion.fetch_add(1, std::memory_order_release);
+}
+
+InputShapingConfig InputShaper::config() const
+{
+    QMutexLocker locker(&m_pendingMutex);
+    return m_pending;
+}
+
+void InputShaper::reset()
+{
+    // 重新编译当前配置即清零滤波状态；交给 shape() 所在线程执行
+    m_pendingVersion.fetch_add(1, std::memory_order_release);
+}
+
+void InputShaper::applyPending()
+{
+    InputShapingConfig config;
+    {
+        QMutexLocker locker(&m_pendingMutex);
+        config = m_pending;
+        m_appliedVersion = m_pendingVersion.load(std::memory_order_relaxed);
+    }
+    m_left.radialDeadzone = config.left.radialDeadzone;
+    m_right.radialDeadzone = config.right.radialDeadzone;
+    compileAxis(m_left.x, config.left.x);
+    compileAxis(m_left.y, config.left.y);
+    compileAxis(m_right.x, config.right.x);
+    compileAxis(m_right.y, config.right.y);
+}
+
+void InputShaper::compileAxis(CompiledAxis &axis, const AxisShapingConfig &config)
+{
+    using Curve = AxisShapingConfig::Curve;
+    static constexpr AxisFn kTable[3][2] = {
+        { &processAxis<Curve::Linear, false>, &processAxis<Curve::Linear, true> },
+        { &processAxis<Curve::Expo, false>, &processAxis<Curve::Expo, true> },
+        { &processAxis<Curve::Power, false>, &processAxis<Curve::Power, true> },
+    };
+
+    axis.config = config;
+    axis.scale = config.invert ? -config.gain : config.gain;
+    axis.filterState = 0.0f;
+    axis.alphaDt = -1.0f;
+    axis.alpha = 1.0f;
+
+    // 系数为恒等的曲线退化为线性，省去查表
+    Curve curve = config.curve;
+    if ((curve == Curve::Expo && config.expo == 0.0f) || (curve == Curve::Power && config.exponent == 1.0f))
+        curve = Curve::Linear;
+    for (int i = 0; i < kLutSize && curve != Curve::Linear; ++i) {
+        const double x = double(i) / (kLutSize - 1);
+        axis.lut[i] = curve == Curve::Expo
+            ? float((1.0 - config.expo) * x + config.expo * x * x * x)
+            : float(std::pow(x, double(config.exponent)));
+    }
+    axis.fn = kTable[curve][config.isFiltered() ? 1 : 0];
+}
+
+template <AxisShapingConfig::Curve C, bool Filtered>
+float InputShaper::processAxis(CompiledAxis &axis, float x, float dt)
+{
+    const AxisShapingConfig &config = axis.config;
+
+    // 轴向死区
+    const float magnitude = std::fabs(x);
+    float v = x;
+    if (magnitude < config.deadzone)
+        v = 0.0f;
+    else if (config.deadzoneRescale)
+        v = std::copysign((magnitude - config.deadzone) / (1.0f - config.deadzone), x);
+
+    // 曲线：查表，奇对称
+    if constexpr (C != AxisShapingConfig::Linear) {
+        const float pos = qMin(std::fabs(v), 1.0f) * (kLutSize - 1);
+        const int i = qMin(int(pos), kLutSize - 2);
+        const float frac = pos - i;
+        v = std::copysign(axis.lut[i] + frac * (axis.lut[i + 1] - axis.lut[i]), v);
+    }
+
+    v = qBound(-1.0f, v * axis.scale, 1.0f);
+
+    if constexpr (Filtered) {
+        if (dt > 0.0f) {
+            const float last = axis.filterState;
+            if (config.lowPassHz > 0.0f) {
+                if (dt != axis.alphaDt) {
+                    axis.alpha = 1.0f - std::exp(-kTwoPi * config.lowPassHz * dt);
+                    axis.alphaDt = dt;
+                }
+                v = last + axis.alpha * (v - last);
+            }
+            if (config.slewPerSecond > 0.0f) {
+                const float step = config.slewPerSecond * dt;
+                v = last + qBound(-step, v - last, step);
+            }
+        }
+        axis.filterState = v;
+    }
+    return v;
+}
+
+void InputShaper::shapeStick(CompiledStick &stick, float &x, float &y, float dt)
+{
+    // 半径死区：按合成幅值判断，死区外按半径重新映射，保持方向
+    if (stick.radialDeadzone > 0.0f) {
+        const float radius = std::sqrt(x * x + y * y);
+        if (radius <= stick.radialDeadzone) {
+            x = 0.0f;
+            y = 0.0f;
+        } else {
+            const float scaled = qMin(1.0f, (radius - stick.radialDeadzone) / (1.0f - stick.radialDeadzone));
+            x *= scaled / radius;
+            y *= scaled / radius;
+        }
+    }
+    x = stick.x.fn(stick.x, x, dt);
+    y = stick.y.fn(stick.y, y, dt);
+}
+
+RudderState InputShaper::shape(const RudderState &input, double dtSeconds)
+{
+    if (m_pendingVersion.load(std::memory_order_acquire) != m_appliedVersion)
+        applyPending();
+
+    RudderState out = input;
+    const float dt = float(dtSeconds);
+    shapeStick(m_left, out.leftX, out.leftY, dt);
+    shapeStick(m_right, out.rightX, out.rightY, dt);
+    return out;
+}
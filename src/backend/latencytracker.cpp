@@ -0,0 +1,166 @@
+#include "backend/latencytracker.h"
+#include <QDateTime>
+#include <algorithm>
+#include <chrono>
+
+extern "C" {
+    #include <libavutil/avutil.h>
+    #include <libavutil/mathematics.h>
+}
+
+namespace {
+qint64 steadyUs()
+{
+    using namespace std::chrono;
+    return duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count();
+}
+
+double percentile(QVector<double> &values, double p)
+{
+    if (values.isEmpty())
+        return 0.0;
+    const int k = qBound(0, int(p * (values.size() - 1) + 0.5), values.size() - 1);
+    std::nth_element(values.begin(), values.begin() + k, values.end());
+    return values[k];
+}
+}
+
+LatencyTracker::LatencyTracker()
+    : m_wallOffsetUs(QDateTime::currentMSecsSinceEpoch() * 1000 - steadyUs())
+{
+    m_window.reserve(kWindow);
+}
+
+LatencyTracker::Slot *LatencyTracker::slotFor(int64_t pts)
+{
+    // pts 通常按固定步长递增（90 kHz 下每帧 3000），乘法散列打散到各槽
+    const quint64 h = quint64(pts) * 0x9E3779B97F4A7C15ull;
+    return &m_slots[(h >> 56) % kSlots];
+}
+
+void LatencyTracker::beginSession(AVRational timeBase)
+{
+    m_timeBaseNum.store(timeBase.num, std::memory_order_relaxed);
+    m_timeBaseDen.store(timeBase.den ? timeBase.den : 1, std::memory_order_relaxed);
+    m_realtimeBaseUs.store(kNone, std::memory_order_relaxed);
+    m_lastPts = kNone;
+    m_jitterUs = 0.0;
+}
+
+void LatencyTracker::setRealtimeBase(qint64 startRealtimeUs)
+{
+    m_realtimeBaseUs.store(startRealtimeUs, std::memory_order_relaxed);
+}
+
+void LatencyTracker::onPacket(int64_t pts, int bytes, qint64 nowUs)
+{
+    m_bytes.fetch_add(quint64(bytes), std::memory_order_relaxed);
+    if (pts == AV_NOPTS_VALUE)
+        return;
+
+    Slot *slot = slotFor(pts);
+    slot->receivedUs.store(nowUs, std::memory_order_relaxed);
+    slot->decodedUs.store(0, std::memory_order_relaxed);
+    slot->convertedUs.store(0, std::memory_order_relaxed);
+    slot->pts.store(pts, std::memory_order_release);
+
+    // RFC 3550 到达间隔抖动：到达间隔与发送（pts）间隔之差的平滑绝对值
+    if (m_lastPts != kNone && pts > m_lastPts) {
+        const AVRational tb { m_timeBaseNum.load(std::memory_order_relaxed), m_timeBaseDen.load(std::memory_order_relaxed) };
+        const qint64 sentDeltaUs = av_rescale_q(pts - m_lastPts, tb, AVRational{1, 1000000});
+        const double d = double((nowUs - m_lastArrivalUs) - sentDeltaUs);
+        m_jitterUs += (qAbs(d) - m_jitterUs) / 16.0;
+        m_jitterReportUs.store(qint64(m_jitterUs), std::memory_order_relaxed);
+    }
+    if (m_lastPts == kNone || pts > m_lastPts) {
+        m_lastPts = pts;
+        m_lastArrivalUs = nowUs;
+    }
+}
+
+void LatencyTracker::onDecoded(int64_t pts, qint64 nowUs)
+{
+    Slot *slot = slotFor(pts);
+    if (slot->pts.load(std::memory_order_acquire) == pts)
+        slot->decodedUs.store(nowUs, std::memory_order_relaxed);
+}
+
+void LatencyTracker::onConverted(int64_t pts, qint64 nowUs)
+{
+    Slot *slot = slotFor(pts);
+    if (slot->pts.load(std::memory_order_acquire) == pts)
+        slot->convertedUs.store(nowUs, std::memory_order_relaxed);
+}
+
+void LatencyTracker::onDisplayed(int64_t pts, qint64 nowUs)
+{
+    if (pts == AV_NOPTS_VALUE || pts == m_lastDisplayedPts)
+        return;
+    Slot *slot = slotFor(pts);
+    if (slot->pts.load(std::memory_order_acquire) != pts)
+        return;
+    const qint64 received = slot->receivedUs.load(std::memory_order_relaxed);
+    const qint64 decoded = slot->decodedUs.load(std::memory_order_relaxed);
+    const qint64 converted = slot->convertedUs.load(std::memory_order_relaxed);
+    if (received == 0 || decoded == 0 || converted == 0)
+        return;
+    m_lastDisplayedPts = pts;
+
+    Sample s;
+    s.receiveToDisplayMs = (nowUs - received) / 1000.0;
+    s.decodeMs = (decoded - received) / 1000.0;
+    s.convertMs = (converted - decoded) / 1000.0;
+    s.handoffMs = (nowUs - converted) / 1000.0;
+
+    // 有 RTCP 映射时以采集墙钟时间为起点
+    const qint64 base = m_realtimeBaseUs.load(std::memory_order_relaxed);
+    if (base != kNone) {
+        const AVRational tb { m_timeBaseNum.load(std::memory_order_relaxed), m_timeBaseDen.load(std::memory_order_relaxed) };
+        const qint64 captureWallUs = base + av_rescale_q(pts, tb, AVRational{1, 1000000});
+        s.latencyMs = (nowUs + m_wallOffsetUs - captureWallUs) / 1000.0;
+    } else {
+        s.latencyMs = s.receiveToDisplayMs;
+    }
+
+    if (m_window.size() < kWindow)
+        m_window.append(s);
+    else
+        m_window[m_windowPos] = s;
+    m_windowPos = (m_windowPos + 1) % kWindow;
+}
+
+LatencySnapshot LatencyTracker::snapshot(qint64 nowUs)
+{
+    LatencySnapshot snap;
+    snap.samples = m_window.size();
+    snap.glassToGlass = hasRealtimeBase();
+    snap.jitterMs = m_jitterReportUs.load(std::memory_order_relaxed) / 1000.0;
+
+    const quint64 bytes = m_bytes.load(std::memory_order_relaxed);
+    if (m_lastSnapshotUs > 0 && nowUs > m_lastSnapshotUs)
+        snap.bitrateKbps = (bytes - m_lastBytes) * 8.0 / ((nowUs - m_lastSnapshotUs) / 1e6) / 1000.0;
+    m_lastBytes = bytes;
+    m_lastSnapshotUs = nowUs;
+
+    if (m_window.isEmpty())
+        return snap;
+
+    QVector<double> latency, local, decode, convert, handoff;
+    latency.reserve(m_window.size());
+    for (const Sample &s : std::as_const(m_window)) {
+        latency.append(s.latencyMs);
+        local.append(s.receiveToDisplayMs);
+        decode.append(s.decodeMs);
+        convert.append(s.convertMs);
+        handoff.append(s.handoffMs);
+    }
+    snap.p50Ms = percentile(latency, 0.50);
+    snap.p95Ms = percentile(latency, 0.95);
+    snap.p99Ms = percentile(latency, 0.99);
+    snap.maxMs = *std::max_element(latency.cbegin(), latency.cend());
+    snap.receiveToDisplayP50Ms = percentile(local, 0.50);
+    snap.decodeP50Ms = percentile(decode, 0.50);
+    snap.convertP50Ms = percentile(convert, 0.50);
+    snap.handoffP50Ms = percentile(handoff, 0.50);
+    return snap;
+}
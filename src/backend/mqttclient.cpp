@@ -66,6 +66,11 @@ void MqttClient::setCurrentBoat(const QString &boatName)
 
     qDebug() << "船名已更改:" << oldBoat << "->" << m_currentBoat;
 
+    // 船队监控模式下通配符订阅已覆盖所有船只，无需重新订阅
+    if (m_fleetMonitoring) {
+        return;
+    }
+
     // 如果已连接，重新订阅所有主题
     if (isConnected()) {
         qDebug() << "重新订阅主题，新主题前缀: vrx/" << m_currentBoat;
@@ -99,11 +104,32 @@ QString MqttClient::buildTopic(const QString &topicTemplate) const
     return topicTemplate.arg(m_currentBoat);
 }
 
+void MqttClient::setFleetMonitoring(bool enabled)
+{
+    if (m_fleetMonitoring == enabled) {
+        return;
+    }
+    m_fleetMonitoring = enabled;
+    qDebug() << "船队监控:" << (enabled ? "开启" : "关闭");
+
+    if (isConnected()) {
+        unsubscribeFromAll();
+        subscribeToAllSensors();
+    }
+}
+
 void MqttClient::subscribeToAllSensors()
 {
-    subscribeToTopic(buildTopic(TOPIC_IMU_TEMPLATE));
-    subscribeToTopic(buildTopic(TOPIC_GPS_TEMPLATE));
-    subscribeToTopic(buildTopic(TOPIC_SPEED_TEMPLATE));
+    if (m_fleetMonitoring) {
+        // 通配符订阅同时覆盖当前船只，避免重叠订阅导致消息重复投递
+        subscribeToTopic(TOPIC_IMU_TEMPLATE.arg("+"));
+        subscribeToTopic(TOPIC_GPS_TEMPLATE.arg("+"));
+        subscribeToTopic(TOPIC_SPEED_TEMPLATE.arg("+"));
+    } else {
+        subscribeToTopic(buildTopic(TOPIC_IMU_TEMPLATE));
+        subscribeToTopic(buildTopic(TOPIC_GPS_TEMPLATE));
+        subscribeToTopic(buildTopic(TOPIC_SPEED_TEMPLATE));
+    }
     subscribeToTopic(TOPIC_ENVIRONMENT_WIND);
 }
 
@@ -152,12 +178,15 @@ void MqttClient::unsubscribeFromTopic(const QString &topic)
 
 void MqttClient::unsubscribeFromAll()
 {
-    for (const QString &topic : m_subscribedTopics) {
+    // unsubscribeFromTopic 会修改 m_subscribedTopics，遍历副本
+    const QList<QString> topics = m_subscribedTopics;
+    for (const QString &topic : topics) {
         unsubscribeFromTopic(topic);
     }
 }
 
-void MqttClient::publishThrusters(double leftThrust, double rightThrust, double leftPos, double rightPos)
+void MqttClient::publishThrusters(double leftThrust, double rightThrust, double leftPos, double rightPos,
+                                  qint64 sampledUs, qint64 dispatchedUs)
 {
     QJsonObject jsonObject;
     jsonObject["left_thrust"] = leftThrust;
@@ -167,8 +196,14 @@ void MqttClient::publishThrusters(double leftThrust, double rightThrust, double
 
     QJsonDocument doc(jsonObject);
     QByteArray message = doc.toJson(QJsonDocument::Compact);
+    const qint64 serializedUs = ControlLatencyTracker::nowUs();
+
+    if (!publishMessage(buildTopic(TOPIC_THRUSTERS_TEMPLATE), message))
+        return;
 
-    publishMessage(buildTopic(TOPIC_THRUSTERS_TEMPLATE), message);
+    // QMqttClient 只写入套接字缓冲区，下一次 bytesWritten 时才真正交给系统
+    if (sampledUs > 0)
+        m_pendingControl.enqueue(PendingControl{ sampledUs, dispatchedUs, serializedUs });
 }
 
 void MqttClient::publishControlStatus(const QString& states)
@@ -223,19 +258,20 @@ void MqttClient::publishWaveEnvironment(const WaveConfig& config)
 }
 
 
-void MqttClient::publishMessage(const QString &topic, const QByteArray &message, quint8 qos)
+bool MqttClient::publishMessage(const QString &topic, const QByteArray &message, quint8 qos)
 {
     if (!isConnected()) {
         emit errorOccurred("未连接到MQTT代理，无法发布消息");
-        return;
+        return false;
     }
 
     if (m_client->publish(topic, message, qos) == -1) {
         emit errorOccurred("发布消息失败: " + topic);
-        return;
+        return false;
     }
 
     // qDebug() << "已发布消息到主题" << topic << ":" << message;
+    return true;
 }
 
 QString MqttClient::connectionState() const
@@ -256,6 +292,12 @@ QList<QString> MqttClient::subscribedTopics() const
 void MqttClient::onConnected()
 {
     qDebug() << "成功连接到MQTT代理";
+
+    // 传输层在 connectToHost() 时创建，连上后才能取到
+    if (QIODevice *transport = m_client->transport()) {
+        connect(transport, &QIODevice::bytesWritten, this, &MqttClient::onTransportBytesWritten,
+                Qt::UniqueConnection);
+    }
     emit connectionStateChanged("已连接");
 
     // 自动订阅所有传感器主题
@@ -272,6 +314,17 @@ void MqttClient::onDisconnected()
     emit connectionStateChanged("已断开");
     m_autoPublishTimer->stop();
     m_subscribedTopics.clear();
+    m_pendingControl.clear();
+}
+
+void MqttClient::onTransportBytesWritten()
+{
+    // 套接字按顺序写出，本次写出时缓冲区里的指令都已交给系统
+    const qint64 writtenUs = ControlLatencyTracker::nowUs();
+    while (!m_pendingControl.isEmpty()) {
+        const PendingControl pending = m_pendingControl.dequeue();
+        m_controlLatency.record(pending.sampledUs, pending.dispatchedUs, pending.serializedUs, writtenUs);
+    }
 }
 
 void MqttClient::onStateChanged(QMqttClient::ClientState state)
@@ -311,6 +364,15 @@ void MqttClient::processSensorData(const QString &topic, const QByteArray &messa
             return;
         }
 
+        // 船队监控：从 vrx/<船名>/sensors/<类型> 中解析船名，转发所有船只的数据
+        if (m_fleetMonitoring) {
+            const QList<QStringView> parts = QStringView(topic).split(u'/');
+            if (parts.size() == 4 && parts[0] == u"vrx" && parts[2] == u"sensors"
+                && parts[1] != u"environment") {
+                emit fleetSensorDataReceived(parts[1].toString(), parts[3].toString(), data);
+            }
+        }
+
         // 构建当前船名的完整主题进行比较
         QString imuTopic = buildTopic(TOPIC_IMU_TEMPLATE);
         QString gpsTopic = buildTopic(TOPIC_GPS_TEMPLATE);
@@ -0,0 +1,225 @@
+#include "backend/packetring.h"
+#include <cstring>
+#include <new>
+
+namespace {
+// 包索引容量：30 秒 60 fps 的数倍余量
+constexpr int kMaxEntries = 8192;
+}
+
+PacketRing::PacketRing(qint64 budgetBytes)
+    : m_budget(qMax<qint64>(0, budgetBytes))
+    , m_entries(kMaxEntries)
+{
+}
+
+PacketRing::~PacketRing()
+{
+    avcodec_parameters_free(&m_params);
+}
+
+void PacketRing::setBudget(qint64 bytes)
+{
+    QMutexLocker locker(&m_mutex);
+    bytes = qMax<qint64>(0, bytes);
+    if (bytes == m_budget)
+        return;
+    m_budget = bytes;
+    m_arena.reset();
+    m_arenaSize = 0;
+    clearLocked();
+}
+
+qint64 PacketRing::budget() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_budget;
+}
+
+void PacketRing::clearLocked()
+{
+    m_head = 0;
+    m_count = 0;
+    m_writePos = 0;
+    m_bytes = 0;
+    m_needKey = true;
+}
+
+void PacketRing::beginSession(const AVCodecParameters *par, AVRational timeBase)
+{
+    QMutexLocker locker(&m_mutex);
+    // 重连后参数可能变化，旧包无法用新解码器解码，直接清空
+    clearLocked();
+    if (!m_params)
+        m_params = avcodec_parameters_alloc();
+    if (!m_params || avcodec_parameters_copy(m_params, par) < 0) {
+        avcodec_parameters_free(&m_params);
+        return;
+    }
+    m_timeBase = timeBase;
+    ++m_generation;
+}
+
+void PacketRing::evictOldestLocked()
+{
+    m_bytes -= at(0).size;
+    m_head = (m_head + 1) % m_entries.size();
+    --m_count;
+}
+
+bool PacketRing::overlapsOldestLocked(qint64 offset, int size) const
+{
+    if (m_count == 0)
+        return false;
+    const Entry &oldest = at(0);
+    return oldest.offset < offset + size && oldest.offset + oldest.size > offset;
+}
+
+void PacketRing::append(const AVPacket *pkt, qint64 wallMs)
+{
+    QMutexLocker locker(&m_mutex);
+    if (m_budget <= 0 || !m_params || pkt->size <= 0)
+        return;
+
+    // 从关键帧开始保存；单包超过预算四分之一时放弃（并等待下一个关键帧）
+    const bool key = pkt->flags & AV_PKT_FLAG_KEY;
+    if (m_needKey && !key)
+        return;
+    if (pkt->size > m_budget / 4) {
+        m_needKey = true;
+        return;
+    }
+
+    if (!m_arena) {
+        m_arena.reset(new (std::nothrow) uint8_t[m_budget]);
+        if (!m_arena)
+            return;
+        m_arenaSize = m_budget;
+    }
+
+    // 顺序环形写入；尾部放不下时回到开头（尾部留空）
+    qint64 offset = m_writePos;
+    if (offset + pkt->size > m_arenaSize) {
+        // 回绕：写指针之后的尾部是上一轮最旧的包，先全部淘汰，
+        // 最旧的包才会落到开头，下面的重叠检查才能覆盖 [0, size)
+        offset = 0;
+        while (m_count > 0 && at(0).offset >= m_writePos)
+            evictOldestLocked();
+    }
+
+    // 淘汰被覆盖的最旧包；环中最旧的包按写入顺序正好位于写指针之后
+    while (overlapsOldestLocked(offset, pkt->size))
+        evictOldestLocked();
+    if (m_count == m_entries.size())
+        evictOldestLocked();
+    // 对齐到 GOP：最旧的包必须是关键帧，否则整段无法解码
+    while (m_count > 0 && !(at(0).flags & AV_PKT_FLAG_KEY))
+        evictOldestLocked();
+    // GOP 大于预算时整段被淘汰，非关键帧不能成为环起点，等待下一个关键帧
+    if (m_count == 0 && !key) {
+        m_needKey = true;
+        return;
+    }
+
+    memcpy(m_arena.get() + offset, pkt->data, pkt->size);
+
+    Entry &e = m_entries[(m_head + m_count) % m_entries.size()];
+    e.offset = offset;
+    e.size = pkt->size;
+    e.flags = pkt->flags;
+    e.pts = pkt->pts;
+    e.dts = pkt->dts;
+    e.duration = pkt->duration;
+    e.wallMs = wallMs;
+    e.seq = m_nextSeq++;
+    ++m_count;
+    m_bytes += pkt->size;
+    m_writePos = offset + pkt->size;
+    m_needKey = false;
+}
+
+PacketRing::Span PacketRing::span() const
+{
+    QMutexLocker locker(&m_mutex);
+    Span s;
+    if (m_count == 0)
+        return s;
+    s.firstMs = at(0).wallMs;
+    s.lastMs = at(m_count - 1).wallMs;
+    s.packets = m_count;
+    s.bytes = m_bytes;
+    return s;
+}
+
+quint64 PacketRing::generation() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_generation;
+}
+
+bool PacketRing::copyParams(AVCodecParameters *out, AVRational *timeBase, quint64 *generation) const
+{
+    QMutexLocker locker(&m_mutex);
+    if (!m_params || avcodec_parameters_copy(out, m_params) < 0)
+        return false;
+    *timeBase = m_timeBase;
+    *generation = m_generation;
+    return true;
+}
+
+bool PacketRing::extract(qint64 targetMs, quint64 resumeKeySeq, quint64 resumeAfterSeq,
+                         QVector<ReplayPacket> &out, ExtractInfo *info) const
+{
+    QMutexLocker locker(&m_mutex);
+    if (m_count == 0)
+        return false;
+
+    // 二分查找 targetMs 之前（含）的最后一个包；早于环起点时取第一个包
+    int lo = 0;
+    int hi = m_count - 1;
+    while (lo < hi) {
+        const int mid = (lo + hi + 1) / 2;
+        if (at(mid).wallMs <= targetMs)
+            lo = mid;
+        else
+            hi = mid - 1;
+    }
+    const int last = lo;
+
+    // 向前找关键帧（环起点必为关键帧）
+    int key = last;
+    while (key > 0 && !(at(key).flags & AV_PKT_FLAG_KEY))
+        --key;
+
+    int first = key;
+    info->resumed = false;
+    if (at(key).seq == resumeKeySeq && resumeAfterSeq >= resumeKeySeq) {
+        const int resumeIndex = key + int(resumeAfterSeq - resumeKeySeq);
+        if (resumeIndex <= last && at(resumeIndex).seq == resumeAfterSeq) {
+            first = resumeIndex + 1;
+            info->resumed = true;
+        }
+    }
+
+    out.reserve(out.size() + last - first + 1);
+    for (int i = first; i <= last; ++i) {
+        const Entry &e = at(i);
+        AVPacket *pkt = av_packet_alloc();
+        if (!pkt || av_new_packet(pkt, e.size) < 0) {
+            av_packet_free(&pkt);
+            return false;
+        }
+        memcpy(pkt->data, m_arena.get() + e.offset, e.size);
+        pkt->flags = e.flags;
+        pkt->pts = e.pts;
+        pkt->dts = e.dts;
+        pkt->duration = e.duration;
+        out.append(ReplayPacket{ pkt, e.wallMs, e.seq });
+    }
+
+    info->generation = m_generation;
+    info->keySeq = at(key).seq;
+    info->lastSeq = at(last).seq;
+    info->lastWallMs = at(last).wallMs;
+    return true;
+}
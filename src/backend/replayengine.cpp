@@ -0,0 +1,226 @@
+#include "backend/replayengine.h"
+#include <QThread>
+#include <QDebug>
+
+namespace {
+// 回放帧池：转换中 1 + 显示中 1 + 余量 1
+constexpr int kReplayPoolCapacity = 3;
+}
+
+ReplayEngine::ReplayEngine(QObject *parent)
+    : QObject(parent)
+    , m_framePool(FramePool::create(kReplayPoolCapacity))
+{
+    m_frame = av_frame_alloc();
+    m_lastFrame = av_frame_alloc();
+    m_thread = QThread::create([this]() { workerLoop(); });
+    m_thread->setObjectName("VideoReplay");
+    m_thread->start(QThread::LowPriority);
+}
+
+ReplayEngine::~ReplayEngine()
+{
+    {
+        QMutexLocker locker(&m_mutex);
+        m_quit = true;
+        m_wake.wakeAll();
+    }
+    m_thread->wait();
+    delete m_thread;
+
+    resetCodec();
+    av_frame_free(&m_frame);
+    av_frame_free(&m_lastFrame);
+    if (m_sws)
+        sws_freeContext(m_sws);
+}
+
+void ReplayEngine::setSource(const std::shared_ptr<PacketRing> &ring)
+{
+    QMutexLocker locker(&m_mutex);
+    m_ring = ring;
+    m_hasRequest = false;
+}
+
+std::shared_ptr<PacketRing> ReplayEngine::source() const
+{
+    QMutexLocker locker(&m_mutex);
+    return m_ring;
+}
+
+void ReplayEngine::seek(qint64 wallMs)
+{
+    // 合并请求：工作线程忙时只保留最新的目标
+    QMutexLocker locker(&m_mutex);
+    m_requestMs = wallMs;
+    m_hasRequest = true;
+    m_wake.wakeOne();
+}
+
+void ReplayEngine::setOutputSize(const QSize &size)
+{
+    QMutexLocker locker(&m_mutex);
+    m_outputSize = size;
+}
+
+void ReplayEngine::workerLoop()
+{
+    while (true) {
+        qint64 target = 0;
+        std::shared_ptr<PacketRing> ring;
+        {
+            QMutexLocker locker(&m_mutex);
+            while (!m_hasRequest && !m_quit)
+                m_wake.wait(&m_mutex);
+            if (m_quit)
+                break;
+            m_hasRequest = false;
+            target = m_requestMs;
+            ring = m_ring;
+        }
+        if (!ring)
+            continue;
+
+        // 源或会话（重连）变化时重建解码器
+        if (ring != m_activeRing || ring->generation() != m_generation) {
+            resetCodec();
+            m_activeRing = ring;
+            if (!openCodec(ring))
+                continue;
+        }
+        decodeTo(target);
+    }
+    m_activeRing.reset();
+}
+
+bool ReplayEngine::openCodec(const std::shared_ptr<PacketRing> &ring)
+{
+    AVCodecParameters *par = avcodec_parameters_alloc();
+    AVRational timeBase { 0, 1 };
+    quint64 generation = 0;
+    if (!par || !ring->copyParams(par, &timeBase, &generation)) {
+        avcodec_parameters_free(&par);
+        return false;
+    }
+
+    const AVCodec *codec = avcodec_find_decoder(par->codec_id);
+    m_codec = codec ? avcodec_alloc_context3(codec) : nullptr;
+    bool ok = m_codec && avcodec_parameters_to_context(m_codec, par) >= 0;
+    avcodec_parameters_free(&par);
+    if (ok) {
+        m_codec->pkt_timebase = timeBase;
+        // 回放只求单帧，少量线程即可；只用片级多线程：帧级多线程有一帧输出延迟，
+        // 取到的会是目标的前一帧
+        m_codec->thread_count = 2;
+        m_codec->thread_type = FF_THREAD_SLICE;
+        ok = avcodec_open2(m_codec, codec, nullptr) >= 0;
+    }
+    if (!ok) {
+        qDebug() << "Replay: failed to open decoder";
+        resetCodec();
+        return false;
+    }
+    m_generation = generation;
+    return true;
+}
+
+void ReplayEngine::resetCodec()
+{
+    avcodec_free_context(&m_codec);
+    av_frame_unref(m_lastFrame);
+    m_haveFrame = false;
+    m_generation = 0;
+    m_keySeq = 0;
+    m_lastSeq = 0;
+}
+
+void ReplayEngine::decodeTo(qint64 targetMs)
+{
+    QVector<ReplayPacket> packets;
+    PacketRing::ExtractInfo info;
+    if (!m_activeRing->extract(targetMs, m_keySeq, m_lastSeq, packets, &info) || info.generation != m_generation) {
+        for (ReplayPacket &p : packets)
+            av_packet_free(&p.packet);
+        return;
+    }
+
+    // 不能续接（新的 GOP 或向后拖动）：清空参考帧，从关键帧重新解码
+    if (!info.resumed) {
+        avcodec_flush_buffers(m_codec);
+        av_frame_unref(m_lastFrame);
+        m_haveFrame = false;
+    }
+
+    // 目标帧即最后一个取出的包；拿到它之后（冲刷时）显示顺序更靠后的帧不再替换它
+    const int64_t targetPts = packets.isEmpty() ? AV_NOPTS_VALUE : packets.last().packet->pts;
+    bool gotFrame = false;
+    bool gotTarget = false;
+    auto receiveAll = [&]() {
+        while (avcodec_receive_frame(m_codec, m_frame) >= 0) {
+            if (gotTarget) {
+                av_frame_unref(m_frame);
+                continue;
+            }
+            av_frame_unref(m_lastFrame);
+            av_frame_move_ref(m_lastFrame, m_frame);
+            m_haveFrame = true;
+            gotFrame = true;
+            gotTarget = targetPts != AV_NOPTS_VALUE && m_lastFrame->pts == targetPts;
+        }
+    };
+    for (ReplayPacket &p : packets) {
+        if (avcodec_send_packet(m_codec, p.packet) == AVERROR(EAGAIN)) {
+            receiveAll();
+            avcodec_send_packet(m_codec, p.packet);
+        }
+        receiveAll();
+        av_packet_free(&p.packet);
+    }
+
+    m_keySeq = info.keySeq;
+    m_lastSeq = info.lastSeq;
+
+    // 解码器有输出延迟（B 帧重排）、本次没有输出目标帧时冲刷出剩余帧；
+    // 冲刷后无法续接，下次从关键帧重新开始
+    const bool pending = targetPts != AV_NOPTS_VALUE ? !gotTarget : !gotFrame;
+    if (pending && !packets.isEmpty()) {
+        avcodec_send_packet(m_codec, nullptr);
+        receiveAll();
+        avcodec_flush_buffers(m_codec);
+        m_keySeq = 0;
+        m_lastSeq = 0;
+    }
+
+    if (m_haveFrame)
+        emitFrame(info.lastWallMs);
+}
+
+void ReplayEngine::emitFrame(qint64 wallMs)
+{
+    QSize requested;
+    {
+        QMutexLocker locker(&m_mutex);
+        requested = m_outputSize;
+    }
+    const QSize src(m_lastFrame->width, m_lastFrame->height);
+    QSize dst = requested.isEmpty() ? src : src.scaled(requested, Qt::KeepAspectRatio);
+    dst = dst.expandedTo(QSize(16, 16));
+
+    m_sws = sws_getCachedContext(m_sws,
+                                 src.width(), src.height(), static_cast<AVPixelFormat>(m_lastFrame->format),
+                                 dst.width(), dst.height(), AV_PIX_FMT_RGB32,
+                                 dst.width() < src.width() ? SWS_AREA : SWS_FAST_BILINEAR,
+                                 nullptr, nullptr, nullptr);
+    if (!m_sws)
+        return;
+
+    QImage image = m_framePool->acquire(dst, QImage::Format_RGB32);
+    if (image.isNull())
+        return;     // 界面仍持有全部回放帧，丢弃本次结果
+
+    uint8_t *dstData[4] = { image.bits(), nullptr, nullptr, nullptr };
+    int dstLinesize[4] = { int(image.bytesPerLine()), 0, 0, 0 };
+    sws_scale(m_sws, (uint8_t const * const *)m_lastFrame->data, m_lastFrame->linesize,
+              0, m_lastFrame->height, dstData, dstLinesize);
+    emit frameReady(image, wallMs);
+}
@@ -1,6 +1,32 @@
 #include "backend/ruddercontroller.h"
+#include "backend/rudderinput.h"
+#include "backend/evdevinput.h"
+#include "backend/controllatency.h"
 #include <QDebug>
 #include <QDateTime>
+#include <memory>
+
+namespace {
+QMutex g_inputConfigMutex;
+RudderInputConfig g_inputConfig;
+constexpr int kSourceWaitMs = 1000;
+constexpr float kChangeThreshold = 0.004f;  // 约 1/256 满量程，低于摇杆噪声可感知的幅度
+constexpr int kKeepaliveMs = 500;           // 静止时仍按 2 Hz 重发，船端据此判断遥控在线
+
+bool axisChanged(float last, float current)
+{
+    if (qAbs(current - last) > kChangeThreshold)
+        return true;
+    // 回到零位总要发出，避免停在阈值内的小推力上；反方向只按阈值判断，中位噪声不会来回触发
+    return current == 0.0f && last != 0.0f;
+}
+
+bool stateChanged(const RudderState &last, const RudderState &current)
+{
+    return axisChanged(last.leftX, current.leftX) || axisChanged(last.leftY, current.leftY)
+        || axisChanged(last.rightX, current.rightX) || axisChanged(last.rightY, current.rightY);
+}
+}
 
 #ifdef Q_OS_WIN
 #include <SDL2/SDL.h>
@@ -96,10 +122,9 @@ RudderController::~RudderController()
     }
 }
 
-RudderState RudderController::getCurrentState()
+RudderState RudderController::getCurrentState() const
 {
-    QMutexLocker locker(&m_mutex);
-    return m_currentState;
+    return m_snapshot.load();
 }
 
 bool RudderController::isControllerConnected() const
@@ -110,18 +135,146 @@ bool RudderController::isControllerConnected() const
 void RudderController::stopDetection()
 {
     m_running = false;
+    QMutexLocker locker(&m_sourceMutex);
+    if (m_source)
+        m_source->interrupt();
+}
+
+void RudderController::setInputConfig(const RudderInputConfig &config)
+{
+    QMutexLocker locker(&g_inputConfigMutex);
+    g_inputConfig = config;
 }
 
-void RudderController::updateState(const RudderState &newState)
+RudderInputConfig RudderController::inputConfig()
 {
-    QMutexLocker locker(&m_mutex);
-    m_currentState = newState;
+    QMutexLocker locker(&g_inputConfigMutex);
+    return g_inputConfig;
+}
+
+bool RudderController::publish(const RudderState &input, bool force)
+{
+    // 轴值未变时沿用上一采样的时间戳，延迟只从输入实际变化的时刻算起
+    RudderState state = input;
+    const RudderState previous = m_snapshot.load();
+    if (state.leftX == previous.leftX && state.leftY == previous.leftY
+        && state.rightX == previous.rightX && state.rightY == previous.rightY)
+        state.sampledUs = previous.sampledUs;
+    m_snapshot.store(state);
+    m_samples.fetch_add(1, std::memory_order_relaxed);
+
+    const bool changed = force || !m_hasEmitted || stateChanged(m_lastEmitted, state);
+    if (!changed && keepaliveRemainingMs() > 0)
+        return false;
+
+    m_lastEmitted = state;
+    m_hasEmitted = true;
+    m_sinceEmit.start();
+    m_emits.fetch_add(1, std::memory_order_relaxed);
+    if (changed) {
+        emit rudderUpdated(state);
+        if (m_recorder)
+            m_recorder->record(state);
+    } else {
+        // 保活重发的是旧采样，不计入延迟统计
+        RudderState keepalive = state;
+        keepalive.sampledUs = 0;
+        emit rudderUpdated(keepalive);
+    }
+    return true;
+}
+
+int RudderController::keepaliveRemainingMs() const
+{
+    if (!m_hasEmitted)
+        return 0;
+    return int(qMax<qint64>(0, kKeepaliveMs - m_sinceEmit.elapsed()));
+}
+
+void RudderController::runSource(RudderInputSource *source)
+{
+    qDebug() << "摇杆输入源:" << source->name();
+    {
+        QMutexLocker locker(&m_sourceMutex);
+        m_source = source;
+    }
+
+    auto updateConnected = [this, source]() {
+        const bool connected = source->isConnected();
+        if (connected != m_controllerConnected) {
+            m_controllerConnected = connected;
+            emit controllerStatusChanged(connected);
+        }
+    };
+
+    RudderState state;
+    updateConnected();
+    publish(state, true);       // 初始零位，同时开始保活计时
+    while (m_running) {
+        // 阻塞到有输入或保活到期为止
+        const int timeoutMs = qBound(1, keepaliveRemainingMs(), kSourceWaitMs);
+        const RudderInputSource::WaitResult result = source->wait(state, timeoutMs);
+        state.sampledUs = ControlLatencyTracker::nowUs();
+        updateConnected();
+        if (result == RudderInputSource::Timeout) {
+            if (keepaliveRemainingMs() == 0)
+                publish(m_snapshot.load());
+            continue;
+        }
+
+        if (result == RudderInputSource::Finished) {
+            // 回放结束：推力归零后停止
+            qDebug() << "输入回放结束";
+            publish(RudderState(), true);
+            m_controllerConnected = false;
+            emit controllerStatusChanged(false);
+            break;
+        }
+
+        // Disconnected 时 state 已清零，强制下发一次让推力归零
+        publish(state, result == RudderInputSource::Disconnected);
+    }
+
+    QMutexLocker locker(&m_sourceMutex);
+    m_source = nullptr;
 }
 
 void RudderController::run()
 {
     qDebug() << "开始手柄检测线程...";
 
+    const RudderInputConfig config = inputConfig();
+    RudderInputRecorder recorder;
+    if (!config.recordFile.isEmpty()) {
+        QString error;
+        if (recorder.open(config.recordFile, &error))
+            qDebug() << "摇杆输入录制到" << config.recordFile;
+        else
+            qWarning() << error;
+    }
+    m_recorder = recorder.isOpen() ? &recorder : nullptr;
+
+    // 回放文件优先；Linux 下直接读 evdev 设备
+    std::unique_ptr<RudderInputSource> source;
+    if (!config.replayFile.isEmpty())
+        source = std::make_unique<ReplayInputSource>(config.replayFile, config.replaySpeed, config.replayLoop);
+#ifdef Q_OS_LINUX
+    else
+        source = std::make_unique<EvdevInputSource>(config.evdevDevice);
+#endif
+
+    if (source) {
+        QString error;
+        if (source->open(&error))
+            runSource(source.get());
+        else
+            qWarning() << "摇杆输入源不可用:" << error;
+        m_recorder = nullptr;
+        recorder.close();
+        qDebug() << "手柄检测线程结束";
+        return;
+    }
+
 #ifdef Q_OS_WIN
     // SDL2 初始化
     SDL_SetHint(SDL_HINT_JOYSTICK_HIDAPI, "1");
@@ -228,8 +381,9 @@ void RudderController::run()
             }
         }
 
-        updateState(state);
-        emit rudderUpdated(state);
+        // 每次采样只写快照，变化时才发出
+        state.sampledUs = ControlLatencyTracker::nowUs();
+        publish(state, currentConnected != m_controllerConnected);
 
         static int outputCount = 0;
         if (outputCount++ % 50 == 0) {
@@ -251,8 +405,8 @@ void RudderController::run()
         SDL_Quit();
     }
 #else
-    // 非Windows平台的模拟代码
-    qWarning() << "非Windows平台，使用模拟数据";
+    // 其他平台（非 Windows / Linux）的模拟代码
+    qWarning() << "无手柄输入后端，使用模拟数据";
     RudderState state;
     int counter = 0;
 
@@ -262,15 +416,16 @@ void RudderController::run()
         state.leftY = qCos(time) * 0.5f;
         state.rightX = qSin(time * 1.5f) * 0.3f;
         state.rightY = qCos(time * 1.5f) * 0.3f;
+        state.sampledUs = ControlLatencyTracker::nowUs();
 
-        updateState(state);
-        emit rudderUpdated(state);
-
-        qDebug().noquote() << QString("模拟数据: %1").arg(state.toString());
+        publish(state);
 
         msleep(100);
     }
 #endif
 
+    m_recorder = nullptr;
+    recorder.close();
+
     qDebug() << "手柄检测线程结束";
 }
@@ -0,0 +1,138 @@
+#include "backend/rudderinput.h"
+#include <QFileInfo>
+#include <QDebug>
+#include <chrono>
+
+namespace {
+const char kRecordHeader[] = "# rudder input v1: ms,leftX,leftY,rightX,rightY";
+}
+
+// ============================================================
+// ReplayInputSource
+// ============================================================
+ReplayInputSource::ReplayInputSource(const QString &path, double speed, bool loop)
+    : m_path(path)
+    , m_speed(qMax(0.0, speed))
+    , m_loop(loop)
+{
+}
+
+QString ReplayInputSource::name() const
+{
+    return QString("回放 %1").arg(QFileInfo(m_path).fileName());
+}
+
+bool ReplayInputSource::open(QString *error)
+{
+    QFile file(m_path);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        if (error)
+            *error = QString("无法打开输入录制文件 %1: %2").arg(m_path, file.errorString());
+        return false;
+    }
+
+    m_samples.clear();
+    QTextStream in(&file);
+    qint64 lastMs = 0;
+    while (!in.atEnd()) {
+        const QString line = in.readLine().trimmed();
+        if (line.isEmpty() || line.startsWith('#'))
+            continue;
+        const QStringList f = line.split(',');
+        if (f.size() < 5)
+            continue;
+        Sample s;
+        s.ms = qMax(lastMs, f[0].toLongLong());     // 时间不回退
+        s.state.leftX = f[1].toFloat();
+        s.state.leftY = f[2].toFloat();
+        s.state.rightX = f[3].toFloat();
+        s.state.rightY = f[4].toFloat();
+        lastMs = s.ms;
+        m_samples.append(s);
+    }
+    if (m_samples.isEmpty()) {
+        if (error)
+            *error = QString("输入录制文件为空: %1").arg(m_path);
+        return false;
+    }
+
+    m_next = 0;
+    m_clock.start();
+    qDebug() << "输入回放:" << m_path << m_samples.size() << "个样本，时长"
+             << m_samples.last().ms << "ms，倍速" << m_speed;
+    return true;
+}
+
+RudderInputSource::WaitResult ReplayInputSource::wait(RudderState &state, int timeoutMs)
+{
+    if (m_next >= m_samples.size()) {
+        if (!m_loop)
+            return Finished;
+        m_next = 0;
+        m_clock.restart();
+    }
+
+    const Sample &sample = m_samples.at(m_next);
+    // 按录制时间间隔等待；倍速为 0 时不等待
+    const qint64 dueMs = m_speed > 0.0 ? qint64(sample.ms / m_speed) : 0;
+    const qint64 waitMs = qMin<qint64>(dueMs - m_clock.elapsed(), timeoutMs);
+    if (waitMs > 0) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cond.wait_for(lock, std::chrono::milliseconds(waitMs), [this] { return m_interrupted; });
+        if (m_interrupted) {
+            m_interrupted = false;
+            return Timeout;
+        }
+        if (m_clock.elapsed() < dueMs)
+            return Timeout;
+    }
+
+    state = sample.state;
+    ++m_next;
+    return Updated;
+}
+
+void ReplayInputSource::interrupt()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_interrupted = true;
+    }
+    m_cond.notify_all();
+}
+
+// ============================================================
+// RudderInputRecorder
+// ============================================================
+bool RudderInputRecorder::open(const QString &path, QString *error)
+{
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+        if (error)
+            *error = QString("无法创建输入录制文件 %1: %2").arg(path, m_file.errorString());
+        return false;
+    }
+    m_out.setDevice(&m_file);
+    m_out << kRecordHeader << '\n';
+    m_clock.start();
+    return true;
+}
+
+void RudderInputRecorder::record(const RudderState &state)
+{
+    if (!m_file.isOpen())
+        return;
+    m_out << m_clock.elapsed() << ','
+          << QString::number(state.leftX, 'f', 4) << ','
+          << QString::number(state.leftY, 'f', 4) << ','
+          << QString::number(state.rightX, 'f', 4) << ','
+          << QString::number(state.rightY, 'f', 4) << '\n';
+}
+
+void RudderInputRecorder::close()
+{
+    if (!m_file.isOpen())
+        return;
+    m_out.flush();
+    m_file.close();
+}
@@ -0,0 +1,157 @@
+#include "backend/streammanager.h"
+#include <QDebug>
+
+namespace {
+// 即时回放环预算（只给活动流）：4 Mbps 码流约 60 秒
+constexpr qint64 kReplayBudgetBytes = 32 * 1024 * 1024;
+}
+
+StreamManager::StreamManager(QObject *parent)
+    : QObject(parent)
+{
+}
+
+FFmpegDecoder *StreamManager::createDecoder(const QString &url, bool persistent)
+{
+    auto *decoder = new FFmpegDecoder(this);
+    decoder->setStandby(true);
+    decoder->setOutputSize(m_outputSize);
+    decoder->setOutputFormat(m_outputFormat);
+
+    // 只转发活动流的信号
+    connect(decoder, &FFmpegDecoder::frameAvailable, this, [this, decoder]() {
+        if (decoder == activeDecoder())
+            emit frameAvailable();
+    });
+    connect(decoder, &FFmpegDecoder::stateChanged, this, [this, decoder](int state) {
+        if (decoder == activeDecoder())
+            emit stateChanged(state);
+    });
+    connect(decoder, &FFmpegDecoder::errorOccurred, this, [this, decoder](const QString &msg) {
+        if (decoder == activeDecoder())
+            emit errorOccurred(msg);
+        else
+            qDebug() << "[VIDEO] 备用流错误:" << decoder->url() << msg;
+    });
+
+    m_streams.insert(url, Entry{decoder, persistent});
+    return decoder;
+}
+
+void StreamManager::ensureRunning(FFmpegDecoder *decoder, const QString &url)
+{
+    // 从未连接、已断开或出错的流重新打开
+    const int state = decoder->getState();
+    if (state == FFmpegDecoder::Stopped || state == FFmpegDecoder::Error)
+        decoder->openStream(url);
+}
+
+void StreamManager::addStandby(const QString &url)
+{
+    if (url.isEmpty() || m_streams.contains(url))
+        return;
+    FFmpegDecoder *decoder = createDecoder(url, true);
+    m_standbyOrder.append(url);
+    decoder->setStandby(!m_mosaic);
+    decoder->openStream(url);
+}
+
+FFmpegDecoder *StreamManager::decoder(const QString &url) const
+{
+    auto it = m_streams.constFind(url);
+    return it == m_streams.constEnd() ? nullptr : it->decoder;
+}
+
+void StreamManager::setMosaicMode(bool enabled)
+{
+    if (m_mosaic == enabled)
+        return;
+    m_mosaic = enabled;
+
+    for (const QString &url : std::as_const(m_standbyOrder)) {
+        FFmpegDecoder *d = decoder(url);
+        if (enabled) {
+            d->setStandby(false);
+            ensureRunning(d, url);
+        } else {
+            // 退出宫格：恢复完整质量与单画面尺寸，非活动流回到备用
+            d->setDecodeQuality(FFmpegDecoder::FullQuality);
+            d->setOutputSize(m_outputSize);
+            d->setStandby(url != m_activeUrl);
+        }
+    }
+}
+
+FFmpegDecoder *StreamManager::activeDecoder() const
+{
+    auto it = m_streams.constFind(m_activeUrl);
+    return it == m_streams.constEnd() ? nullptr : it->decoder;
+}
+
+void StreamManager::activate(const QString &url)
+{
+    if (url.isEmpty())
+        return;
+
+    if (url == m_activeUrl) {
+        if (FFmpegDecoder *decoder = activeDecoder())
+            ensureRunning(decoder, url);
+        return;
+    }
+
+    deactivate();
+
+    auto it = m_streams.find(url);
+    FFmpegDecoder *decoder = (it != m_streams.end()) ? it->decoder : createDecoder(url, false);
+
+    m_activeUrl = url;
+    decoder->setStandby(false);
+    decoder->setReplayBudget(kReplayBudgetBytes);
+    ensureRunning(decoder, url);
+
+    qDebug() << "[VIDEO] 切换到流:" << url << "状态:" << decoder->getState();
+    emit stateChanged(decoder->getState());
+
+    // 备用期间信箱里保留的最新关键帧：通知界面立即取走显示
+    emit frameAvailable();
+}
+
+void StreamManager::deactivate()
+{
+    if (m_activeUrl.isEmpty())
+        return;
+
+    const QString url = m_activeUrl;
+    m_activeUrl.clear();
+
+    auto it = m_streams.find(url);
+    if (it == m_streams.end())
+        return;
+
+    if (it->persistent) {
+        it->decoder->setStandby(!m_mosaic); // 保持连接，回到备用
+        it->decoder->setReplayBudget(0);    // 释放回放环
+    } else {
+        FFmpegDecoder *decoder = it->decoder;
+        m_streams.erase(it);
+        decoder->stop();
+        decoder->deleteLater();
+    }
+    emit stateChanged(FFmpegDecoder::Stopped);
+}
+
+void StreamManager::setOutputFormat(QImage::Format format)
+{
+    m_outputFormat = format;
+    for (const Entry &e : std::as_const(m_streams))
+        e.decoder->setOutputFormat(format);
+}
+
+void StreamManager::setOutputSize(const QSize &size)
+{
+    m_outputSize = size;
+    if (m_mosaic)
+        return;     // 宫格模式下输出尺寸由各图块设置
+    for (const Entry &e : std::as_const(m_streams))
+        e.decoder->setOutputSize(size);
+}
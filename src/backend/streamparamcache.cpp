@@ -0,0 +1,142 @@
+#include "backend/streamparamcache.h"
+#include <QSettings>
+#include <QStandardPaths>
+#include <QCryptographicHash>
+#include <QDir>
+#include <QDebug>
+#include <cstring>
+
+StreamParamCache &StreamParamCache::instance()
+{
+    static StreamParamCache cache;
+    return cache;
+}
+
+StreamParamCache::StreamParamCache()
+{
+    const QString dir = QStandardPaths::writableLocation(QStandardPaths::AppCacheLocation);
+    QDir().mkpath(dir);
+    m_path = dir + "/stream_params.ini";
+    load();
+}
+
+QString StreamParamCache::groupFor(const QString &url)
+{
+    // URL 中的 '/' 会被 QSettings 当作分组分隔符，用摘要作为分组名
+    return QString::fromLatin1(QCryptographicHash::hash(url.toUtf8(), QCryptographicHash::Sha1).toHex());
+}
+
+void StreamParamCache::load()
+{
+    QSettings settings(m_path, QSettings::IniFormat);
+    for (const QString &group : settings.childGroups()) {
+        settings.beginGroup(group);
+        const QString url = settings.value("url").toString();
+        Entry e;
+        e.codecId = settings.value("codec_id", int(AV_CODEC_ID_NONE)).toInt();
+        e.width = settings.value("width").toInt();
+        e.height = settings.value("height").toInt();
+        e.format = settings.value("format", -1).toInt();
+        e.profile = settings.value("profile").toInt();
+        e.level = settings.value("level").toInt();
+        e.sarNum = settings.value("sar_num").toInt();
+        e.sarDen = settings.value("sar_den", 1).toInt();
+        e.colorRange = settings.value("color_range").toInt();
+        e.colorSpace = settings.value("color_space").toInt();
+        e.fieldOrder = settings.value("field_order").toInt();
+        e.extradata = settings.value("extradata").toByteArray();
+        settings.endGroup();
+
+        if (!url.isEmpty() && e.codecId != AV_CODEC_ID_NONE && e.width > 0 && e.height > 0)
+            m_entries.insert(url, e);
+    }
+    qDebug() << "Stream parameter cache:" << m_entries.size() << "entries from" << m_path;
+}
+
+void StreamParamCache::save(const QString &url, const Entry &e) const
+{
+    QSettings settings(m_path, QSettings::IniFormat);
+    settings.beginGroup(groupFor(url));
+    settings.setValue("url", url);
+    settings.setValue("codec_id", e.codecId);
+    settings.setValue("width", e.width);
+    settings.setValue("height", e.height);
+    settings.setValue("format", e.format);
+    settings.setValue("profile", e.profile);
+    settings.setValue("level", e.level);
+    settings.setValue("sar_num", e.sarNum);
+    settings.setValue("sar_den", e.sarDen);
+    settings.setValue("color_range", e.colorRange);
+    settings.setValue("color_space", e.colorSpace);
+    settings.setValue("field_order", e.fieldOrder);
+    settings.setValue("extradata", e.extradata);
+    settings.endGroup();
+}
+
+bool StreamParamCache::apply(const QString &url, AVCodecParameters *par) const
+{
+    QMutexLocker locker(&m_mutex);
+    auto it = m_entries.constFind(url);
+    if (it == m_entries.constEnd())
+        return false;
+    const Entry &e = *it;
+
+    // 摄像头更换了编码，缓存作废
+    if (par->codec_id != AV_CODEC_ID_NONE && par->codec_id != e.codecId)
+        return false;
+
+    par->codec_id = AVCodecID(e.codecId);
+    par->width = e.width;
+    par->height = e.height;
+    par->format = e.format;
+    par->profile = e.profile;
+    par->level = e.level;
+    par->sample_aspect_ratio = AVRational{ e.sarNum, e.sarDen };
+    par->color_range = AVColorRange(e.colorRange);
+    par->color_space = AVColorSpace(e.colorSpace);
+    par->field_order = AVFieldOrder(e.fieldOrder);
+
+    // SDP（sprop-parameter-sets）给出的 extradata 更新，优先使用
+    if (par->extradata_size == 0 && !e.extradata.isEmpty()) {
+        par->extradata = static_cast<uint8_t *>(av_mallocz(e.extradata.size() + AV_INPUT_BUFFER_PADDING_SIZE));
+        if (!par->extradata)
+            return false;
+        memcpy(par->extradata, e.extradata.constData(), e.extradata.size());
+        par->extradata_size = int(e.extradata.size());
+    }
+    return true;
+}
+
+void StreamParamCache::store(const QString &url, const AVCodecParameters *par)
+{
+    if (url.isEmpty() || par->codec_id == AV_CODEC_ID_NONE || par->width <= 0 || par->height <= 0)
+        return;
+
+    Entry e;
+    e.codecId = par->codec_id;
+    e.width = par->width;
+    e.height = par->height;
+    e.format = par->format;
+    e.profile = par->profile;
+    e.level = par->level;
+    e.sarNum = par->sample_aspect_ratio.num;
+    e.sarDen = par->sample_aspect_ratio.den ? par->sample_aspect_ratio.den : 1;
+    e.colorRange = par->color_range;
+    e.colorSpace = par->color_space;
+    e.fieldOrder = par->field_order;
+    if (par->extradata && par->extradata_size > 0)
+        e.extradata = QByteArray(reinterpret_cast<const char *>(par->extradata), par->extradata_size);
+
+    QMutexLocker locker(&m_mutex);
+    m_entries.insert(url, e);
+    save(url, e);
+}
+
+void StreamParamCache::remove(const QString &url)
+{
+    QMutexLocker locker(&m_mutex);
+    if (m_entries.remove(url) == 0)
+        return;
+    QSettings settings(m_path, QSettings::IniFormat);
+    settings.remove(groupFor(url));
+}
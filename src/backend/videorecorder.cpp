@@ -0,0 +1,349 @@
+#include "backend/videorecorder.h"
+#include <QThread>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QTextStream>
+#include <QDateTime>
+#include <QDebug>
+
+namespace {
+// 旁路队列限额：包数与字节数任一超出即丢包（约数秒的高码率视频）
+constexpr int kQueuePackets = 1024;
+constexpr qint64 kMaxQueuedBytes = 32 * 1024 * 1024;
+// pts 映射的墙钟与到达时间偏差超过该值时重新锚定（摄像头时钟跳变、断流）
+constexpr qint64 kResyncMs = 2000;
+}
+
+VideoRecorder::VideoRecorder()
+    : m_queue(kQueuePackets + 1)     // +1 给停止标记
+{
+}
+
+VideoRecorder::~VideoRecorder()
+{
+    stop();
+    avcodec_parameters_free(&m_latestParams);
+}
+
+void VideoRecorder::setSegmentDuration(int seconds)
+{
+    m_segmentMs.store(qMax(1, seconds) * 1000, std::memory_order_relaxed);
+}
+
+bool VideoRecorder::start(const QString &dir, const QString &name)
+{
+    if (m_thread)
+        return true;
+    if (!QDir().mkpath(dir)) {
+        qDebug() << "Recorder: cannot create" << dir;
+        return false;
+    }
+
+    m_dir = dir;
+    m_name = name;
+    drainQueue();                   // reset 不释放包，先回收残留
+    m_queue.reset();
+    m_queuedBytes = 0;
+    m_producerNeedsKey = true;
+
+    m_thread = QThread::create([this]() { writerLoop(); });
+    m_thread->setObjectName("VideoRecord");
+    m_thread->start(QThread::LowPriority);
+    m_active.store(true, std::memory_order_release);
+    qDebug() << "Recording started:" << dir << name;
+    return true;
+}
+
+void VideoRecorder::stop()
+{
+    if (!m_thread)
+        return;
+
+    {
+        // 与 push() 串行：解锁后读包线程不会再入队，停止标记之后队列不再有包
+        QMutexLocker locker(&m_mutex);
+        m_active.store(false, std::memory_order_release);
+    }
+    m_queue.push(Item());           // 停止标记：写完已入队的包再关闭分段
+    m_thread->wait();
+    delete m_thread;
+    m_thread = nullptr;
+
+    drainQueue();
+    {
+        QMutexLocker locker(&m_mutex);
+        m_currentFile.clear();
+    }
+    qDebug() << "Recording stopped:" << m_segments.load() << "segments";
+}
+
+void VideoRecorder::drainQueue()
+{
+    // 写线程已退出，回收队列中剩余的包（停止标记之后正常情况下为空）
+    Item item;
+    while (m_queue.tryPop(item))
+        av_packet_free(&item.packet);
+    m_queuedBytes = 0;
+}
+
+void VideoRecorder::beginSession(const AVCodecParameters *par, AVRational timeBase)
+{
+    QMutexLocker locker(&m_mutex);
+    if (!m_latestParams)
+        m_latestParams = avcodec_parameters_alloc();
+    if (!m_latestParams || avcodec_parameters_copy(m_latestParams, par) < 0)
+        return;
+    m_latestTimeBase = timeBase;
+    ++m_latestSession;
+    m_producerNeedsKey = true;      // 新会话从关键帧开始
+}
+
+void VideoRecorder::push(const AVPacket *pkt, qint64 arrivalMs)
+{
+    if (!m_active.load(std::memory_order_acquire))
+        return;
+
+    // 入队与 stop() 串行，避免停止后入队的包无人释放
+    QMutexLocker locker(&m_mutex);
+    if (!m_active.load(std::memory_order_relaxed))
+        return;
+
+    const bool key = pkt->flags & AV_PKT_FLAG_KEY;
+    if (m_producerNeedsKey && !key)
+        return;
+
+    // 字节限额：写盘跟不上时丢包，之后一直丢到下一个关键帧，保证分段可解码
+    if (m_queuedBytes.load(std::memory_order_relaxed) + pkt->size > kMaxQueuedBytes) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        m_producerNeedsKey = true;
+        return;
+    }
+
+    Item item;
+    item.packet = av_packet_clone(pkt);     // 引用计数拷贝，不复制数据
+    item.arrivalMs = arrivalMs;
+    item.session = m_latestSession;
+    if (!item.packet)
+        return;
+
+    m_queuedBytes.fetch_add(pkt->size, std::memory_order_relaxed);
+    if (!m_queue.tryPush(item)) {
+        m_queuedBytes.fetch_sub(pkt->size, std::memory_order_relaxed);
+        av_packet_free(&item.packet);
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        m_producerNeedsKey = true;
+        return;
+    }
+    m_producerNeedsKey = false;
+}
+
+void VideoRecorder::writerLoop()
+{
+    Item item;
+    while (m_queue.pop(item) && item.packet) {
+        const int size = item.packet->size;
+        if (item.session != m_session && !adoptSession(item.session)) {
+            av_packet_free(&item.packet);       // 已被更新会话取代的旧包
+        } else {
+            writePacket(item.packet, item.arrivalMs);
+            av_packet_free(&item.packet);
+        }
+        m_queuedBytes.fetch_sub(size, std::memory_order_relaxed);
+    }
+    closeSegment();
+    avcodec_parameters_free(&m_params);
+    m_session = 0;
+}
+
+bool VideoRecorder::adoptSession(quint64 session)
+{
+    QMutexLocker locker(&m_mutex);
+    if (session != m_latestSession || !m_latestParams)
+        return false;
+
+    // 编码参数可能随重连变化：关闭当前分段，下一个关键帧以新参数开新段
+    closeSegment();
+    if (!m_params)
+        m_params = avcodec_parameters_alloc();
+    if (!m_params || avcodec_parameters_copy(m_params, m_latestParams) < 0)
+        return false;
+    m_timeBase = m_latestTimeBase;
+    m_session = session;
+    m_anchorPts = AV_NOPTS_VALUE;
+    m_writerNeedsKey = true;
+    return true;
+}
+
+qint64 VideoRecorder::wallTimeFor(const AVPacket *pkt, qint64 arrivalMs)
+{
+    // 用 pts 推算墙钟时间，消除网络到达抖动；偏差过大时以到达时间重新锚定
+    if (pkt->pts == AV_NOPTS_VALUE)
+        return arrivalMs;
+    if (m_anchorPts != AV_NOPTS_VALUE) {
+        const qint64 predicted = m_anchorWallMs
+            + av_rescale_q(pkt->pts - m_anchorPts, m_timeBase, AVRational{1, 1000});
+        if (qAbs(predicted - arrivalMs) <= kResyncMs)
+            return predicted;
+    }
+    m_anchorPts = pkt->pts;
+    m_anchorWallMs = arrivalMs;
+    return arrivalMs;
+}
+
+void VideoRecorder::writePacket(AVPacket *pkt, qint64 arrivalMs)
+{
+    const qint64 wallMs = wallTimeFor(pkt, arrivalMs);
+    const bool key = pkt->flags & AV_PKT_FLAG_KEY;
+
+    // 跨入新的分段序号后，在第一个关键帧处切分
+    const qint64 index = wallMs / m_segmentMs.load(std::memory_order_relaxed);
+    if (key && (!m_output || index != m_segmentIndex)) {
+        closeSegment();
+        if (!openSegment(wallMs))
+            return;
+        m_segmentIndex = index;
+        m_writerNeedsKey = false;
+    }
+    if (!m_output || m_writerNeedsKey)
+        return;
+
+    // 时间戳以分段首包为零点；缺失的时间戳由墙钟补齐，并保证 dts 单调
+    if (pkt->dts == AV_NOPTS_VALUE)
+        pkt->dts = pkt->pts;
+    if (pkt->dts == AV_NOPTS_VALUE) {
+        pkt->pts = pkt->dts = av_rescale_q(wallMs - m_segmentStartMs, AVRational{1, 1000}, m_timeBase);
+    } else {
+        if (m_segmentFirstDts == AV_NOPTS_VALUE)
+            m_segmentFirstDts = pkt->dts;
+        pkt->dts -= m_segmentFirstDts;
+        pkt->pts = (pkt->pts == AV_NOPTS_VALUE) ? pkt->dts : pkt->pts - m_segmentFirstDts;
+    }
+    if (m_lastDts != AV_NOPTS_VALUE && pkt->dts <= m_lastDts) {
+        pkt->dts = m_lastDts + 1;
+        pkt->pts = qMax(pkt->pts, pkt->dts);
+    }
+    m_lastDts = pkt->dts;
+
+    AVStream *stream = m_output->streams[0];
+    pkt->stream_index = 0;
+    pkt->pos = -1;
+    av_packet_rescale_ts(pkt, m_timeBase, stream->time_base);
+
+    const int size = pkt->size;
+    if (av_write_frame(m_output, pkt) < 0) {
+        qDebug() << "Recorder: write failed, closing segment" << m_segmentFile;
+        closeSegment();
+        m_writerNeedsKey = true;
+        return;
+    }
+    ++m_segmentPackets;
+    m_segmentBytes += size;
+    m_segmentEndMs = wallMs;
+    m_bytesWritten.fetch_add(size, std::memory_order_relaxed);
+}
+
+bool VideoRecorder::openSegment(qint64 wallMs)
+{
+    if (!m_params)
+        return false;
+
+    const QString stamp = QDateTime::fromMSecsSinceEpoch(wallMs).toString("yyyyMMdd-HHmmss-zzz");
+    const QString path = QDir(m_dir).filePath(QString("%1-%2.mp4").arg(m_name, stamp));
+    const QByteArray pathUtf8 = path.toUtf8();
+
+    if (avformat_alloc_output_context2(&m_output, nullptr, "mp4", pathUtf8.constData()) < 0 || !m_output) {
+        qDebug() << "Recorder: cannot create muxer for" << path;
+        m_output = nullptr;
+        return false;
+    }
+
+    AVStream *stream = avformat_new_stream(m_output, nullptr);
+    if (!stream || avcodec_parameters_copy(stream->codecpar, m_params) < 0) {
+        avformat_free_context(m_output);
+        m_output = nullptr;
+        return false;
+    }
+    stream->codecpar->codec_tag = 0;    // 由 MP4 封装器选择标签（RTSP 的 tag 不一定适用）
+    stream->time_base = m_timeBase;
+
+    if (avio_open(&m_output->pb, pathUtf8.constData(), AVIO_FLAG_WRITE) < 0) {
+        qDebug() << "Recorder: cannot open" << path;
+        avformat_free_context(m_output);
+        m_output = nullptr;
+        return false;
+    }
+
+    // fragmented MP4：每个关键帧一个 moof 片段，程序异常退出时已写入的部分仍可播放
+    AVDictionary *options = nullptr;
+    av_dict_set(&options, "movflags", "frag_keyframe+empty_moov+default_base_moof", 0);
+    const int ret = avformat_write_header(m_output, &options);
+    av_dict_free(&options);
+    if (ret < 0) {
+        qDebug() << "Recorder: write header failed for" << path;
+        avio_closep(&m_output->pb);
+        avformat_free_context(m_output);
+        m_output = nullptr;
+        return false;
+    }
+
+    m_segmentFile = path;
+    m_segmentStartMs = wallMs;
+    m_segmentEndMs = wallMs;
+    m_segmentFirstDts = AV_NOPTS_VALUE;
+    m_lastDts = AV_NOPTS_VALUE;
+    m_segmentPackets = 0;
+    m_segmentBytes = 0;
+    {
+        QMutexLocker locker(&m_mutex);
+        m_currentFile = path;
+    }
+    return true;
+}
+
+void VideoRecorder::closeSegment()
+{
+    if (!m_output)
+        return;
+
+    av_write_trailer(m_output);
+    avio_closep(&m_output->pb);
+    avformat_free_context(m_output);
+    m_output = nullptr;
+
+    if (m_segmentPackets > 0) {
+        appendIndex();
+        m_segments.fetch_add(1, std::memory_order_relaxed);
+    }
+    m_segmentIndex = -1;
+}
+
+void VideoRecorder::appendIndex()
+{
+    // 分段索引：时间为 Unix 毫秒，与传感器日志同一时间基准
+    QFile file(QDir(m_dir).filePath(m_name + "-index.csv"));
+    const bool exists = file.exists();
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::Text)) {
+        qDebug() << "Recorder: cannot write index" << file.fileName();
+        return;
+    }
+    QTextStream out(&file);
+    if (!exists)
+        out << "segment_index,file,start_ms,end_ms,packets,bytes\n";
+    out << m_segmentIndex << ','
+        << QFileInfo(m_segmentFile).fileName() << ','
+        << m_segmentStartMs << ',' << m_segmentEndMs << ','
+        << m_segmentPackets << ',' << m_segmentBytes << '\n';
+}
+
+VideoRecorderStats VideoRecorder::stats() const
+{
+    VideoRecorderStats stats;
+    stats.recording = isRecording();
+    stats.segments = m_segments.load(std::memory_order_relaxed);
+    stats.bytesWritten = m_bytesWritten.load(std::memory_order_relaxed);
+    stats.dropped = m_dropped.load(std::memory_order_relaxed);
+    QMutexLocker locker(&m_mutex);
+    stats.currentFile = m_currentFile;
+    return stats;
+}
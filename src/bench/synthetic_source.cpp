@@ -0,0 +1,312 @@
+#include "bench/synthetic_source.h"
+#include <QDir>
+#include <QFileInfo>
+#include <QThread>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QDebug>
+#include <cstring>
+
+extern "C" {
+    #include <libavformat/avformat.h>
+    #include <libavcodec/avcodec.h>
+    #include <libavutil/opt.h>
+}
+
+// ============================================================
+// SyntheticSpec
+// ============================================================
+SyntheticSpec SyntheticSpec::forPreset(const QString &preset)
+{
+    SyntheticSpec spec;
+    spec.name = preset.toLower();
+    if (spec.name == "720p") {
+        spec.width = 1280;
+        spec.height = 720;
+        spec.bitRate = 4000000;
+    } else if (spec.name == "1080p") {
+        spec.width = 1920;
+        spec.height = 1080;
+        spec.bitRate = 8000000;
+    } else if (spec.name == "4k") {
+        spec.width = 3840;
+        spec.height = 2160;
+        spec.bitRate = 25000000;
+    }
+    return spec;
+}
+
+// ============================================================
+// SyntheticClip
+// ============================================================
+namespace {
+
+// 逐帧生成画面：对角渐变随时间平移，另有一个移动的方块，保证每帧都有运动残差
+void fillFrame(AVFrame *frame, int index)
+{
+    const int w = frame->width;
+    const int h = frame->height;
+    for (int y = 0; y < h; ++y) {
+        uint8_t *row = frame->data[0] + y * frame->linesize[0];
+        for (int x = 0; x < w; ++x)
+            row[x] = uint8_t(x + y + index * 3);
+    }
+    for (int y = 0; y < h / 2; ++y) {
+        uint8_t *u = frame->data[1] + y * frame->linesize[1];
+        uint8_t *v = frame->data[2] + y * frame->linesize[2];
+        for (int x = 0; x < w / 2; ++x) {
+            u[x] = uint8_t(128 + y + index * 2);
+            v[x] = uint8_t(64 + x + index * 5);
+        }
+    }
+
+    const int box = h / 6;
+    const int bx = (index * 8) % qMax(1, w - box);
+    const int by = (index * 5) % qMax(1, h - box);
+    for (int y = by; y < by + box; ++y)
+        memset(frame->data[0] + y * frame->linesize[0] + bx, 235, box);
+}
+
+bool drainEncoder(AVCodecContext *enc, AVFormatContext *out, AVStream *stream, AVPacket *pkt)
+{
+    int ret;
+    while ((ret = avcodec_receive_packet(enc, pkt)) >= 0) {
+        av_packet_rescale_ts(pkt, enc->time_base, stream->time_base);
+        pkt->stream_index = stream->index;
+        if (av_interleaved_write_frame(out, pkt) < 0)
+            return false;
+    }
+    return ret == AVERROR(EAGAIN) || ret == AVERROR_EOF;
+}
+
+} // namespace
+
+QString SyntheticClip::ensure(const SyntheticSpec &spec, const QString &dir, QString *error)
+{
+    if (!spec.isValid()) {
+        *error = "unknown synthetic preset: " + spec.name;
+        return QString();
+    }
+
+    // 优先 libx264（与摄像头同为 H.264），其次任意 H.264 编码器，最后 MPEG-4
+    const AVCodec *codec = avcodec_find_encoder_by_name("libx264");
+    if (!codec)
+        codec = avcodec_find_encoder(AV_CODEC_ID_H264);
+    if (!codec)
+        codec = avcodec_find_encoder(AV_CODEC_ID_MPEG4);
+    if (!codec) {
+        *error = "no H.264 or MPEG-4 encoder available";
+        return QString();
+    }
+
+    QDir().mkpath(dir);
+    const QString path = QDir(dir).filePath(QString("bench_%1_%2fps_%3s_%4.mp4")
+                                                .arg(spec.name).arg(spec.fps).arg(spec.seconds)
+                                                .arg(codec->name));
+    if (QFileInfo(path).size() > 0)
+        return path;
+
+    qDebug() << "Generating synthetic clip" << path;
+    const QByteArray pathUtf8 = path.toUtf8();
+    AVFormatContext *out = nullptr;
+    AVCodecContext *enc = nullptr;
+    AVFrame *frame = nullptr;
+    AVPacket *pkt = nullptr;
+    bool ok = false;
+
+    do {
+        if (avformat_alloc_output_context2(&out, nullptr, "mp4", pathUtf8.constData()) < 0)
+            break;
+        AVStream *stream = avformat_new_stream(out, nullptr);
+        enc = avcodec_alloc_context3(codec);
+        frame = av_frame_alloc();
+        pkt = av_packet_alloc();
+        if (!stream || !enc || !frame || !pkt)
+            break;
+
+        enc->width = spec.width;
+        enc->height = spec.height;
+        enc->pix_fmt = AV_PIX_FMT_YUV420P;
+        enc->time_base = AVRational{ 1, spec.fps };
+        enc->framerate = AVRational{ spec.fps, 1 };
+        enc->gop_size = spec.fps * 2;
+        enc->max_b_frames = 0;
+        enc->bit_rate = spec.bitRate;
+        if (out->oformat->flags & AVFMT_GLOBALHEADER)
+            enc->flags |= AV_CODEC_FLAG_GLOBAL_HEADER;
+        if (QByteArray(codec->name) == "libx264")
+            av_opt_set(enc->priv_data, "preset", "veryfast", 0);
+
+        if (avcodec_open2(enc, codec, nullptr) < 0
+            || avcodec_parameters_from_context(stream->codecpar, enc) < 0)
+            break;
+        stream->time_base = enc->time_base;
+
+        if (avio_open(&out->pb, pathUtf8.constData(), AVIO_FLAG_WRITE) < 0)
+            break;
+        if (avformat_write_header(out, nullptr) < 0)
+            break;
+
+        frame->format = enc->pix_fmt;
+        frame->width = enc->width;
+        frame->height = enc->height;
+        if (av_frame_get_buffer(frame, 0) < 0)
+            break;
+
+        bool encoded = true;
+        const int frames = spec.fps * spec.seconds;
+        for (int i = 0; i < frames && encoded; ++i) {
+            if (av_frame_make_writable(frame) < 0) {
+                encoded = false;
+                break;
+            }
+            fillFrame(frame, i);
+            frame->pts = i;
+            encoded = avcodec_send_frame(enc, frame) >= 0 && drainEncoder(enc, out, stream, pkt);
+        }
+        if (!encoded)
+            break;
+        avcodec_send_frame(enc, nullptr);
+        if (!drainEncoder(enc, out, stream, pkt))
+            break;
+        ok = av_write_trailer(out) >= 0;
+    } while (false);
+
+    av_packet_free(&pkt);
+    av_frame_free(&frame);
+    avcodec_free_context(&enc);
+    if (out) {
+        if (out->pb)
+            avio_closep(&out->pb);
+        avformat_free_context(out);
+    }
+
+    if (!ok) {
+        QFile::remove(path);
+        *error = "failed to encode synthetic clip " + path;
+        return QString();
+    }
+    return path;
+}
+
+// ============================================================
+// LoopbackStreamServer
+// ============================================================
+LoopbackStreamServer::~LoopbackStreamServer()
+{
+    stop();
+}
+
+bool LoopbackStreamServer::start(const QString &file, int port)
+{
+    if (m_thread)
+        return false;
+    m_file = file;
+    m_port = port;
+    m_stopped = false;
+    m_thread = QThread::create([this]() { serve(); });
+    m_thread->setObjectName("BenchLoopback");
+    m_thread->start();
+    return true;
+}
+
+void LoopbackStreamServer::stop()
+{
+    if (!m_thread)
+        return;
+    m_stopped = true;
+    m_thread->wait();
+    delete m_thread;
+    m_thread = nullptr;
+}
+
+QString LoopbackStreamServer::url() const
+{
+    return QString("tcp://127.0.0.1:%1").arg(m_port);
+}
+
+int LoopbackStreamServer::interruptCallback(void *opaque)
+{
+    return static_cast<LoopbackStreamServer *>(opaque)->m_stopped.load() ? 1 : 0;
+}
+
+void LoopbackStreamServer::serve()
+{
+    AVFormatContext *in = nullptr;
+    AVFormatContext *out = nullptr;
+    AVPacket *pkt = av_packet_alloc();
+    const QByteArray inPath = m_file.toUtf8();
+    const QByteArray outUrl = (url() + "?listen=1").toUtf8();
+
+    do {
+        if (!pkt || avformat_open_input(&in, inPath.constData(), nullptr, nullptr) < 0
+            || avformat_find_stream_info(in, nullptr) < 0)
+            break;
+        const int video = av_find_best_stream(in, AVMEDIA_TYPE_VIDEO, -1, -1, nullptr, 0);
+        if (video < 0)
+            break;
+        const AVStream *src = in->streams[video];
+
+        if (avformat_alloc_output_context2(&out, nullptr, "mpegts", outUrl.constData()) < 0)
+            break;
+        AVStream *dst = avformat_new_stream(out, nullptr);
+        if (!dst || avcodec_parameters_copy(dst->codecpar, src->codecpar) < 0)
+            break;
+        dst->codecpar->codec_tag = 0;
+        dst->time_base = src->time_base;
+
+        // 监听并等待解码器连接；stop() 通过中断回调打断等待
+        AVIOInterruptCB cb { &LoopbackStreamServer::interruptCallback, this };
+        if (avio_open2(&out->pb, outUrl.constData(), AVIO_FLAG_WRITE, &cb, nullptr) < 0)
+            break;
+        if (avformat_write_header(out, nullptr) < 0)
+            break;
+
+        // 按实时节奏推流；到结尾后回到开头，时间戳继续递增
+        QElapsedTimer clock;
+        clock.start();
+        int64_t offset = 0;
+        int64_t lastDts = 0;
+        const int64_t frameDuration = qMax<int64_t>(1, av_rescale_q(1, av_inv_q(src->avg_frame_rate.num ? src->avg_frame_rate : AVRational{30, 1}), src->time_base));
+        while (!m_stopped) {
+            const int ret = av_read_frame(in, pkt);
+            if (ret == AVERROR_EOF) {
+                offset = lastDts + frameDuration;
+                if (avformat_seek_file(in, video, INT64_MIN, 0, 0, 0) < 0)
+                    break;
+                continue;
+            }
+            if (ret < 0)
+                break;
+            if (pkt->stream_index != video) {
+                av_packet_unref(pkt);
+                continue;
+            }
+
+            if (pkt->pts != AV_NOPTS_VALUE)
+                pkt->pts += offset;
+            if (pkt->dts != AV_NOPTS_VALUE)
+                pkt->dts += offset;
+            lastDts = pkt->dts != AV_NOPTS_VALUE ? pkt->dts : lastDts + frameDuration;
+
+            const qint64 dueMs = av_rescale_q(lastDts, src->time_base, AVRational{1, 1000});
+            while (!m_stopped && clock.elapsed() < dueMs)
+                QThread::msleep(qMin<qint64>(5, dueMs - clock.elapsed()));
+
+            pkt->stream_index = 0;
+            pkt->pos = -1;
+            av_packet_rescale_ts(pkt, src->time_base, dst->time_base);
+            if (av_interleaved_write_frame(out, pkt) < 0)
+                break;      // 客户端断开
+        }
+        av_write_trailer(out);
+    } while (false);
+
+    av_packet_free(&pkt);
+    if (out) {
+        if (out->pb)
+            avio_closep(&out->pb);
+        avformat_free_context(out);
+    }
+    avformat_close_input(&in);
+}
@@ -0,0 +1,453 @@
+// video_bench —— 视频流水线基准测试
+//
+// 用本地文件、合成测试片段、lavfi 滤镜源或本机网络流替身驱动 FFmpegDecoder，
+// 测量每帧各级耗时（读包、解码、颜色转换、拷贝、显示交接）、持续帧率与每路 CPU 占用，
+// 结果以 JSON 输出，便于不同构建之间对比。
+//
+// 示例：
+//   video_bench --synthetic all                    720p / 1080p / 4K 合成片段，各 1 路
+//   video_bench --synthetic 1080p --streams 3      3 路 1080p 同时解码
+//   video_bench --synthetic 1080p --loopback       经本机 TCP 实时推流（含网络与节奏）
+//   video_bench --source clip.mp4 --output 960x540 按显示尺寸缩放输出
+//   video_bench --source "lavfi:testsrc2=size=1920x1080:rate=30"
+//   video_bench --synthetic 1080p --convert-threads 1,auto   单线程与切片多线程颜色转换对比
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QEventLoop>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QFile>
+#include <QFileInfo>
+#include <QTextStream>
+#include <QDir>
+#include <QThread>
+#include <QSysInfo>
+#include <QDebug>
+#include <memory>
+#include <vector>
+
+#ifdef Q_OS_WIN
+#include <windows.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#include "backend/ffmpegdecoder.h"
+#include "bench/synthetic_source.h"
+
+extern "C" {
+    #include <libavdevice/avdevice.h>
+    #include <libavutil/avutil.h>
+}
+
+namespace {
+
+// 基准结果的格式版本；字段含义变化时递增，避免误比较
+constexpr int kSchemaVersion = 1;
+constexpr int kLoopbackBasePort = 18554;
+
+double processCpuSeconds()
+{
+#ifdef Q_OS_WIN
+    FILETIME creation, exitTime, kernel, user;
+    if (!GetProcessTimes(GetCurrentProcess(), &creation, &exitTime, &kernel, &user))
+        return 0.0;
+    auto toSeconds = [](const FILETIME &ft) {
+        ULARGE_INTEGER v;
+        v.LowPart = ft.dwLowDateTime;
+        v.HighPart = ft.dwHighDateTime;
+        return v.QuadPart / 1e7;
+    };
+    return toSeconds(kernel) + toSeconds(user);
+#else
+    rusage usage {};
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_utime.tv_sec + usage.ru_utime.tv_usec / 1e6
+         + usage.ru_stime.tv_sec + usage.ru_stime.tv_usec / 1e6;
+#endif
+}
+
+/**
+ * @brief 多路同级耗时的合并（按帧数加权平均，取最大值）
+ */
+struct StageTotal {
+    quint64 count = 0;
+    double totalMs = 0.0;
+    double maxMs = 0.0;
+
+    void add(const VideoStageStats &s)
+    {
+        count += s.count;
+        totalMs += s.avgMs * s.count;
+        maxMs = qMax(maxMs, s.maxMs);
+    }
+    void addSample(double ms)
+    {
+        ++count;
+        totalMs += ms;
+        maxMs = qMax(maxMs, ms);
+    }
+    QJsonObject toJson() const
+    {
+        return QJsonObject{
+            { "avgMs", count ? totalMs / count : 0.0 },
+            { "maxMs", maxMs },
+            { "samples", double(count) },
+        };
+    }
+};
+
+struct BenchCase {
+    QString label;          // 结果中的名称（如 1080p、文件名）
+    QString url;            // 传给解码器的地址
+    QString file;           // 回环模式下推流的片段
+};
+
+struct BenchOptions {
+    int streams = 1;
+    int convertThreads = 0;     // 0 = 解码器自动选择
+    QImage::Format outputFormat = QImage::Format_RGB32;
+    int warmupMs = 1000;
+    int durationMs = 10000;
+    QSize outputSize;
+    bool loopback = false;
+    bool measureCopy = true;
+    bool governor = true;
+};
+
+struct FormatOption {
+    const char *name;
+    QImage::Format format;
+};
+
+// --output-format 可选值：模拟不同平台窗口后备缓冲的格式
+constexpr FormatOption kFormats[] = {
+    { "rgb32", QImage::Format_RGB32 },
+    { "argb32pm", QImage::Format_ARGB32_Premultiplied },
+    { "rgba8888", QImage::Format_RGBA8888_Premultiplied },
+    { "rgb16", QImage::Format_RGB16 },
+};
+
+QString formatName(QImage::Format format)
+{
+    for (const FormatOption &f : kFormats) {
+        if (f.format == format)
+            return QString::fromLatin1(f.name);
+    }
+    return QString::number(int(format));
+}
+
+QJsonObject runCase(const BenchCase &bench, const BenchOptions &opt)
+{
+    // 回环模式：每路一个推流端口
+    std::vector<std::unique_ptr<LoopbackStreamServer>> servers;
+    QStringList urls;
+    for (int i = 0; i < opt.streams; ++i) {
+        if (opt.loopback) {
+            auto server = std::make_unique<LoopbackStreamServer>();
+            server->start(bench.file, kLoopbackBasePort + i);
+            urls << server->url();
+            servers.push_back(std::move(server));
+        } else {
+            urls << bench.url;
+        }
+    }
+
+    std::vector<std::unique_ptr<FFmpegDecoder>> decoders;
+    StageTotal copy;
+    quint64 consumed = 0;
+    int finished = 0;       // 读到结尾或出错的路数
+    int width = 0;
+    int height = 0;
+
+    QEventLoop loop;
+    for (int i = 0; i < opt.streams; ++i) {
+        auto decoder = std::make_unique<FFmpegDecoder>();
+        decoder->setOutputSize(opt.outputSize);
+        decoder->setOutputFormat(opt.outputFormat);
+        decoder->setConvertThreads(opt.convertThreads);
+        decoder->setGovernorEnabled(opt.governor);
+        FFmpegDecoder *d = decoder.get();
+
+        // 模拟界面：取最新帧，并测量一次整帧深拷贝（旧的 QPixmap 路径的代价）
+        QObject::connect(d, &FFmpegDecoder::frameAvailable, &loop, [&, d]() {
+            QImage frame;
+            if (!d->takeFrame(frame))
+                return;
+            ++consumed;
+            width = frame.width();
+            height = frame.height();
+            if (opt.measureCopy) {
+                QElapsedTimer timer;
+                timer.start();
+                QImage deep = frame.copy();
+                copy.addSample(timer.nsecsElapsed() / 1e6);
+                Q_UNUSED(deep);
+            }
+        });
+        // 所有路都读完（文件源）或出错即结束本轮，计量窗口随之截止
+        QObject::connect(d, &FFmpegDecoder::stateChanged, &loop, [&](int state) {
+            if ((state == FFmpegDecoder::Stopped || state == FFmpegDecoder::Error)
+                && ++finished == opt.streams)
+                loop.quit();
+        });
+        decoders.push_back(std::move(decoder));
+    }
+
+    for (int i = 0; i < opt.streams; ++i)
+        decoders[i]->openStream(urls[i]);
+
+    // 预热：连接、首帧、缓存与线程调度稳定后再开始计量
+    QTimer::singleShot(opt.warmupMs, &loop, &QEventLoop::quit);
+    loop.exec();
+    if (finished == opt.streams) {
+        for (auto &d : decoders)
+            d->closeStream();
+        return QJsonObject{ { "label", bench.label },
+                            { "error", "source ended or failed during warm-up" } };
+    }
+
+    std::vector<VideoFrameStats> startFrames;
+    for (auto &d : decoders) {
+        d->pipelineStats();     // 丢弃预热期间的耗时
+        startFrames.push_back(d->frameStats());
+    }
+    copy = StageTotal();
+    consumed = 0;
+
+    QElapsedTimer wall;
+    wall.start();
+    const double cpuStart = processCpuSeconds();
+    QTimer::singleShot(opt.durationMs, &loop, &QEventLoop::quit);
+    loop.exec();
+    const double elapsedS = wall.nsecsElapsed() / 1e9;
+    const double cpuS = processCpuSeconds() - cpuStart;
+
+    StageTotal demux, decode, convert, handoff;
+    quint64 decoded = 0, displayed = 0, dropped = 0;
+    int convertThreads = 0;
+    double ttffMs = 0.0;
+    QJsonArray errors;
+    QJsonArray governors;
+    for (size_t i = 0; i < decoders.size(); ++i) {
+        FFmpegDecoder *d = decoders[i].get();
+        const DecodeGovernorStats gov = d->governorStats();
+        governors.append(QJsonObject{
+            { "adaptive", gov.adaptive },
+            { "threading", gov.sliceThreading ? "slice" : "frame" },
+            { "threads", gov.threads },
+            { "skipLevel", gov.skipLevel },
+            { "decodeLoad", gov.decodeLoad },
+            { "guiLoad", gov.guiLoad },
+            { "downgrades", double(gov.downgrades) },
+            { "upgrades", double(gov.upgrades) },
+            { "reconfigures", double(gov.reconfigures) },
+            { "lastDecision", gov.lastDecision },
+        });
+        const VideoPipelineStats pipe = d->pipelineStats();
+        demux.add(pipe.demux);
+        decode.add(pipe.decode);
+        convert.add(pipe.convert);
+        handoff.add(pipe.handoff);
+
+        const VideoFrameStats end = d->frameStats();
+        decoded += end.decoded - startFrames[i].decoded;
+        displayed += end.displayed - startFrames[i].displayed;
+        dropped += end.dropped - startFrames[i].dropped;
+        ttffMs = qMax(ttffMs, double(d->openStats().ttffMs));
+        convertThreads = qMax(convertThreads, d->convertThreads());
+
+        const VideoHealthStats health = d->healthStats();
+        if (health.decodeErrors || health.readErrors || health.timeouts)
+            errors.append(QJsonObject{ { "stream", int(i) },
+                                       { "decodeErrors", double(health.decodeErrors) },
+                                       { "readErrors", double(health.readErrors) },
+                                       { "timeouts", double(health.timeouts) } });
+        d->closeStream();
+    }
+    for (auto &server : servers)
+        server->stop();
+
+    const double perStreamFps = elapsedS > 0 ? decoded / elapsedS / opt.streams : 0.0;
+    QJsonObject result{
+        { "label", bench.label },
+        { "source", opt.loopback ? QString("loopback:%1").arg(bench.file) : bench.url },
+        { "streams", opt.streams },
+        { "outputWidth", width },
+        { "outputHeight", height },
+        { "outputFormat", formatName(opt.outputFormat) },
+        { "convertThreads", convertThreads },
+        { "seconds", elapsedS },
+        { "framesDecoded", double(decoded) },
+        { "framesDisplayed", double(displayed) },
+        { "framesDropped", double(dropped) },
+        { "fpsPerStream", perStreamFps },
+        { "displayFps", elapsedS > 0 ? consumed / elapsedS : 0.0 },
+        { "cpuPercentPerStream", elapsedS > 0 ? cpuS / elapsedS * 100.0 / opt.streams : 0.0 },
+        { "ttffMs", ttffMs },
+        { "governor", governors },
+        { "stages", QJsonObject{
+              { "demux", demux.toJson() },
+              { "decode", decode.toJson() },
+              { "convert", convert.toJson() },
+              { "copy", copy.toJson() },
+              { "handoff", handoff.toJson() },
+          } },
+    };
+    if (!errors.isEmpty())
+        result.insert("errors", errors);
+    return result;
+}
+
+QJsonObject buildInfo()
+{
+    // 对比不同构建时需要的环境信息
+    return QJsonObject{
+        { "schema", kSchemaVersion },
+        { "ffmpeg", QString::fromLatin1(av_version_info()) },
+        { "avcodec", QString::number(avcodec_version()) },
+        { "qt", QString::fromLatin1(qVersion()) },
+        { "compiler",
+#if defined(_MSC_VER)
+          QString("msvc %1").arg(_MSC_VER)
+#elif defined(__clang__)
+          QString("clang %1").arg(__clang_version__)
+#elif defined(__GNUC__)
+          QString("gcc %1").arg(__VERSION__)
+#else
+          QString("unknown")
+#endif
+        },
+#ifdef NDEBUG
+        { "buildType", "release" },
+#else
+        { "buildType", "debug" },
+#endif
+        { "cpu", QSysInfo::currentCpuArchitecture() },
+        { "os", QSysInfo::prettyProductName() },
+        { "logicalCores", QThread::idealThreadCount() },
+    };
+}
+
+} // namespace
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("video_bench");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Video pipeline benchmark for FFmpegDecoder");
+    parser.addHelpOption();
+    parser.addOptions({
+        { "source", "Input URL or file (lavfi:<graph> for filter sources).", "url" },
+        { "synthetic", "Synthetic H.264 clip: 720p, 1080p, 4k or all.", "preset" },
+        { "loopback", "Serve the clip over local TCP at real-time pace instead of reading the file." },
+        { "streams", "Number of concurrent decoders.", "n", "1" },
+        { "warmup", "Warm-up seconds excluded from measurement.", "s", "1" },
+        { "duration", "Measured seconds.", "s", "10" },
+        { "output", "Decoder output size WxH (default: source size).", "size" },
+        { "clip-dir", "Directory for cached synthetic clips.", "dir" },
+        { "no-copy", "Skip the per-frame deep-copy measurement." },
+        { "no-governor", "Fixed frame threading at full quality instead of the adaptive decode governor." },
+        { "convert-threads", "Colour conversion threads, comma-separated to compare (e.g. 1,auto).", "list", "auto" },
+        { "output-format", "Display surface format: rgb32, argb32pm, rgba8888 or rgb16.", "format", "rgb32" },
+        { "json", "Write the JSON report to this file instead of stdout.", "file" },
+    });
+    parser.process(app);
+
+    avdevice_register_all();    // lavfi 输入
+
+    BenchOptions opt;
+    opt.streams = qMax(1, parser.value("streams").toInt());
+    opt.warmupMs = int(parser.value("warmup").toDouble() * 1000);
+    opt.durationMs = qMax(1000, int(parser.value("duration").toDouble() * 1000));
+    opt.loopback = parser.isSet("loopback");
+    opt.measureCopy = !parser.isSet("no-copy");
+    opt.governor = !parser.isSet("no-governor");
+    bool formatKnown = false;
+    for (const FormatOption &f : kFormats) {
+        if (parser.value("output-format") == QLatin1String(f.name)) {
+            opt.outputFormat = f.format;
+            formatKnown = true;
+        }
+    }
+    if (!formatKnown) {
+        qCritical() << "Unknown --output-format" << parser.value("output-format");
+        return 1;
+    }
+    QList<int> threadSettings;
+    for (const QString &t : parser.value("convert-threads").split(',', Qt::SkipEmptyParts))
+        threadSettings << (t.trimmed() == "auto" ? 0 : qMax(1, t.toInt()));
+    if (threadSettings.isEmpty())
+        threadSettings << 0;
+    if (parser.isSet("output")) {
+        const QStringList wh = parser.value("output").split('x');
+        if (wh.size() == 2)
+            opt.outputSize = QSize(wh[0].toInt(), wh[1].toInt());
+    }
+
+    QList<BenchCase> cases;
+    if (parser.isSet("synthetic")) {
+        const QString clipDir = parser.isSet("clip-dir")
+            ? parser.value("clip-dir") : QDir::temp().filePath("video_bench");
+        const QString preset = parser.value("synthetic").toLower();
+        const QStringList presets = preset == "all" ? QStringList{ "720p", "1080p", "4k" } : QStringList{ preset };
+        for (const QString &p : presets) {
+            QString error;
+            const QString file = SyntheticClip::ensure(SyntheticSpec::forPreset(p), clipDir, &error);
+            if (file.isEmpty()) {
+                qCritical() << error;
+                return 1;
+            }
+            cases.append(BenchCase{ p, file, file });
+        }
+    } else if (parser.isSet("source")) {
+        const QString source = parser.value("source");
+        if (opt.loopback && (source.contains("://") || source.startsWith("lavfi:"))) {
+            qCritical() << "--loopback needs a local file source";
+            return 1;
+        }
+        cases.append(BenchCase{ QFileInfo(source).fileName(), source, source });
+    } else {
+        parser.showHelp(1);
+    }
+
+    QJsonArray results;
+    for (const BenchCase &c : cases) {
+        // 同一片段依次用各转换线程设置测量；第一个设置作为基准，其余给出转换级加速比
+        double baselineConvertMs = 0.0;
+        for (int i = 0; i < threadSettings.size(); ++i) {
+            opt.convertThreads = threadSettings[i];
+            qInfo() << "Benchmarking" << c.label << "x" << opt.streams << (opt.loopback ? "(loopback)" : "")
+                    << "convert threads:" << (opt.convertThreads ? QString::number(opt.convertThreads) : QString("auto"));
+            QJsonObject result = runCase(c, opt);
+            const double convertMs = result["stages"].toObject()["convert"].toObject()["avgMs"].toDouble();
+            if (i == 0) {
+                baselineConvertMs = convertMs;
+            } else if (baselineConvertMs > 0.0 && convertMs > 0.0) {
+                result.insert("convertSpeedup", baselineConvertMs / convertMs);
+                qInfo() << "  convert" << baselineConvertMs << "ms ->" << convertMs << "ms per frame";
+            }
+            results.append(result);
+        }
+    }
+
+    const QJsonObject report{ { "build", buildInfo() }, { "results", results } };
+    const QByteArray json = QJsonDocument(report).toJson(QJsonDocument::Indented);
+    if (parser.isSet("json")) {
+        QFile out(parser.value("json"));
+        if (!out.open(QIODevice::WriteOnly)) {
+            qCritical() << "Cannot write" << out.fileName();
+            return 1;
+        }
+        out.write(json);
+    } else {
+        QTextStream(stdout) << json;
+    }
+    return 0;
+}
@@ -11,27 +11,31 @@
  * 增加一个定时器用于渐变推进显示
  */
 EngineBarWidget::EngineBarWidget(QWidget* parent)
-    : QWidget(parent)
+    : ThreadedGaugeWidget(parent)
 {
     setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
 
     // --- 平滑动画定时器 ---
-    QTimer* timer = new QTimer(this);
-    connect(timer, &QTimer::timeout, this, [this]() {
+    smoothTimer_ = new QTimer(this);
+    connect(smoothTimer_, &QTimer::timeout, this, [this]() {
 
         // 平滑系数（越小越平滑，越大越灵敏）
         const double alpha = 0.10;
 
-        // 核心缓动算法：逐步逼近目标值
+        // 核心缓动算法：逐步逼近目标值；足够接近时对齐目标并停止，静止时不再重绘
         displayValue_ += (value_ - displayValue_) * alpha;
+        if (qAbs(value_ - displayValue_) < 0.05) {
+            displayValue_ = value_;
+            smoothTimer_->stop();
+        }
 
         // // 输出调试信息
         // qDebug() << "[EngineBarWidget] Target:" << value_
         //          << " Display:" << displayValue_;
 
-        update(); // 刷新界面
+        requestRepaint(); // 刷新界面
     });
-    timer->start(16); // ~60 FPS 刷新
+    smoothTimer_->setInterval(16); // ~60 FPS 刷新，目标值变化时启动
 }
 
 /**
@@ -42,18 +46,29 @@ void EngineBarWidget::setValue(double v)
 {
     v = qBound(-100.0, v, 100.0);
     value_ = v;
+    if (v != displayValue_ && !smoothTimer_->isActive())
+        smoothTimer_->start();
 
     // qDebug() << "[EngineBarWidget] setValue received:" << v;
 }
 
 /**
- * @brief 绘制刻度线 + 数字 + 双向能量条（使用 displayValue_）
+ * @brief 数据快照：按值捕获当前平滑显示值
  */
-void EngineBarWidget::paintEvent(QPaintEvent*)
+ThreadedGaugeWidget::SceneFn EngineBarWidget::snapshotScene() const
+{
+    return [displayValue = displayValue_](QPainter& p, const QSize& size) {
+        paintScene(p, size, displayValue);
+    };
+}
+
+/**
+ * @brief 绘制刻度线 + 数字 + 双向能量条（使用平滑显示值）
+ */
+void EngineBarWidget::paintScene(QPainter& p, const QSize& size, double displayValue)
 {
-    QPainter p(this);
     p.setRenderHint(QPainter::Antialiasing);
-    p.fillRect(rect(), QColor(0, 0, 0));
+    p.fillRect(QRect(QPoint(0, 0), size), QColor(0, 0, 0));
 
     // ---------- 绘图边界 ----------
     const double marginLeft   = 10.0;
@@ -61,7 +76,7 @@ void EngineBarWidget::paintEvent(QPaintEvent*)
     const double marginTop    = 20.0;
     const double marginBottom = 20.0;
     const double drawLeft     = marginLeft;
-    const double drawRight    = width() - marginRight;
+    const double drawRight    = size.width() - marginRight;
 
     // ---------- 布局参数 ----------
     const double labelWidth   = 56.0;
@@ -76,14 +91,14 @@ void EngineBarWidget::paintEvent(QPaintEvent*)
     const int tickCount = (maxV - minV) / step + 1;
     const double tickSpacing = 36.0;
     const double totalHeight = (tickCount - 1) * tickSpacing;
-    const double centerY = height() / 2.0;
+    const double centerY = size.height() / 2.0;
     const double drawTop = centerY - totalHeight / 2.0;
     const double drawBottom = centerY + totalHeight / 2.0;
 
     // ---------- 字体 ----------
-    QFont tickFont("Arial", 11, QFont::Bold);
-    p.setFont(tickFont);
-    QFontMetrics fm(tickFont);
+    thread_local const QFont kTickFont("Arial", 11, QFont::Bold);  // 每个线程只构造一次
+    p.setFont(kTickFont);
+    QFontMetrics fm = p.fontMetrics();
     QPen tickPen(QColor(255, 255, 255), 2.0);
     p.setPen(tickPen);
 
@@ -106,10 +121,10 @@ void EngineBarWidget::paintEvent(QPaintEvent*)
     p.drawLine(QPointF(scaleX1, zeroY), QPointF(scaleX2, zeroY));
 
     // ---------- 3. 绘制平滑能量条 ----------
-    double ratio = std::abs(displayValue_) / 100.0;
+    double ratio = std::abs(displayValue) / 100.0;
 
     double yTop, yBottom;
-    if (displayValue_ >= 0) {
+    if (displayValue >= 0) {
         yTop = zeroY - ratio * (zeroY - drawTop);
         yBottom = zeroY;
     } else {
@@ -6,7 +6,7 @@
  * @brief 构造函数：初始化平滑计时器
  */
 RudderGaugeWidget::RudderGaugeWidget(QWidget* parent)
-    : QWidget(parent)
+    : ThreadedGaugeWidget(parent)
 {
     setAttribute(Qt::WA_OpaquePaintEvent);
     setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Preferred);
@@ -19,17 +19,21 @@ RudderGaugeWidget::RudderGaugeWidget(QWidget* parent)
         // 平滑系数：越小越柔和（真实舵机惯性）
         const double alpha = 0.10;   // 10% 逼近目标，可调 0.05~0.2
 
-        // 更新显示值（缓动）
+        // 更新显示值（缓动）；足够接近时对齐目标并停止，静止时不再重绘
         displayAngle_ += (targetAngle_ - displayAngle_) * alpha;
+        if (qAbs(targetAngle_ - displayAngle_) < 0.05) {
+            displayAngle_ = targetAngle_;
+            smoothTimer_->stop();
+        }
 
         // // Debug 输出
         // qDebug() << "[Rudder] Target:" << targetAngle_
         //          << " Display:" << displayAngle_;
 
-        update();
+        requestRepaint();
     });
 
-    smoothTimer_->start(16); // ~100 FPS
+    smoothTimer_->setInterval(16); // ~60 FPS，目标值变化时启动
 }
 
 /**
@@ -39,35 +43,49 @@ void RudderGaugeWidget::setRudderAngle(double val)
 {
     val = qBound(-90.0, val, 90.0);  // 限幅
     targetAngle_ = val;
+    if (val != displayAngle_ && !smoothTimer_->isActive())
+        smoothTimer_->start();
 
     // qDebug() << "[Rudder] Command angle:" << val;
 }
 
+/**
+ * @brief 数据快照：按值捕获当前平滑舵角
+ */
+ThreadedGaugeWidget::SceneFn RudderGaugeWidget::snapshotScene() const
+{
+    return [displayAngle = displayAngle_](QPainter& p, const QSize& size) {
+        paintScene(p, size, displayAngle);
+    };
+}
+
 /**
  * @brief 绘制舵角仪表
  */
-void RudderGaugeWidget::paintEvent(QPaintEvent*)
+void RudderGaugeWidget::paintScene(QPainter& p, const QSize& size, double displayAngle)
 {
-    QPainter p(this);
     p.setRenderHint(QPainter::Antialiasing);
-    p.fillRect(rect(), Qt::black);
+    p.fillRect(QRect(QPoint(0, 0), size), Qt::black);
+
+    const int w = size.width();
+    const int h = size.height();
 
-    const int w = width();
-    const int h = height();
+    // 字体按线程缓存：QFont 内部数据首次使用时才填充，渲染线程之间不能共用
+    thread_local const QFont kTitleFont("Arial", 18, QFont::Bold);
+    thread_local const QFont kValueFont("Arial", 38, QFont::Bold);
+    thread_local const QFont kTickFont("Arial", 10, QFont::Bold);
 
     // ========== 标题 ==========
-    QFont titleFont("Arial", 18, QFont::Bold);
-    p.setFont(titleFont);
+    p.setFont(kTitleFont);
     p.setPen(QColor("#9E9E9E"));
     p.drawText(10, 30, "RUDDER");
 
     // ========== 显示角度值 ==========
-    QFont valueFont("Arial", 38, QFont::Bold);
-    p.setFont(valueFont);
+    p.setFont(kValueFont);
     p.setPen(Qt::white);
 
     // 角度显示值，可以显示 -90° 到 90°
-    QString angleText = QString::number(fabs(displayAngle_), 'f', 0) + "°";
+    QString angleText = QString::number(fabs(displayAngle), 'f', 0) + "°";
     p.drawText(QRect(0, 35, w, 60), Qt::AlignCenter, angleText);
 
     // ========== 画刻度线 ==========
@@ -77,7 +95,7 @@ void RudderGaugeWidget::paintEvent(QPaintEvent*)
 
     QPen tickPen(Qt::white, 2);
     p.setPen(tickPen);
-    p.setFont(QFont("Arial", 10, QFont::Bold));
+    p.setFont(kTickFont);
 
     for (int a = -maxAng; a <= maxAng; a += 10)
     {
@@ -94,7 +112,7 @@ void RudderGaugeWidget::paintEvent(QPaintEvent*)
 
     // ========== 绿色舵角条 ==========
     // 绿色舵角条最大范围限制为 ±40°，即使实时角度超过这个范围
-    double limitedAngle = qBound(-40.0, displayAngle_, 40.0);  // 限制范围在 -40 到 40° 之间
+    double limitedAngle = qBound(-40.0, displayAngle, 40.0);  // 限制范围在 -40 到 40° 之间
     double ratio = limitedAngle / 40.0;  // 比例计算范围为 ±40°
     double barX = w / 2 + ratio * (4 * spacing);  // 推算绿色舵角条的宽度
     double barW = 18, barH = 10;
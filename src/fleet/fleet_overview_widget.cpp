@@ -0,0 +1,263 @@
+#include "fleet/fleet_overview_widget.h"
+#include "fleet/fleet_state.h"
+#include <QPainter>
+#include <QScrollBar>
+#include <QMouseEvent>
+#include <QPaintEvent>
+#include <QElapsedTimer>
+#include <QtMath>
+
+namespace {
+const QColor kTileColor(24, 24, 24);
+const QColor kFrameColor(80, 80, 80);
+const QColor kCaptionColor("#9E9E9E");
+
+// 卡片内部布局（相对卡片左上角）
+constexpr int kDialCx = 42;
+constexpr int kDialCy = 66;
+constexpr int kDialR  = 28;
+constexpr int kCaptionX = 88;
+constexpr int kValueX   = 130;
+constexpr int kRowHdg = 50;
+constexpr int kRowSog = 72;
+constexpr int kRowRp  = 94;
+}
+
+FleetOverviewWidget::FleetOverviewWidget(FleetState *fleet, QWidget *parent)
+    : QAbstractScrollArea(parent)
+    , fleet_(fleet)
+    , frameTimer_(new QTimer(this))
+    , nameFont_("Arial", 12, QFont::Bold)
+    , valueFont_("Arial", 11, QFont::Bold)
+{
+    setWindowTitle("船队总览");
+    resize(4 * (kTileW + kSpacing) + kSpacing + 20, 600);
+
+    viewport()->setAttribute(Qt::WA_OpaquePaintEvent);
+    setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+    verticalScrollBar()->setSingleStep(kTileH / 2);
+
+    frameTimer_->setInterval(kFrameIntervalMs);
+    connect(frameTimer_, &QTimer::timeout, this, &FleetOverviewWidget::onFrameTick);
+}
+
+int FleetOverviewWidget::columns() const
+{
+    return qMax(1, (viewport()->width() - kSpacing) / (kTileW + kSpacing));
+}
+
+QRect FleetOverviewWidget::tileRect(int index) const
+{
+    const int cols = columns();
+    const int row = index / cols;
+    const int col = index % cols;
+    return QRect(kSpacing + col * (kTileW + kSpacing),
+                 kSpacing + row * (kTileH + kSpacing) - verticalScrollBar()->value(),
+                 kTileW, kTileH);
+}
+
+int FleetOverviewWidget::tileAt(const QPoint &pos) const
+{
+    const int cols = columns();
+    const int y = pos.y() + verticalScrollBar()->value() - kSpacing;
+    const int x = pos.x() - kSpacing;
+    if (x < 0 || y < 0)
+        return -1;
+    const int col = x / (kTileW + kSpacing);
+    const int row = y / (kTileH + kSpacing);
+    if (col >= cols || x % (kTileW + kSpacing) >= kTileW || y % (kTileH + kSpacing) >= kTileH)
+        return -1;
+    const int idx = row * cols + col;
+    return idx < fleet_->count() ? idx : -1;
+}
+
+void FleetOverviewWidget::updateScrollRange()
+{
+    const int rows = (fleet_->count() + columns() - 1) / columns();
+    const int contentH = kSpacing + rows * (kTileH + kSpacing);
+    verticalScrollBar()->setPageStep(viewport()->height());
+    verticalScrollBar()->setRange(0, qMax(0, contentH - viewport()->height()));
+}
+
+// ============================================================
+// 共享静态资源：卡片边框 + 航向刻度圈 + 标题文字，只渲染一次
+// ============================================================
+const QPixmap &FleetOverviewWidget::tileBackground()
+{
+    const qreal dpr = devicePixelRatioF();
+    if (!tileBg_.isNull() && qFuzzyCompare(tileBg_.devicePixelRatio(), dpr))
+        return tileBg_;
+
+    tileBg_ = QPixmap(QSize(kTileW, kTileH) * dpr);
+    tileBg_.setDevicePixelRatio(dpr);
+    tileBg_.fill(Qt::black);
+
+    QPainter p(&tileBg_);
+    p.setRenderHint(QPainter::Antialiasing, true);
+    p.setPen(QPen(kFrameColor, 1));
+    p.setBrush(kTileColor);
+    p.drawRoundedRect(QRectF(0.5, 0.5, kTileW - 1, kTileH - 1), 6, 6);
+
+    // 航向刻度圈
+    p.setBrush(Qt::NoBrush);
+    p.setPen(QPen(QColor(150, 160, 170), 1.5));
+    p.drawEllipse(QPointF(kDialCx, kDialCy), kDialR, kDialR);
+    for (int a = 0; a < 360; a += 45) {
+        const double rad = qDegreesToRadians(double(a));
+        const double len = (a % 90 == 0) ? 6.0 : 3.0;
+        p.drawLine(QPointF(kDialCx + kDialR * std::sin(rad), kDialCy - kDialR * std::cos(rad)),
+                   QPointF(kDialCx + (kDialR - len) * std::sin(rad), kDialCy - (kDialR - len) * std::cos(rad)));
+    }
+
+    // 标题文字
+    p.setFont(QFont("Arial", 9, QFont::Bold));
+    p.setPen(kCaptionColor);
+    p.drawText(kCaptionX, kRowHdg, "HDG");
+    p.drawText(kCaptionX, kRowSog, "SOG");
+    p.drawText(kCaptionX, kRowRp,  "R/P");
+    p.end();
+
+    return tileBg_;
+}
+
+// ============================================================
+// 单张卡片：底图 + 动态数值
+// ============================================================
+void FleetOverviewWidget::drawTile(QPainter &p, const QRect &rc, int index)
+{
+    const BoatTelemetry &b = fleet_->boat(index);
+
+    p.drawPixmap(rc.topLeft(), tileBackground());
+
+    // 船名
+    p.setFont(nameFont_);
+    p.setPen(Qt::white);
+    p.drawText(rc.left() + 10, rc.top() + 22, b.name);
+
+    // 链路状态灯
+    QColor linkColor;
+    switch (fleet_->linkHealth(index)) {
+    case FleetState::LinkHealth::Good:  linkColor = QColor(0, 220, 0);   break;
+    case FleetState::LinkHealth::Stale: linkColor = QColor(230, 180, 0); break;
+    case FleetState::LinkHealth::Lost:  linkColor = QColor(220, 40, 40); break;
+    }
+    p.setPen(Qt::NoPen);
+    p.setBrush(linkColor);
+    p.drawEllipse(QPointF(rc.right() - 14, rc.top() + 16), 5, 5);
+
+    // 航向指针
+    const double rad = qDegreesToRadians(b.heading);
+    const QPointF c(rc.left() + kDialCx, rc.top() + kDialCy);
+    const QPointF tip(c.x() + (kDialR - 4) * std::sin(rad), c.y() - (kDialR - 4) * std::cos(rad));
+    p.setPen(QPen(QColor(0, 255, 0), 2.5, Qt::SolidLine, Qt::RoundCap));
+    p.drawLine(c, tip);
+
+    // 数值
+    p.setFont(valueFont_);
+    p.setPen(Qt::white);
+    p.drawText(rc.left() + kValueX, rc.top() + kRowHdg, QString::number(b.heading, 'f', 0) + "°");
+    p.drawText(rc.left() + kValueX, rc.top() + kRowSog, QString::number(b.speedKn, 'f', 1) + " Kn");
+    p.drawText(rc.left() + kValueX, rc.top() + kRowRp,
+               QString::number(b.roll, 'f', 1) + "/" + QString::number(b.pitch, 'f', 1));
+}
+
+void FleetOverviewWidget::paintEvent(QPaintEvent *event)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    QPainter p(viewport());
+    p.fillRect(event->rect(), Qt::black);
+    p.setRenderHint(QPainter::Antialiasing, true);
+
+    // 虚拟化：只遍历与重绘区域相交的行
+    const int cols = columns();
+    const int scrollY = verticalScrollBar()->value();
+    const int rowH = kTileH + kSpacing;
+    const int firstRow = qMax(0, (event->rect().top() + scrollY - kSpacing) / rowH);
+    const int lastRow = (event->rect().bottom() + scrollY - kSpacing) / rowH;
+    const int count = fleet_->count();
+
+    for (int row = firstRow; row <= lastRow; ++row) {
+        for (int col = 0; col < cols; ++col) {
+            const int idx = row * cols + col;
+            if (idx >= count)
+                break;
+            const QRect rc = tileRect(idx);
+            if (rc.intersects(event->rect()))
+                drawTile(p, rc, idx);
+        }
+    }
+
+    lastPaintMs_ = timer.nsecsElapsed() / 1e6;
+    maxPaintMs_ = qMax(maxPaintMs_, lastPaintMs_);
+}
+
+// ============================================================
+// 帧定时：取走脏卡片，合并为一个重绘区域
+// ============================================================
+void FleetOverviewWidget::onFrameTick()
+{
+    const QVector<int> dirty = fleet_->takeDirty();
+
+    if (fleet_->count() != knownCount_) {
+        knownCount_ = fleet_->count();
+        updateScrollRange();
+        viewport()->update();
+    } else if (++frameCounter_ % (1000 / kFrameIntervalMs) == 0) {
+        // 每秒整体刷新一次，让链路状态灯随数据老化变色
+        viewport()->update();
+    } else {
+        const QRect visible = viewport()->rect();
+        QRegion region;
+        for (int idx : dirty) {
+            const QRect rc = tileRect(idx);
+            if (rc.intersects(visible))
+                region += rc;
+        }
+        if (!region.isEmpty())
+            viewport()->update(region);
+    }
+
+    // 每秒在标题显示船只数量与绘制耗时
+    const qint64 now = fleet_->nowMs();
+    if (now - titleUpdatedMs_ >= 1000) {
+        titleUpdatedMs_ = now;
+        setWindowTitle(QString("船队总览 — %1 艘  绘制 %2 ms (峰值 %3 ms)")
+                           .arg(knownCount_)
+                           .arg(lastPaintMs_, 0, 'f', 2)
+                           .arg(maxPaintMs_, 0, 'f', 2));
+        maxPaintMs_ = 0.0;
+    }
+}
+
+void FleetOverviewWidget::resizeEvent(QResizeEvent *event)
+{
+    QAbstractScrollArea::resizeEvent(event);
+    updateScrollRange();
+}
+
+void FleetOverviewWidget::scrollContentsBy(int, int)
+{
+    viewport()->update();
+}
+
+void FleetOverviewWidget::mouseDoubleClickEvent(QMouseEvent *event)
+{
+    const int idx = tileAt(event->position().toPoint());
+    if (idx >= 0)
+        emit boatActivated(fleet_->boat(idx).name);
+}
+
+void FleetOverviewWidget::showEvent(QShowEvent *event)
+{
+    QAbstractScrollArea::showEvent(event);
+    knownCount_ = -1;   // 强制下一帧重新布局
+    frameTimer_->start();
+}
+
+void FleetOverviewWidget::hideEvent(QHideEvent *event)
+{
+    QAbstractScrollArea::hideEvent(event);
+    frameTimer_->stop();   // 不可见时不消耗绘制预算
+}
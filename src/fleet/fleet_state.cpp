@@ -0,0 +1,88 @@
+#include "fleet/fleet_state.h"
+#include "backend/sensor_math.h"
+#include <QDebug>
+#include <cmath>
+
+FleetState::FleetState(QObject *parent)
+    : QObject(parent)
+{
+    clock_.start();
+}
+
+int FleetState::ensureBoat(const QString &name)
+{
+    auto it = index_.constFind(name);
+    if (it != index_.constEnd())
+        return it.value();
+
+    const int idx = boats_.size();
+    BoatTelemetry boat;
+    boat.name = name;
+    boat.rateWindowStartMs = nowMs();
+    boats_.append(boat);
+    index_.insert(name, idx);
+
+    qDebug() << "[FLEET] 发现新船只:" << name;
+    emit boatAdded(name);
+    return idx;
+}
+
+void FleetState::onSensorData(const QString &boatName, const QString &sensorType,
+                              const QJsonObject &data)
+{
+    const int idx = ensureBoat(boatName);
+    BoatTelemetry &b = boats_[idx];
+    const qint64 now = nowMs();
+
+    if (sensorType == QLatin1String("imu")) {
+        const EulerAngles e = eulerFromImuJson(data);
+        b.roll = e.roll;
+        b.pitch = e.pitch;
+        b.heading = std::fmod(e.yaw + 360.0, 360.0);
+    } else if (sensorType == QLatin1String("gps")) {
+        b.latitude = data.value("latitude").toDouble(0.0);
+        b.longitude = data.value("longitude").toDouble(0.0);
+    } else if (sensorType == QLatin1String("speed")) {
+        b.speedKn = data.value("speed_knots").toDouble(0.0);
+    } else {
+        return;
+    }
+
+    // 消息速率（1 秒窗口）
+    b.lastUpdateMs = now;
+    ++b.rateWindowCount;
+    const qint64 window = now - b.rateWindowStartMs;
+    if (window >= 1000) {
+        b.msgRate = b.rateWindowCount * 1000.0 / window;
+        b.rateWindowCount = 0;
+        b.rateWindowStartMs = now;
+    }
+
+    if (!b.dirty) {
+        b.dirty = true;
+        dirty_.append(idx);
+    }
+}
+
+QVector<int> FleetState::takeDirty()
+{
+    QVector<int> out;
+    out.swap(dirty_);
+    for (int idx : out)
+        boats_[idx].dirty = false;
+    dirty_.reserve(out.size());
+    return out;
+}
+
+FleetState::LinkHealth FleetState::linkHealth(int index) const
+{
+    const qint64 last = boats_.at(index).lastUpdateMs;
+    if (last < 0)
+        return LinkHealth::Lost;
+    const qint64 age = nowMs() - last;
+    if (age <= 2000)
+        return LinkHealth::Good;
+    if (age <= 5000)
+        return LinkHealth::Stale;
+    return LinkHealth::Lost;
+}
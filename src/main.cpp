@@ -11,9 +11,17 @@
 
 #include "backend/mqttclient.h"
 #include "backend/ruddercontroller.h"
+#include "backend/controlscheduler.h"
+#include "backend/inputshaping.h"
+#include "backend/sensor_math.h"
 #include "main_window.h"
 #include <SDL2/SDL.h>
 #include "video/video_player_window.h"
+#include "render/threaded_gauge_widget.h"
+#include "fleet/fleet_state.h"
+#include "fleet/fleet_overview_widget.h"
+#include "track/track_store.h"
+#include "track/track_plot_widget.h"
 
 class ControllerBridge : public QObject
 {
@@ -38,14 +46,41 @@ public:
         connect(m_mqttClient, &MqttClient::connectionStateChanged,
                 this, &ControllerBridge::onMqttStateChanged);
 
+        // 当前船只的输入整形配置
+        m_inputShaper.setConfig(InputShapingConfig::load(m_mqttClient->getCurrentBoat()));
+
+        // 固定频率控制循环：按设定频率取最新摇杆状态发布推力指令，与手柄采样频率解耦
+        if (ControlScheduler::defaultRate() > 0.0) {
+            m_scheduler = new ControlScheduler(m_rudderController, this);
+            m_scheduler->setShaper([this](const RudderState &state, double periodSeconds) {
+                return toCommand(m_inputShaper.shape(state, periodSeconds));
+            });
+            connect(m_scheduler, &ControlScheduler::commandReady,
+                    this, &ControllerBridge::onThrusterCommand);
+        }
+
+        connect(m_rudderController, &QThread::finished,
+                this, &ControllerBridge::logControlLatency);
+
+        m_diagnosticsTimer = new QTimer(this);
+        connect(m_diagnosticsTimer, &QTimer::timeout, this, &ControllerBridge::updateControlDiagnostics);
+        m_diagnosticsTimer->start(1000);
+
         // 启动手柄检测线程
         m_rudderController->start();
+        if (m_scheduler)
+            m_scheduler->start(QThread::TimeCriticalPriority);
 
         qDebug() << "控制器桥接器初始化完成";
     }
 
     ~ControllerBridge()
     {
+        // 控制线程使用 m_inputShaper，须在成员析构前结束
+        if (m_scheduler) {
+            m_scheduler->stop();
+            m_scheduler->wait();
+        }
         m_rudderController->stopDetection();
         qDebug() << "控制器桥接器已销毁";
     }
@@ -68,15 +103,22 @@ private slots:
             return;
         }
 
-        // 将摇杆数据映射到推力器控制参数
-        double leftThrust = mapAxisToThrust(state.leftY);
-        double rightThrust = mapAxisToThrust(state.rightY);
-        double leftPos = mapAxisToPosition(state.leftX);
-        double rightPos = mapAxisToPosition(state.rightX);
+        // 固定频率控制循环负责发布时，这里只更新界面
+        if (m_scheduler) {
+            if (m_mainWindow) {
+                updateMainWindowWithJoystickData(state);
+            }
+            return;
+        }
+
+        // 整形后映射到推力器控制参数（按变化发布时没有固定周期，不做低通与限速）
+        const ThrusterCommand command = toCommand(m_inputShaper.shape(state, 0.0));
 
         // 发送推力器控制消息
         if (m_mqttClient->isConnected()) {
-            m_mqttClient->publishThrusters(leftThrust, rightThrust, leftPos, rightPos);
+            m_mqttClient->publishThrusters(command.leftThrust, command.rightThrust,
+                                           command.leftPos, command.rightPos,
+                                           state.sampledUs, ControlLatencyTracker::nowUs());
         }
 
         // 调试输出（每20次输出一次以减少日志）
@@ -103,6 +145,53 @@ private slots:
         }
     }
 
+    void onThrusterCommand(const ThrusterCommand &command)
+    {
+        // 模式切换与排队中的指令可能交错，以 GUI 线程的当前模式为准
+        if (m_mode != Mode::Manual) {
+            return;
+        }
+        if (m_mqttClient->isConnected()) {
+            m_mqttClient->publishThrusters(command.leftThrust, command.rightThrust,
+                                           command.leftPos, command.rightPos,
+                                           command.sampledUs, ControlLatencyTracker::nowUs());
+        }
+    }
+
+    // 每秒刷新主窗口状态栏的控制诊断：端到端延迟、控制周期抖动
+    void updateControlDiagnostics()
+    {
+        if (!m_mainWindow) {
+            return;
+        }
+        const ControlLatencySnapshot latency = m_mqttClient->controlLatency();
+        QString text = latency.total.count > 0
+            ? QString("控制延迟 p50 %1 ms / p99 %2 ms")
+                  .arg(latency.total.p50Ms, 0, 'f', 1).arg(latency.total.p99Ms, 0, 'f', 1)
+            : QString("控制延迟 --");
+        QString detail = m_mqttClient->controlLatencyReport();
+        if (m_scheduler) {
+            const ControlSchedulerStats timing = m_scheduler->stats();
+            text += QString(" · %1 Hz 抖动 %2 µs").arg(timing.actualHz, 0, 'f', 1)
+                        .arg(timing.periodJitterUs, 0, 'f', 0);
+            detail += QString("\n控制循环 %1 Hz（实测 %2 Hz），唤醒延后 p50 %3 µs / p99 %4 µs / 最大 %5 µs，"
+                              "周期标准差 %6 µs，跳过 %7 个周期")
+                          .arg(timing.rateHz, 0, 'f', 1).arg(timing.actualHz, 0, 'f', 1)
+                          .arg(timing.lateP50Us, 0, 'f', 0).arg(timing.lateP99Us, 0, 'f', 0)
+                          .arg(timing.lateMaxUs, 0, 'f', 0).arg(timing.periodJitterUs, 0, 'f', 0)
+                          .arg(timing.missedTicks);
+        }
+        detail += QString("\n手柄采样 %1 次，发出更新 %2 次")
+                      .arg(m_rudderController->sampleCount()).arg(m_rudderController->emitCount());
+        m_mainWindow->setControlDiagnostics(text, detail);
+    }
+
+    // 输入线程结束（回放读完或程序退出）时输出完整的延迟报告
+    void logControlLatency()
+    {
+        qDebug().noquote() << m_mqttClient->controlLatencyReport();
+    }
+
     void onControllerStatusChanged(bool connected)
     {
         if (connected) {
@@ -123,18 +212,31 @@ private slots:
     }
 
 public slots:
+    // 切换控制船只时加载该船的输入整形配置
+    void setBoat(const QString &boatName)
+    {
+        m_inputShaper.setConfig(InputShapingConfig::load(boatName));
+    }
+
     void onControlStatusChanged(const QString &status)
     {
         // 期望状态："AUTO" / "MANUAL" / "STOP"
         if (status == "AUTO") {
             m_mode = Mode::Auto;
         } else if (status == "MANUAL") {
+            // 滤波与限速从零开始，不沿用切换前的输出
+            if (m_mode != Mode::Manual) {
+                m_inputShaper.reset();
+            }
             m_mode = Mode::Manual;
         } else if (status == "STOP") {
             m_mode = Mode::Stop;
             // 立即下发归零指令一次
             sendZeroThrusters();
         }
+        if (m_scheduler) {
+            m_scheduler->setActive(m_mode == Mode::Manual);
+        }
         qDebug() << "控制模式切换:" << status;
     }
 
@@ -148,24 +250,16 @@ private:
         }
     }
 
-    // 将摇杆轴值映射到推力范围 [-1000, 1000]
-    double mapAxisToThrust(float axisValue)
+    // 整形后的轴值映射为推力指令：Y 轴为推力 [-1000, 1000]，X 轴为位置 [-1, 1]
+    // （死区、曲线等由 InputShaper 按船只配置处理，默认 0.05 死区、线性）
+    static ThrusterCommand toCommand(const RudderState &shaped)
     {
-        // 添加死区处理，避免摇杆微小移动造成的误操作
-        if (qAbs(axisValue) < 0.05f) {
-            return 0.0;
-        }
-        return axisValue * 1000.0;
-    }
-
-    // 将摇杆轴值映射到位置范围 [-1, 1]
-    double mapAxisToPosition(float axisValue)
-    {
-        // 添加死区处理
-        if (qAbs(axisValue) < 0.05f) {
-            return 0.0;
-        }
-        return axisValue;
+        ThrusterCommand command;
+        command.leftThrust = shaped.leftY * 1000.0;
+        command.rightThrust = shaped.rightY * 1000.0;
+        command.leftPos = shaped.leftX;
+        command.rightPos = shaped.rightX;
+        return command;
     }
 
     // 将摇杆水平值映射到舵角范围（-40°到40°）
@@ -194,6 +288,9 @@ private:
 
     MqttClient *m_mqttClient;        // 使用外部传入的MQTT客户端
     RudderController *m_rudderController;
+    ControlScheduler *m_scheduler = nullptr;
+    InputShaper m_inputShaper;
+    QTimer *m_diagnosticsTimer = nullptr;
     MainWindow *m_mainWindow = nullptr;
     Mode m_mode = Mode::Manual;
 };
@@ -294,6 +391,12 @@ public:
         return m_currentData;
     }
 
+signals:
+    // 视频 HUD 所需的姿态/航向/航速快照（每次传感器数据刷新界面时发出）
+    void hudTelemetryUpdated(const HudTelemetry &telemetry);
+    // 当前船只的 GPS 定位（未开启船队监控时用于记录航迹）
+    void gpsFixReceived(double latitude, double longitude);
+
 private slots:
     void onMqttStateChanged(const QString &state)
     {
@@ -309,33 +412,11 @@ private slots:
     {
         QMutexLocker locker(&m_dataMutex);
 
-        // 解析四元数数据并转换为欧拉角
-        QJsonObject orientation = data.value("orientation").toObject();
-        double x = orientation.value("x").toDouble(0.0);
-        double y = orientation.value("y").toDouble(0.0);
-        double z = orientation.value("z").toDouble(0.0);
-        double w = orientation.value("w").toDouble(1.0);
-
-        double roll, pitch, yaw;
-        double sinr_cosp = 2.0 * (w * x + y * z);
-        double cosr_cosp = 1.0 - 2.0 * (x * x + y * y);
-        roll = std::atan2(sinr_cosp, cosr_cosp);
-
-        double sinp = 2.0 * (w * y - z * x);
-        if (std::abs(sinp) >= 1.0) {
-            pitch = std::copysign(M_PI / 2.0, sinp);
-        } else {
-            pitch = std::asin(sinp);
-        }
-
-        double siny_cosp = 2.0 * (w * z + x * y);
-        double cosy_cosp = 1.0 - 2.0 * (y * y + z * z);
-        yaw = std::atan2(siny_cosp, cosy_cosp);
-
-        // 转换为角度制
-        roll = roll * 180.0 / M_PI;
-        pitch = pitch * 180.0 / M_PI;
-        yaw = yaw * 180.0 / M_PI;
+        // 解析四元数数据并转换为欧拉角（角度制）
+        const EulerAngles euler = eulerFromImuJson(data);
+        double roll = euler.roll;
+        double pitch = euler.pitch;
+        double yaw = euler.yaw;
 
         // 解析角速度数据
         QJsonObject angularVelocity = data.value("angular_velocity").toObject();
@@ -413,6 +494,7 @@ private slots:
         //          << "航向:" << m_currentData.cog;
 
         QMetaObject::invokeMethod(this, "updateMainWindow", Qt::QueuedConnection);
+        emit gpsFixReceived(m_currentData.latitude, m_currentData.longitude);
     }
 
     void onSpeedDataReceived(const QJsonObject &data)
@@ -482,6 +564,16 @@ private slots:
         m_mainWindow->updatePropulsion(m_currentData.acceleration_magnitude,
                                       m_currentData.speed_knots,
                                       m_currentData.acceleration_magnitude);
+
+        // HUD 航向优先用 IMU 偏航（船首朝向），没有 IMU 数据时退回 GPS 航向
+        HudTelemetry hud;
+        hud.roll = m_currentData.roll;
+        hud.pitch = m_currentData.pitch;
+        hud.heading = m_currentData.lastImuUpdate > 0 ? m_currentData.yaw : cog;
+        hud.speedKnots = m_currentData.speed_knots;
+        hud.timestampMs = m_currentData.lastUpdate;
+        locker.unlock();
+        emit hudTelemetryUpdated(hud);
     }
 
 private:
@@ -495,6 +587,40 @@ int main(int argc, char *argv[])
 {
     QApplication app(argc, argv);
 
+    // 可选：仪表在后台线程池光栅化，GUI 线程只贴图（需在创建仪表前设置）
+    if (app.arguments().contains("--threaded-render")) {
+        ThreadedGaugeWidget::setThreadedRendering(true);
+        qDebug() << "仪表后台光栅化已启用";
+    }
+
+    // 摇杆输入源：回放录制文件 / 录制输入 / 指定 evdev 设备（需在创建 ControllerBridge 前设置）
+    {
+        const QStringList args = app.arguments();
+        auto argValue = [&args](const QString &name) {
+            const int i = args.indexOf(name);
+            return i >= 0 && i + 1 < args.size() ? args.at(i + 1) : QString();
+        };
+        RudderInputConfig input;
+        input.replayFile = argValue("--joystick-replay");
+        input.replayLoop = args.contains("--joystick-loop");
+        input.recordFile = argValue("--joystick-record");
+        input.evdevDevice = argValue("--joystick-device");
+        const QString speed = argValue("--joystick-replay-speed");
+        if (!speed.isEmpty())
+            input.replaySpeed = speed.toDouble();
+        RudderController::setInputConfig(input);
+
+        // 推力指令发布频率（Hz）；0 表示不用固定频率，摇杆变化时发布
+        const QString rate = argValue("--control-rate");
+        if (!rate.isEmpty())
+            ControlScheduler::setDefaultRate(rate.toDouble());
+
+        // 按船只的摇杆整形配置文件（默认为应用配置目录下的 input_shaping.ini）
+        const QString shaping = argValue("--input-shaping");
+        if (!shaping.isEmpty())
+            InputShapingConfig::setConfigFile(shaping);
+    }
+
     // 创建主窗口（仪表盘）
     MainWindow w;
     w.setWindowTitle("Ship Dashboard Control Center - Real Data Mode");
@@ -545,10 +671,58 @@ int main(int argc, char *argv[])
     // 创建传感器数据桥接器
     SensorDataBridge sensorBridge(mqttClient);
     sensorBridge.setMainWindow(&w);
+    QObject::connect(&sensorBridge, &SensorDataBridge::hudTelemetryUpdated,
+                     videoWindow, &VideoPlayerWindow::setHudTelemetry);
+
+    // ========== 船队总览 ==========
+    // 通配符订阅所有船只，数据汇入 FleetState，由总览窗口按帧批量重绘（窗口隐藏时不重绘）。
+    // 默认常开：航迹记录需要所有船只的定位；--no-fleet-monitor 只订阅当前船只
+    FleetState *fleetState = new FleetState(&app);
+    QObject::connect(mqttClient, &MqttClient::fleetSensorDataReceived,
+                     fleetState, &FleetState::onSensorData);
+    mqttClient->setFleetMonitoring(!app.arguments().contains("--no-fleet-monitor"));
+
+    FleetOverviewWidget *fleetWindow = new FleetOverviewWidget(fleetState);
+    QObject::connect(fleetState, &FleetState::boatAdded, &w, &MainWindow::addBoat);
+    QObject::connect(fleetWindow, &FleetOverviewWidget::boatActivated, &w, &MainWindow::selectBoat);
+    QObject::connect(&w, &MainWindow::showFleetWindowRequested, [fleetWindow]() {
+        if (fleetWindow->isVisible()) {
+            fleetWindow->hide();
+        } else {
+            fleetWindow->show();
+            fleetWindow->raise();
+            fleetWindow->activateWindow();
+        }
+    });
+
+    // ========== 船队航迹 ==========
+    // 航迹始终在后台记录，与窗口是否显示无关；未开启船队监控时只记录当前船只
+    TrackStore *trackStore = new TrackStore(&app);
+    QObject::connect(mqttClient, &MqttClient::fleetSensorDataReceived,
+                     trackStore, &TrackStore::onSensorData);
+    QObject::connect(&sensorBridge, &SensorDataBridge::gpsFixReceived, trackStore,
+                     [trackStore, mqttClient](double latitude, double longitude) {
+        if (!mqttClient->isFleetMonitoring())
+            trackStore->appendFix(mqttClient->currentBoat(), latitude, longitude);
+    });
+
+    TrackPlotWidget *trackWindow = new TrackPlotWidget(trackStore);
+    QObject::connect(&w, &MainWindow::showTrackWindowRequested, [trackWindow]() {
+        if (trackWindow->isVisible()) {
+            trackWindow->hide();
+        } else {
+            trackWindow->resize(trackWindow->sizeHint());
+            trackWindow->show();
+            trackWindow->raise();
+            trackWindow->activateWindow();
+        }
+    });
 
     // 连接船只切换信号
     QObject::connect(&w, &MainWindow::sendBoatSelectionToMqtt,
                      mqttClient, &MqttClient::setCurrentBoat);
+    QObject::connect(&w, &MainWindow::sendBoatSelectionToMqtt,
+                     &controllerBridge, &ControllerBridge::setBoat);
 
     // 连接主窗口的船只切换信号到视频窗口，实现自动切换摄像头
     QObject::connect(&w, &MainWindow::boatChanged,
@@ -575,6 +749,8 @@ int main(int argc, char *argv[])
                      &controllerBridge, &ControllerBridge::onControlStatusChanged);
 
     int result = app.exec();
+    delete fleetWindow;
+    delete trackWindow;
     qDebug() << "应用程序退出，返回码:" << result;
     return result;
 }
@@ -148,6 +148,36 @@ MainWindow::MainWindow(QWidget* parent)
     connect(videoWindowBtn_, &QPushButton::clicked,
             this, &MainWindow::onShowVideoClicked);
 
+    // =========================================
+    //  显示船队总览按钮
+    // =========================================
+    fleetWindowBtn_ = new QPushButton("🚤 船队", topBar);
+    fleetWindowBtn_->setFixedHeight(32);
+    fleetWindowBtn_->setStyleSheet(videoWindowBtn_->styleSheet());
+
+    connect(fleetWindowBtn_, &QPushButton::clicked,
+            this, &MainWindow::onShowFleetClicked);
+
+    // =========================================
+    //  显示趋势图按钮
+    // =========================================
+    trendWindowBtn_ = new QPushButton("📈 趋势", topBar);
+    trendWindowBtn_->setFixedHeight(32);
+    trendWindowBtn_->setStyleSheet(videoWindowBtn_->styleSheet());
+
+    connect(trendWindowBtn_, &QPushButton::clicked,
+            this, &MainWindow::onShowTrendClicked);
+
+    // =========================================
+    //  显示航迹图按钮
+    // =========================================
+    trackWindowBtn_ = new QPushButton("🗺 航迹", topBar);
+    trackWindowBtn_->setFixedHeight(32);
+    trackWindowBtn_->setStyleSheet(videoWindowBtn_->styleSheet());
+
+    connect(trackWindowBtn_, &QPushButton::clicked,
+            this, &MainWindow::onShowTrackClicked);
+
     // 布局管理
         topLayout->addWidget(boatLabel);
         topLayout->addWidget(boatSelector_);
@@ -156,6 +186,9 @@ MainWindow::MainWindow(QWidget* parent)
         topLayout->addWidget(manualBtn_);
         topLayout->addWidget(stopBtn_);
         topLayout->addStretch();
+        topLayout->addWidget(trendWindowBtn_);
+        topLayout->addWidget(fleetWindowBtn_);
+        topLayout->addWidget(trackWindowBtn_);
         topLayout->addWidget(videoWindowBtn_);
         topLayout->addWidget(waveConfigBtn_);
         topBar->setLayout(topLayout);
@@ -167,6 +200,16 @@ MainWindow::MainWindow(QWidget* parent)
     // ========== 仪表盘部分 ==========
     dashboard_ = new DashBoard(this);
 
+    // ========== 趋势图（独立窗口） ==========
+    trendWindow_ = new TrendChartWidget(this);
+    trendWindow_->setWindowFlag(Qt::Window);
+    trendRoll_  = trendWindow_->addChannel("横滚 Roll",  "°",  QColor(0, 220, 255));
+    trendPitch_ = trendWindow_->addChannel("俯仰 Pitch", "°",  QColor(0, 255, 120));
+    trendSpeed_ = trendWindow_->addChannel("航速 SOG",   "Kn", QColor(255, 200, 0));
+    trendWind_  = trendWindow_->addChannel("风速 Wind",  "m/s", QColor(255, 110, 110));
+    trendWindow_->setChannelRange(trendRoll_, -30.0, 30.0);
+    trendWindow_->setChannelRange(trendPitch_, -30.0, 30.0);
+
     // ========== 主布局 ==========
     QWidget* central = new QWidget(this);
     auto* vLayout = new QVBoxLayout(central);
@@ -183,6 +226,8 @@ MainWindow::MainWindow(QWidget* parent)
     // ========== 状态栏 ==========
     statusBar()->setStyleSheet("background-color: #888888");
     statusBar()->showMessage("系统已启动，当前控制船只: boat1，控制状态: MANUAL");
+    controlDiagLabel_ = new QLabel("控制延迟 --", this);
+    statusBar()->addPermanentWidget(controlDiagLabel_);
 
     currentBoat_ = "boat1";
     emit sendBoatSelectionToMqtt(currentBoat_);
@@ -360,6 +405,8 @@ void MainWindow::onWaveConfigChanged(const WaveConfig& cfg)
 void MainWindow::updateWind(double direction, double speed, double roll)
 {
     if (dashboard_) dashboard_->setWind(direction, speed, roll);
+    trendWindow_->addSample(trendRoll_, roll);
+    trendWindow_->addSample(trendWind_, speed);
 }
 
 /**
@@ -369,6 +416,8 @@ void MainWindow::updateNav(double lat, double lon, double alt,
                            double cog, double sog, double pitch)
 {
     if (dashboard_) dashboard_->setNav(lat, lon, alt, cog, sog, pitch);
+    trendWindow_->addSample(trendPitch_, pitch);
+    trendWindow_->addSample(trendSpeed_, sog);
 }
 
 /**
@@ -397,6 +446,12 @@ void MainWindow::updateSpeedAndRudder(double accel, double mainSpeed,
     if (dashboard_) dashboard_->setSpeedAndRudder(accel, mainSpeed, rudder_port, rudder_stbd);
 }
 
+void MainWindow::setControlDiagnostics(const QString& text, const QString& detail)
+{
+    controlDiagLabel_->setText(text);
+    controlDiagLabel_->setToolTip(detail);
+}
+
 // 添加波浪配置发布完成后的处理
 void MainWindow::onWaveConfigPublished(const WaveConfig& config)
 {
@@ -412,3 +467,52 @@ void MainWindow::onShowVideoClicked()
 {
     emit showVideoWindowRequested();
 }
+
+/**
+ * @brief 显示船队总览按钮槽函数
+ */
+void MainWindow::onShowFleetClicked()
+{
+    emit showFleetWindowRequested();
+}
+
+/**
+ * @brief 船队中发现新船只：加入下拉框（已存在则忽略）
+ */
+void MainWindow::addBoat(const QString& boatName)
+{
+    if (boatSelector_->findText(boatName) < 0)
+        boatSelector_->addItem(boatName);
+}
+
+/**
+ * @brief 从船队总览选择控制船只（经由下拉框触发 onBoatChanged）
+ */
+void MainWindow::selectBoat(const QString& boatName)
+{
+    addBoat(boatName);
+    boatSelector_->setCurrentText(boatName);
+}
+
+/**
+ * @brief 显示/隐藏趋势图窗口
+ */
+void MainWindow::onShowTrendClicked()
+{
+    if (trendWindow_->isVisible()) {
+        trendWindow_->hide();
+    } else {
+        trendWindow_->resize(trendWindow_->sizeHint());
+        trendWindow_->show();
+        trendWindow_->raise();
+        trendWindow_->activateWindow();
+    }
+}
+
+/**
+ * @brief 显示航迹图按钮槽函数
+ */
+void MainWindow::onShowTrackClicked()
+{
+    emit showTrackWindowRequested();
+}
@@ -1,5 +1,6 @@
 #include "nav_info/nav_info_widget.h"
 #include "nav_info/pitch_gauge_widget.h"
+#include "render/numeric_readout.h"
 #include <QFont>
 #include <QtMath>
 
@@ -28,12 +29,12 @@ void NavInfoWidget::setupLayout()
     // 1️⃣ ALT 区域（左对齐）
     // ============================================================
     altLabel = new QLabel("ALT");
-    altValue = new QLabel("-- m");
+    altValue = new NumericReadout("-- m");
 
     altLabel->setFont(labelFont);
-    altValue->setFont(valueFont);
+    altValue->setTextFont(valueFont);
+    altValue->setWidthTemplate("00000.0 m");
     altLabel->setStyleSheet("color: #9E9E9E;");
-    altValue->setStyleSheet("color: white;");
     altLabel->setAlignment(Qt::AlignLeft | Qt::AlignVCenter);
     altValue->setAlignment(Qt::AlignHCenter | Qt::AlignVCenter);
 
@@ -46,19 +47,19 @@ void NavInfoWidget::setupLayout()
     // 2️⃣ LAT / LON 区域
     // ============================================================
     latLabel = new QLabel("LAT");
-    latValue = new QLabel("--°N");
+    latValue = new NumericReadout("--°N");
     lonLabel = new QLabel("LON");
-    lonValue = new QLabel("--°E");
+    lonValue = new NumericReadout("--°E");
 
     latLabel->setFont(labelFont);
-    latValue->setFont(valueFont);
+    latValue->setTextFont(valueFont);
+    latValue->setWidthTemplate("00.0°N");
     lonLabel->setFont(labelFont);
-    lonValue->setFont(valueFont);
+    lonValue->setTextFont(valueFont);
+    lonValue->setWidthTemplate("000.0°E");
 
     latLabel->setStyleSheet("color: #9E9E9E;");
-    latValue->setStyleSheet("color: white;");
     lonLabel->setStyleSheet("color: #9E9E9E;");
-    lonValue->setStyleSheet("color: white;");
 
     // LON 左对齐，LAT 右对齐
     lonLabel->setAlignment(Qt::AlignLeft | Qt::AlignVCenter);
@@ -85,19 +86,19 @@ void NavInfoWidget::setupLayout()
     // 3️⃣ COG / SOG 区域
     // ============================================================
     cogLabel = new QLabel("YAW");
-    cogValue = new QLabel("--°");
+    cogValue = new NumericReadout("--°");
     sogLabel = new QLabel("SOG");
-    sogValue = new QLabel("-- Kn");
+    sogValue = new NumericReadout("-- Kn");
 
     cogLabel->setFont(labelFont);
-    cogValue->setFont(valueFont);
+    cogValue->setTextFont(valueFont);
+    cogValue->setWidthTemplate("000.0°");
     sogLabel->setFont(labelFont);
-    sogValue->setFont(valueFont);
+    sogValue->setTextFont(valueFont);
+    sogValue->setWidthTemplate("00.0 Kn");
 
     cogLabel->setStyleSheet("color: #9E9E9E;");
-    cogValue->setStyleSheet("color: white;");
     sogLabel->setStyleSheet("color: #9E9E9E;");
-    sogValue->setStyleSheet("color: white;");
 
     // 左右对齐
     cogLabel->setAlignment(Qt::AlignLeft | Qt::AlignVCenter);
@@ -149,11 +150,22 @@ void NavInfoWidget::setupLayout()
 
 // ============================================================
 // 数据更新函数（实时刷新 UI）
+// 后缀使用静态常量，显示值不变时 NumericReadout 直接跳过
 // ============================================================
+namespace {
+const QString kSuffixMeter = QStringLiteral(" m");
+const QString kSuffixKnot  = QStringLiteral(" Kn");
+const QString kSuffixDeg   = QStringLiteral("°");
+const QString kSuffixNorth = QStringLiteral("°N");
+const QString kSuffixSouth = QStringLiteral("°S");
+const QString kSuffixEast  = QStringLiteral("°E");
+const QString kSuffixWest  = QStringLiteral("°W");
+}
+
 void NavInfoWidget::setAlt(double alt)
 {
     // 显示高度（保留 1 位小数）
-    altValue->setText(QString::number(alt, 'f', 1) + " m");
+    altValue->setValue(alt, 1, kSuffixMeter);
 }
 
 void NavInfoWidget::setLon(double lon)
@@ -161,7 +173,7 @@ void NavInfoWidget::setLon(double lon)
     // ------------------------------------------------------------
     // 经度：正数为东经 E，负数为西经 W
     // ------------------------------------------------------------
-    QString dir = (lon >= 0.0) ? "E" : "W";
+    const QString& dir = (lon >= 0.0) ? kSuffixEast : kSuffixWest;
     double absLon = fabs(lon);
 
     // 超出范围修正（确保在 0~180° 内）
@@ -170,8 +182,7 @@ void NavInfoWidget::setLon(double lon)
         absLon = 360.0 - absLon;
 
     // 保留 1位小数更精准
-    QString text = QString::number(absLon, 'f', 1) + "°" + dir;
-    lonValue->setText(text);
+    lonValue->setValue(absLon, 1, dir);
 
 }
 void NavInfoWidget::setLat(double lat)
@@ -179,7 +190,7 @@ void NavInfoWidget::setLat(double lat)
     // ------------------------------------------------------------
     // 纬度：正数为北纬 N，负数为南纬 S
     // ------------------------------------------------------------
-    QString dir = (lat >= 0.0) ? "N" : "S";
+    const QString& dir = (lat >= 0.0) ? kSuffixNorth : kSuffixSouth;
     double absLat = fabs(lat);
 
     // 超出范围修正（确保在 0~90° 内）
@@ -187,8 +198,7 @@ void NavInfoWidget::setLat(double lat)
     if (absLat > 90.0)
         absLat = 180.0 - absLat;
 
-    QString text = QString::number(absLat, 'f', 1) + "°" + dir;
-    latValue->setText(text);
+    latValue->setValue(absLat, 1, dir);
 
 }
 
@@ -198,14 +208,14 @@ void NavInfoWidget::setCog(double cog)
     // 航向角范围 0~360
     double normCog = fmod(cog, 360.0);
     if (normCog < 0) normCog += 360.0;
-    cogValue->setText(QString::number(normCog, 'f', 1) + "°");
+    cogValue->setValue(normCog, 1, kSuffixDeg);
 }
 
 void NavInfoWidget::setSog(double sog)
 {
     // 航速（单位 Kn，保留 1 位小数）
     if (sog < 0) sog = 0;
-    sogValue->setText(QString::number(sog, 'f', 1) + " Kn");
+    sogValue->setValue(sog, 1, kSuffixKnot);
 }
 
 void NavInfoWidget::setPitch(double pitch)
@@ -10,7 +10,7 @@
 // 构造函数
 // ============================================================
 PitchGaugeWidget::PitchGaugeWidget(QWidget* parent)
-    : QWidget(parent)
+    : ThreadedGaugeWidget(parent)
 {
     setAttribute(Qt::WA_OpaquePaintEvent);
     setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
@@ -52,40 +52,49 @@ void PitchGaugeWidget::setPitch(double val)
 // ============================================================
 void PitchGaugeWidget::setPitchValue(double val)
 {
-    pitch_ = val;  // 更新当前值
-    update();      // 刷新绘制（每帧重绘）
+    pitch_ = val;      // 更新当前值
+    requestRepaint();  // 刷新绘制（每帧重绘）
 }
 
 // ============================================================
-// 绘制事件（核心绘制逻辑）
+// 数据快照：按值捕获当前俯仰角
 // ============================================================
-void PitchGaugeWidget::paintEvent(QPaintEvent*)
+ThreadedGaugeWidget::SceneFn PitchGaugeWidget::snapshotScene() const
+{
+    return [pitch = pitch_](QPainter& p, const QSize& size) {
+        paintScene(p, size, pitch);
+    };
+}
+
+// ============================================================
+// 场景绘制（核心绘制逻辑）
+// ============================================================
+void PitchGaugeWidget::paintScene(QPainter& p, const QSize& size, double pitch)
 {
-    QPainter p(this);
     p.setRenderHint(QPainter::Antialiasing, true);
-    p.fillRect(rect(), Qt::black); // 背景填充黑色
+    p.fillRect(QRect(QPoint(0, 0), size), Qt::black); // 背景填充黑色
 
-    const int w = width();
-    const int h = height();
+    const int w = size.width();
+    const int h = size.height();
 
-    //------------------------- [1] 绘制标题与数值 -------------------------
-    QFont f("Microsoft YaHei");
-    f.setBold(true);
+    // 字体按线程缓存：QFont 内部数据首次使用时才填充，渲染线程之间不能共用
+    thread_local const QFont kTitleFont("Microsoft YaHei", 20, QFont::Bold);
+    thread_local const QFont kValueFont("Microsoft YaHei", 25, QFont::Bold);
+    thread_local const QFont kScaleFont("Microsoft YaHei", 14, QFont::Bold);
 
+    //------------------------- [1] 绘制标题与数值 -------------------------
     // ---- 左上角：灰色标题 ----
-    f.setPointSize(20);
-    p.setFont(f);
+    p.setFont(kTitleFont);
     p.setPen(QColor("#9E9E9E"));
     const int textTop = 45;     // 标题顶部偏移
     const int textLeft = 25;    // 标题左侧偏移
     p.drawText(textLeft - 25, textTop, "PITCH");
 
     // ---- 右上角：白色数值（实时显示当前动画帧值） ----
-    f.setPointSize(25);
-    p.setFont(f);
+    p.setFont(kValueFont);
     p.setPen(Qt::white);
-    const QString valText = QString::number(fabs(pitch_), 'f', 2) + QString::fromUtf8("°");
-    QFontMetrics fm(f);
+    const QString valText = QString::number(fabs(pitch), 'f', 2) + QString::fromUtf8("°");
+    QFontMetrics fm = p.fontMetrics();
     const int valX = w - fm.horizontalAdvance(valText);
     const int valY = 55;   // 数值垂直位置
     p.drawText(valX, valY - 5, valText);
@@ -147,8 +156,7 @@ void PitchGaugeWidget::paintEvent(QPaintEvent*)
         // ---- 绘制数字 (0, ±10) ----
         if (phys == 0 || std::abs(phys) == 10) {
             const QString label = QString::number(std::abs(phys));
-            QFont small("Microsoft YaHei", 14, QFont::Bold);
-            p.setFont(small);
+            p.setFont(kScaleFont);
             const double textR = radius + 20;
             const QPointF tpos(center.x() + textR * std::cos(radA),
                                center.y() - textR * std::sin(radA));
@@ -159,7 +167,7 @@ void PitchGaugeWidget::paintEvent(QPaintEvent*)
     }
 
     //------------------------- [5] 绘制白色三角指针 -------------------------
-    const double degPtr = arcDegFromPhys(pitch_);  // 当前俯仰角对应弧角
+    const double degPtr = arcDegFromPhys(pitch);  // 当前俯仰角对应弧角
     const double radPtr = qDegreesToRadians(degPtr);
 
     const QPointF radial(std::cos(radPtr), -std::sin(radPtr));
@@ -7,7 +7,7 @@
 #include <QFontMetrics>
 
 SpeedLogWidget::SpeedLogWidget(QWidget* parent)
-    : QWidget(parent)
+    : ThreadedGaugeWidget(parent)
 {
     setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
 }
@@ -15,31 +15,40 @@ SpeedLogWidget::SpeedLogWidget(QWidget* parent)
 void SpeedLogWidget::setSpeed(double accel, double speed, double /*accel_dup*/)
 {
     // 中间为当前速度；上下为同一个加速度
-    accel_ = accel;
-    speed_ = speed;
-    update();
+    data_.accel = accel;
+    data_.speed = speed;
+    requestRepaint();
 }
 
 void SpeedLogWidget::setRudders(double rudder_port, double rudder_stbd)
 {
-    rudder_port_ = rudder_port;
-    rudder_stbd_ = rudder_stbd;
-    update();
+    data_.rudder_port = rudder_port;
+    data_.rudder_stbd = rudder_stbd;
+    requestRepaint();
 }
 
-void SpeedLogWidget::paintEvent(QPaintEvent*)
+ThreadedGaugeWidget::SceneFn SpeedLogWidget::snapshotScene() const
+{
+    return [s = data_](QPainter& p, const QSize& size) {
+        paintScene(p, size, s);
+    };
+}
+
+void SpeedLogWidget::paintScene(QPainter& p, const QSize& size, const Snapshot& s)
 {
-    QPainter p(this);
     p.setRenderHint(QPainter::Antialiasing, true);
-    p.fillRect(rect(), Qt::black);
+    p.fillRect(QRect(QPoint(0, 0), size), Qt::black);
 
-    const int w = width();
-    const int h = height();
+    const int w = size.width();
+    const int h = size.height();
     const QColor kWhite(255, 255, 255);
 
+    // 字体按线程缓存：QFont 内部数据首次使用时才填充，渲染线程之间不能共用
+    thread_local const QFont kTitleFont("Arial", 18, QFont::Bold);
+    thread_local const QFont kNumFont("Arial", 22, QFont::Bold);
+
     // ===================== 标题 =====================
-    QFont titleFont("Arial", 18, QFont::Bold);
-    p.setFont(titleFont);
+    p.setFont(kTitleFont);
 
     // --- LOG 单独用浅灰色 #9E9E9E ---
     p.setPen(QColor("#9E9E9E"));
@@ -84,8 +93,7 @@ void SpeedLogWidget::paintEvent(QPaintEvent*)
     p.drawPath(path);
 
     // ===================== 三个数值（上=加速度，中=速度，下=加速度） =====================
-    QFont numFont("Arial", 22, QFont::Bold);
-    p.setFont(numFont);
+    p.setFont(kNumFont);
     p.setPen(kWhite);
 
     const int midY = (topY + bottomY) / 2;
@@ -94,10 +102,10 @@ void SpeedLogWidget::paintEvent(QPaintEvent*)
     const int yMidBase = midY;         // 中：速度
     const int yBotBase = midY + gap;   // 下：加速度
 
-    const QString sAccel = QString::number(fabs(accel_), 'f', 1);
-    const QString sSpeed = QString::number(fabs(speed_), 'f', 1);
+    const QString sAccel = QString::number(fabs(s.accel), 'f', 1);
+    const QString sSpeed = QString::number(fabs(s.speed), 'f', 1);
 
-    QFontMetrics nfm(numFont);
+    QFontMetrics nfm = p.fontMetrics();
     const int wAccel = nfm.horizontalAdvance(sAccel);
     const int wSpeed = nfm.horizontalAdvance(sSpeed);
 
@@ -107,10 +115,10 @@ void SpeedLogWidget::paintEvent(QPaintEvent*)
     p.drawText(centerX - wAccel / 2, yBotBase, sAccel);
 
     // ===================== 三角箭头（白色常显 + 条件绿色高亮） =====================
-    drawIndicatorTriangles(p, centerX, yTopBase, yMidBase, yBotBase, bodyWidth);
+    drawIndicatorTriangles(p, s, centerX, yTopBase, yMidBase, yBotBase, bodyWidth);
 }
 
-void SpeedLogWidget::drawIndicatorTriangles(QPainter& p,
+void SpeedLogWidget::drawIndicatorTriangles(QPainter& p, const Snapshot& s,
                                             int cx, int yTopText, int yMidText, int yBotText, int bodyW)
 {
     // 颜色
@@ -170,7 +178,7 @@ void SpeedLogWidget::drawIndicatorTriangles(QPainter& p,
 
     // —— 计算与文字对齐的几何位置 ——
     // 文字的 top / bottom（基于基线 y 的字体度量）
-    QFontMetrics fm(p.font());
+    QFontMetrics fm = p.fontMetrics();
     const int topTop      = yTopText - fm.ascent();
     const int topBottom   = yTopText + fm.descent();
     const int midTop      = yMidText - fm.ascent();
@@ -188,15 +196,15 @@ void SpeedLogWidget::drawIndicatorTriangles(QPainter& p,
 
     // —— 先画四个侧翼三角（白色常显）并按舵角高亮 ——
     // 左舵（上层）：正→右侧上三角绿；负→左侧上三角绿
-    drawSideArrow(sideXLeft,  yUpperSide, false, rudder_port_  < 0);
-    drawSideArrow(sideXRight, yUpperSide, true,  rudder_port_  > 0);
+    drawSideArrow(sideXLeft,  yUpperSide, false, s.rudder_port < 0);
+    drawSideArrow(sideXRight, yUpperSide, true,  s.rudder_port > 0);
 
     // 右舵（下层）：正→右侧下三角绿；负→左侧下三角绿
-    drawSideArrow(sideXLeft,  yLowerSide, false, rudder_stbd_  < 0);
-    drawSideArrow(sideXRight, yLowerSide, true,  rudder_stbd_  > 0);
+    drawSideArrow(sideXLeft,  yLowerSide, false, s.rudder_stbd < 0);
+    drawSideArrow(sideXRight, yLowerSide, true,  s.rudder_stbd > 0);
 
     // —— 再画中间上下小三角（白色常显）并按船速正负高亮 ——
     // 速度正→上三角绿；速度负→下三角绿
-    drawCenterArrow(cx, upBaseY, true,  speed_ > 0);
-    drawCenterArrow(cx, dnBaseY, false, speed_ < 0);
+    drawCenterArrow(cx, upBaseY, true,  s.speed > 0);
+    drawCenterArrow(cx, dnBaseY, false, s.speed < 0);
 }
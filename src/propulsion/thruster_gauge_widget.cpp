@@ -4,7 +4,7 @@
 #include <QtMath>
 
 ThrusterGaugeWidget::ThrusterGaugeWidget(QWidget* parent)
-    : QWidget(parent)
+    : ThreadedGaugeWidget(parent)
 {
     // setMinimumSize(200, 200);
     setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Fixed);
@@ -15,21 +15,27 @@ void ThrusterGaugeWidget::setThrust(double thrust)
     if (thrust < -10) thrust = -10;
     if (thrust > 10)  thrust = 10;
     thrust_ = thrust;
-    update();
+    requestRepaint();
 }
 void ThrusterGaugeWidget::setLabel(const QString& text)
 {
     label_ = text;
-    update();  // 文字变化后自动重绘
+    requestRepaint();  // 文字变化后自动重绘
 }
 
-void ThrusterGaugeWidget::paintEvent(QPaintEvent*)
+ThreadedGaugeWidget::SceneFn ThrusterGaugeWidget::snapshotScene() const
 {
-    QPainter p(this);
-    p.fillRect(rect(), Qt::black);  //  背景纯黑
+    return [label = label_](QPainter& p, const QSize& size) {
+        paintScene(p, size, label);
+    };
+}
+
+void ThrusterGaugeWidget::paintScene(QPainter& p, const QSize& size, const QString& title)
+{
+    p.fillRect(QRect(QPoint(0, 0), size), Qt::black);  //  背景纯黑
 
-    const int w = width();
-    const int h = height();
+    const int w = size.width();
+    const int h = size.height();
     const int margin = 26;
     const int centerY = h / 2 + 10;
     const int zeroX = w / 2;
@@ -41,13 +47,13 @@ void ThrusterGaugeWidget::paintEvent(QPaintEvent*)
 
     // ================= 绘制标题（左上角） =================
     p.setPen(textColor);
-    QFont titleFont("Arial", 16, QFont::Bold);
-    p.setFont(titleFont);
-    p.drawText(10, 24, "THRUSTER "+label_);
+    thread_local const QFont kTitleFont("Arial", 16, QFont::Bold);  // 每个线程只构造一次
+    thread_local const QFont kTickFont("Arial", 10, QFont::Bold);
+    p.setFont(kTitleFont);
+    p.drawText(10, 24, "THRUSTER "+title);
 
     // ================= 绘制刻度 =================
-    QFont font("Arial", 10, QFont::Bold);
-    p.setFont(font);
+    p.setFont(kTickFont);
 
     //  禁用抗锯齿，使线条像素完全白
     p.setRenderHint(QPainter::Antialiasing, false);
@@ -0,0 +1,118 @@
+#include "render/numeric_readout.h"
+#include <QPainter>
+#include <QFontMetrics>
+#include <QtMath>
+
+NumericReadout::NumericReadout(const QString& placeholder, QWidget* parent)
+    : QWidget(parent)
+    , font_(QWidget::font())
+    , widthTemplate_(placeholder)
+{
+    setAttribute(Qt::WA_OpaquePaintEvent);
+    setSizePolicy(QSizePolicy::Preferred, QSizePolicy::Fixed);
+
+    staticText_.setTextFormat(Qt::PlainText);
+    staticText_.setPerformanceHint(QStaticText::AggressiveCaching);
+    applyText(placeholder);
+    updateHint();
+}
+
+void NumericReadout::setTextFont(const QFont& font)
+{
+    font_ = font;
+    staticText_.prepare(QTransform(), font_);
+    updateHint();
+    update();
+}
+
+void NumericReadout::setTextColor(const QColor& color)
+{
+    textColor_ = color;
+    update();
+}
+
+void NumericReadout::setBackgroundColor(const QColor& color)
+{
+    background_ = color;
+    update();
+}
+
+void NumericReadout::setAlignment(Qt::Alignment align)
+{
+    align_ = align;
+    update();
+}
+
+void NumericReadout::setWidthTemplate(const QString& sample)
+{
+    widthTemplate_ = sample;
+    updateHint();
+}
+
+// ============================================================
+// 数值更新：按显示精度取整后比较，未变化时不做任何工作
+// ============================================================
+void NumericReadout::setValue(double value, int decimals, const QString& suffix)
+{
+    static constexpr double kScale[] = { 1.0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6 };
+    decimals = qBound(0, decimals, 6);
+
+    const qint64 key = qRound64(value * kScale[decimals]);
+    if (hasValue_ && key == lastKey_ && decimals == lastDecimals_ && suffix == lastSuffix_)
+        return;
+
+    hasValue_ = true;
+    lastKey_ = key;
+    lastDecimals_ = decimals;
+    lastSuffix_ = suffix;
+
+    applyText(QString::number(value, 'f', decimals) + suffix);
+}
+
+void NumericReadout::setText(const QString& text)
+{
+    hasValue_ = false;
+    if (text == staticText_.text())
+        return;
+    applyText(text);
+}
+
+void NumericReadout::applyText(const QString& text)
+{
+    staticText_.setText(text);
+    staticText_.prepare(QTransform(), font_);
+    update();  // 只重绘自身，不调用 updateGeometry()
+}
+
+void NumericReadout::updateHint()
+{
+    const QFontMetrics fm(font_);
+    const int w = qMax(fm.horizontalAdvance(widthTemplate_),
+                       fm.horizontalAdvance(staticText_.text()));
+    const QSize hint(w + 4, fm.height() + 4);
+    if (hint != hint_) {
+        hint_ = hint;
+        updateGeometry();  // 仅在字体/模板变化时触发
+    }
+}
+
+QSize NumericReadout::sizeHint() const { return hint_; }
+QSize NumericReadout::minimumSizeHint() const { return hint_; }
+
+void NumericReadout::paintEvent(QPaintEvent*)
+{
+    QPainter p(this);
+    p.fillRect(rect(), background_);
+    p.setFont(font_);
+    p.setPen(textColor_);
+
+    const QSizeF ts = staticText_.size();
+    qreal x = 0.0;
+    if (align_ & Qt::AlignRight)
+        x = width() - ts.width();
+    else if (align_ & Qt::AlignHCenter)
+        x = (width() - ts.width()) / 2.0;
+    const qreal y = (height() - ts.height()) / 2.0;
+
+    p.drawStaticText(QPointF(x, y), staticText_);
+}
@@ -0,0 +1,122 @@
+#include "render/threaded_gauge_widget.h"
+#include <QPainter>
+#include <QThread>
+#include <QThreadPool>
+#include <QtConcurrent>
+#include <atomic>
+
+namespace {
+std::atomic<bool> g_threadedRendering{false};
+}
+
+// 仪表专用线程池：与解码等长任务使用的全局线程池隔离，避免互相饿死
+Q_GLOBAL_STATIC(QThreadPool, g_renderPool)
+
+ThreadedGaugeWidget::ThreadedGaugeWidget(QWidget* parent)
+    : QWidget(parent)
+    , watcher_(new QFutureWatcher<QImage>(this))
+{
+    connect(watcher_, &QFutureWatcher<QImage>::finished,
+            this, &ThreadedGaugeWidget::onRenderFinished);
+}
+
+void ThreadedGaugeWidget::setThreadedRendering(bool enabled)
+{
+    g_threadedRendering.store(enabled, std::memory_order_relaxed);
+}
+
+bool ThreadedGaugeWidget::threadedRendering()
+{
+    return g_threadedRendering.load(std::memory_order_relaxed);
+}
+
+QThreadPool* ThreadedGaugeWidget::renderPool()
+{
+    QThreadPool* pool = g_renderPool();
+    static const bool configured = [pool]() {
+        pool->setObjectName("GaugeRenderPool");
+        pool->setMaxThreadCount(qMax(2, QThread::idealThreadCount() - 1));
+        return true;
+    }();
+    Q_UNUSED(configured);
+    return pool;
+}
+
+// ============================================================
+// 请求重绘：后台模式下同一时刻最多一个任务在飞，其余请求合并为一次补帧
+// ============================================================
+void ThreadedGaugeWidget::requestRepaint()
+{
+    if (!threadedRendering()) {
+        update();
+        return;
+    }
+
+    if (watcher_->isRunning()) {
+        pending_ = true;
+        return;
+    }
+    submitRender();
+}
+
+void ThreadedGaugeWidget::submitRender()
+{
+    const QSize sz = size();
+    if (sz.isEmpty())
+        return;
+
+    const qreal dpr = devicePixelRatioF();
+    SceneFn scene = snapshotScene();
+
+    // 复用后台缓冲（场景总是先铺满背景，不需要清空）；尺寸或缩放比变化时才重新分配
+    QImage target = std::move(back_);
+    if (target.size() != sz * dpr || target.devicePixelRatio() != dpr) {
+        target = QImage(sz * dpr, QImage::Format_ARGB32_Premultiplied);
+        target.setDevicePixelRatio(dpr);
+    }
+
+    watcher_->setFuture(QtConcurrent::run(renderPool(), [scene, sz, img = std::move(target)]() mutable {
+        QPainter p(&img);
+        scene(p, sz);
+        p.end();
+        return std::move(img);
+    }));
+}
+
+void ThreadedGaugeWidget::onRenderFinished()
+{
+    // 取走结果（不在 future 中保留引用），旧的前台缓冲转为下一帧的后台缓冲
+    back_ = std::move(front_);
+    front_ = watcher_->future().takeResult();
+    update();
+
+    if (pending_) {
+        pending_ = false;
+        submitRender();
+    }
+}
+
+// ============================================================
+// 绘制：同步模式直接执行场景；后台模式只贴最近完成的缓冲
+// ============================================================
+void ThreadedGaugeWidget::paintEvent(QPaintEvent*)
+{
+    QPainter p(this);
+
+    if (!threadedRendering()) {
+        snapshotScene()(p, size());
+        return;
+    }
+
+    // 尺寸变化后新帧尚未完成：先补黑底，避免残影
+    if (front_.isNull() || front_.deviceIndependentSize().toSize() != size())
+        p.fillRect(rect(), Qt::black);
+    if (!front_.isNull())
+        p.drawImage(0, 0, front_);
+}
+
+void ThreadedGaugeWidget::resizeEvent(QResizeEvent* event)
+{
+    QWidget::resizeEvent(event);
+    requestRepaint();
+}
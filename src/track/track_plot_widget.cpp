@@ -0,0 +1,230 @@
+#include "track/track_plot_widget.h"
+#include <QPainter>
+#include <QPaintEvent>
+#include <QWheelEvent>
+#include <QMouseEvent>
+#include <QElapsedTimer>
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+namespace {
+constexpr double kMinMetersPerPixel = 0.05;
+constexpr double kMaxMetersPerPixel = 50000.0;
+
+const QColor kBoatColors[] = {
+    QColor(0, 220, 255), QColor(0, 255, 120), QColor(255, 200, 0),
+    QColor(255, 110, 110), QColor(200, 130, 255), QColor(255, 160, 60),
+    QColor(120, 200, 255), QColor(230, 230, 230)
+};
+
+QColor boatColor(int index)
+{
+    return kBoatColors[index % int(std::size(kBoatColors))];
+}
+}
+
+TrackPlotWidget::TrackPlotWidget(TrackStore *store, QWidget *parent)
+    : QWidget(parent)
+    , store_(store)
+    , refreshTimer_(new QTimer(this))
+{
+    setWindowTitle("船队航迹");
+    setAttribute(Qt::WA_OpaquePaintEvent);
+    setMinimumSize(320, 240);
+
+    connect(store_, &TrackStore::trackUpdated, this, [this]() { dirty_ = true; });
+
+    refreshTimer_->setInterval(kRefreshIntervalMs);
+    connect(refreshTimer_, &QTimer::timeout, this, [this]() {
+        if (!dirty_)
+            return;
+        dirty_ = false;
+        if (autoFit_)
+            fitToTracks();
+        update();
+    });
+}
+
+QPointF TrackPlotWidget::toScreen(const QPointF &world) const
+{
+    return QPointF(width() / 2.0 + (world.x() - center_.x()) / metersPerPixel_,
+                   height() / 2.0 - (world.y() - center_.y()) / metersPerPixel_);
+}
+
+QPointF TrackPlotWidget::toWorld(const QPointF &screen) const
+{
+    return QPointF(center_.x() + (screen.x() - width() / 2.0) * metersPerPixel_,
+                   center_.y() - (screen.y() - height() / 2.0) * metersPerPixel_);
+}
+
+void TrackPlotWidget::fitToTracks()
+{
+    const QRectF b = store_->bounds();
+    if (store_->totalFixes() == 0)
+        return;
+    center_ = b.center();
+    const double mx = b.width() / std::max(1, width() - 40);
+    const double my = b.height() / std::max(1, height() - 40);
+    metersPerPixel_ = qBound(kMinMetersPerPixel, std::max({mx, my, 1.0}), kMaxMetersPerPixel);
+}
+
+// ============================================================
+// 绘制
+// ============================================================
+void TrackPlotWidget::paintEvent(QPaintEvent *)
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    QPainter p(this);
+    p.fillRect(rect(), QColor(10, 16, 24));
+
+    if (store_->totalFixes() == 0) {
+        p.setPen(QColor("#9E9E9E"));
+        p.drawText(rect(), Qt::AlignCenter, "等待 GPS 数据...");
+        return;
+    }
+
+    // 视口（世界坐标），y 轴向北
+    const QPointF tl = toWorld(QPointF(0, 0));
+    const QPointF br = toWorld(QPointF(width(), height()));
+    const QRectF view(QPointF(tl.x(), br.y()), QPointF(br.x(), tl.y()));
+
+    // 简化误差不超过半个像素
+    const int level = TrackStore::levelFor(metersPerPixel_ * 0.5);
+    store_->query(view, visible_);
+
+    p.setRenderHint(QPainter::Antialiasing, false);
+    qint64 pointsDrawn = 0;
+    for (const TrackStore::ChunkRef &ref : visible_) {
+        const TrackChunk &chunk = store_->track(ref.boat).chunks[ref.chunk];
+        const QVector<QPointF> &pts =
+            (chunk.sealed && level > 0) ? chunk.levels[level] : chunk.raw;
+        if (pts.size() < 2)
+            continue;
+
+        polyBuf_.resize(pts.size());
+        for (int i = 0; i < pts.size(); ++i)
+            polyBuf_[i] = toScreen(pts[i]);
+        pointsDrawn += pts.size();
+
+        p.setPen(QPen(boatColor(ref.boat), 1.5));
+        p.drawPolyline(polyBuf_);
+    }
+
+    // 当前位置与船名
+    p.setRenderHint(QPainter::Antialiasing, true);
+    p.setFont(QFont("Arial", 9, QFont::Bold));
+    for (int b = 0; b < store_->boatCount(); ++b) {
+        const BoatTrack &t = store_->track(b);
+        if (t.fixCount == 0)
+            continue;
+        const QPointF s = toScreen(t.lastPos);
+        if (!rect().adjusted(-20, -20, 20, 20).contains(s.toPoint()))
+            continue;
+        p.setPen(Qt::NoPen);
+        p.setBrush(boatColor(b));
+        p.drawEllipse(s, 4, 4);
+        p.setPen(Qt::white);
+        p.drawText(s + QPointF(7, -6), t.name);
+    }
+
+    drawScaleBar(p);
+
+    // 统计信息
+    p.setPen(QColor("#9E9E9E"));
+    p.setFont(QFont("Arial", 8));
+    p.drawText(rect().adjusted(8, 6, -8, -6), Qt::AlignLeft | Qt::AlignTop,
+               QString("定位 %1  分块 %2  绘制点 %3  简化级 %4  %5 ms%6")
+                   .arg(store_->totalFixes())
+                   .arg(visible_.size())
+                   .arg(pointsDrawn)
+                   .arg(level)
+                   .arg(timer.nsecsElapsed() / 1e6, 0, 'f', 2)
+                   .arg(autoFit_ ? "" : "（双击自动适配）"));
+}
+
+void TrackPlotWidget::drawScaleBar(QPainter &p)
+{
+    // 选择 1/2/5×10^n 米、长度约 100 像素的比例尺
+    const double target = metersPerPixel_ * 100.0;
+    const double base = std::pow(10.0, std::floor(std::log10(target)));
+    double len = base;
+    for (double m : {1.0, 2.0, 5.0}) {
+        if (base * m <= target)
+            len = base * m;
+    }
+    const double px = len / metersPerPixel_;
+    const QPointF origin(12, height() - 16);
+
+    p.setPen(QPen(Qt::white, 2));
+    p.drawLine(origin, origin + QPointF(px, 0));
+    p.drawLine(origin, origin + QPointF(0, -5));
+    p.drawLine(origin + QPointF(px, 0), origin + QPointF(px, -5));
+    p.setFont(QFont("Arial", 8));
+    p.drawText(origin + QPointF(px + 6, 4),
+               len >= 1000.0 ? QString("%1 km").arg(len / 1000.0) : QString("%1 m").arg(len));
+}
+
+// ============================================================
+// 交互
+// ============================================================
+void TrackPlotWidget::wheelEvent(QWheelEvent *event)
+{
+    // 以光标为中心缩放：缩放前后光标下的世界坐标不变
+    const QPointF cursor = event->position();
+    const QPointF anchor = toWorld(cursor);
+    const double factor = event->angleDelta().y() > 0 ? 1.0 / 1.25 : 1.25;
+    metersPerPixel_ = qBound(kMinMetersPerPixel, metersPerPixel_ * factor, kMaxMetersPerPixel);
+    const QPointF after = toWorld(cursor);
+    center_ += anchor - after;
+    autoFit_ = false;
+    update();
+    event->accept();
+}
+
+void TrackPlotWidget::mousePressEvent(QMouseEvent *event)
+{
+    if (event->button() != Qt::LeftButton)
+        return;
+    dragging_ = true;
+    dragLast_ = event->position();
+}
+
+void TrackPlotWidget::mouseMoveEvent(QMouseEvent *event)
+{
+    if (!dragging_)
+        return;
+    const QPointF d = event->position() - dragLast_;
+    dragLast_ = event->position();
+    center_ += QPointF(-d.x() * metersPerPixel_, d.y() * metersPerPixel_);
+    autoFit_ = false;
+    update();
+}
+
+void TrackPlotWidget::mouseReleaseEvent(QMouseEvent *)
+{
+    dragging_ = false;
+}
+
+void TrackPlotWidget::mouseDoubleClickEvent(QMouseEvent *)
+{
+    autoFit_ = true;
+    fitToTracks();
+    update();
+}
+
+void TrackPlotWidget::showEvent(QShowEvent *event)
+{
+    QWidget::showEvent(event);
+    if (autoFit_)
+        fitToTracks();      // 隐藏期间记录的航迹
+    refreshTimer_->start();
+}
+
+void TrackPlotWidget::hideEvent(QHideEvent *event)
+{
+    QWidget::hideEvent(event);
+    refreshTimer_->stop();  // 不可见时不重绘
+}
@@ -0,0 +1,283 @@
+#include "track/track_store.h"
+#include <QSet>
+#include <QtMath>
+#include <cmath>
+
+namespace {
+constexpr int kChunkSize = 1024;          // 每分块点数
+constexpr double kCellSize = 2000.0;      // 网格边长（米）
+constexpr double kEarthRadius = 6371000.0;
+// 相邻定位点间距小于该值时视为原地漂移，不记录
+constexpr double kMinStepMeters = 0.2;
+// 相邻定位隐含速度上限（米/秒）与定位误差余量：超出 kMaxSpeed·Δt + kJumpSlack 视为跳点
+constexpr double kMaxSpeedMps = 40.0;
+constexpr double kJumpSlackMeters = 100.0;
+// 单个分块最多登记的网格数；超出的分块单独列出（每次查询都检查包围盒）
+constexpr qint64 kMaxCellsPerChunk = 64;
+
+// QRectF 把零宽/零高矩形视为空，航迹包围盒常出现这种情况，因此手动维护
+void extend(QRectF &box, const QPointF &p, bool first)
+{
+    if (first) {
+        box = QRectF(p, QSizeF(0, 0));
+        return;
+    }
+    box.setLeft(std::min(box.left(), p.x()));
+    box.setRight(std::max(box.right(), p.x()));
+    box.setTop(std::min(box.top(), p.y()));
+    box.setBottom(std::max(box.bottom(), p.y()));
+}
+
+bool overlaps(const QRectF &a, const QRectF &b)
+{
+    return a.left() <= b.right() && b.left() <= a.right()
+        && a.top() <= b.bottom() && b.top() <= a.bottom();
+}
+
+double segmentDistance(const QPointF &p, const QPointF &a, const QPointF &b)
+{
+    const double dx = b.x() - a.x();
+    const double dy = b.y() - a.y();
+    const double len2 = dx * dx + dy * dy;
+    double t = 0.0;
+    if (len2 > 0.0)
+        t = qBound(0.0, ((p.x() - a.x()) * dx + (p.y() - a.y()) * dy) / len2, 1.0);
+    return std::hypot(p.x() - (a.x() + t * dx), p.y() - (a.y() + t * dy));
+}
+
+/// 迭代式 Douglas–Peucker（显式栈，避免长折线递归过深）
+QVector<QPointF> simplify(const QVector<QPointF> &pts, double tolerance)
+{
+    const int n = pts.size();
+    if (n <= 2 || tolerance <= 0.0)
+        return pts;
+
+    QVector<bool> keep(n, false);
+    keep[0] = keep[n - 1] = true;
+
+    QVector<QPair<int, int>> stack;
+    stack.append({0, n - 1});
+    while (!stack.isEmpty()) {
+        const auto [first, last] = stack.takeLast();
+        double maxDist = 0.0;
+        int index = -1;
+        for (int i = first + 1; i < last; ++i) {
+            const double d = segmentDistance(pts[i], pts[first], pts[last]);
+            if (d > maxDist) {
+                maxDist = d;
+                index = i;
+            }
+        }
+        if (index >= 0 && maxDist > tolerance) {
+            keep[index] = true;
+            stack.append({first, index});
+            stack.append({index, last});
+        }
+    }
+
+    QVector<QPointF> out;
+    for (int i = 0; i < n; ++i) {
+        if (keep[i])
+            out.append(pts[i]);
+    }
+    return out;
+}
+}
+
+TrackStore::TrackStore(QObject *parent)
+    : QObject(parent)
+{
+    clock_.start();
+}
+
+const QVector<double> &TrackStore::tolerances()
+{
+    static const QVector<double> kTolerances = {0.0, 1.0, 4.0, 16.0, 64.0, 256.0, 1024.0};
+    return kTolerances;
+}
+
+int TrackStore::levelFor(double maxErrorMeters)
+{
+    const QVector<double> &tol = tolerances();
+    int level = 0;
+    for (int i = 1; i < tol.size() && tol[i] <= maxErrorMeters; ++i)
+        level = i;
+    return level;
+}
+
+quint64 TrackStore::cellKey(int cx, int cy)
+{
+    return (quint64(quint32(cx)) << 32) | quint32(cy);
+}
+
+QPointF TrackStore::project(double latitude, double longitude) const
+{
+    // 本地等距圆柱投影：x 向东，y 向北（米）
+    const double x = qDegreesToRadians(longitude - lon0_) * kEarthRadius * cosLat0_;
+    const double y = qDegreesToRadians(latitude - lat0_) * kEarthRadius;
+    return QPointF(x, y);
+}
+
+void TrackStore::onSensorData(const QString &boatName, const QString &sensorType,
+                              const QJsonObject &data)
+{
+    if (sensorType != QLatin1String("gps"))
+        return;
+    appendFix(boatName,
+              data.value("latitude").toDouble(0.0),
+              data.value("longitude").toDouble(0.0));
+}
+
+void TrackStore::appendFix(const QString &boatName, double latitude, double longitude)
+{
+    // 过滤无效定位
+    if (!std::isfinite(latitude) || !std::isfinite(longitude)
+        || (latitude == 0.0 && longitude == 0.0)
+        || qAbs(latitude) > 90.0 || qAbs(longitude) > 180.0)
+        return;
+
+    if (!hasOrigin_) {
+        hasOrigin_ = true;
+        lat0_ = latitude;
+        lon0_ = longitude;
+        cosLat0_ = std::cos(qDegreesToRadians(latitude));
+    }
+
+    auto it = index_.constFind(boatName);
+    int b;
+    if (it == index_.constEnd()) {
+        b = tracks_.size();
+        BoatTrack track;
+        track.name = boatName;
+        tracks_.append(track);
+        index_.insert(boatName, b);
+    } else {
+        b = it.value();
+    }
+
+    BoatTrack &track = tracks_[b];
+    const QPointF pos = project(latitude, longitude);
+    const qint64 nowMs = clock_.elapsed();
+    if (track.fixCount > 0) {
+        const QPointF d = pos - track.lastPos;
+        const double step = std::hypot(d.x(), d.y());
+        if (step < kMinStepMeters)
+            return;
+        // 跳点：上一次接受的定位以来不可能走这么远。允许距离随时间增长，
+        // 船确实被移到别处（断线后重新上线）时，之后的定位终会被接受
+        const double dtS = (nowMs - track.lastFixMs) / 1000.0;
+        if (step > kMaxSpeedMps * dtS + kJumpSlackMeters) {
+            ++track.rejectedFixes;
+            return;
+        }
+    }
+
+    if (track.chunks.isEmpty()) {
+        track.chunks.append(TrackChunk());
+        track.chunks.last().raw.reserve(kChunkSize);
+    }
+    TrackChunk &tail = track.chunks.last();
+    extend(tail.bounds, pos, tail.raw.isEmpty());
+    tail.raw.append(pos);
+    extend(bounds_, pos, totalFixes_ == 0);
+    track.lastPos = pos;
+    track.lastFixMs = nowMs;
+    ++track.fixCount;
+    ++totalFixes_;
+
+    if (tail.raw.size() >= kChunkSize) {
+        const int sealedIndex = track.chunks.size() - 1;
+        seal(b, sealedIndex);
+        // 新分块以上一分块的末点开头，保持折线连续
+        TrackChunk next;
+        next.raw.reserve(kChunkSize);
+        next.raw.append(pos);
+        next.bounds = QRectF(pos, QSizeF(0, 0));
+        track.chunks.append(next);
+    }
+
+    emit trackUpdated();
+}
+
+void TrackStore::seal(int boat, int chunk)
+{
+    TrackChunk &c = tracks_[boat].chunks[chunk];
+
+    // 逐级简化：每级以上一级结果为输入，总成本接近单次简化
+    const QVector<double> &tol = tolerances();
+    c.levels.resize(tol.size());
+    c.levels[0] = c.raw;
+    for (int i = 1; i < tol.size(); ++i)
+        c.levels[i] = simplify(c.levels[i - 1], tol[i]);
+    c.levels[0].clear();        // 第 0 级直接使用 raw，不重复存储
+    c.sealed = true;
+
+    // 登记到包围盒覆盖的所有网格；覆盖过多时（长直航段）不展开，单独列出
+    const int cx0 = int(std::floor(c.bounds.left() / kCellSize));
+    const int cx1 = int(std::floor(c.bounds.right() / kCellSize));
+    const int cy0 = int(std::floor(c.bounds.top() / kCellSize));
+    const int cy1 = int(std::floor(c.bounds.bottom() / kCellSize));
+    ++sealedCount_;
+    if (qint64(cx1 - cx0 + 1) * (cy1 - cy0 + 1) > kMaxCellsPerChunk) {
+        oversized_.append({boat, chunk});
+        return;
+    }
+    for (int cx = cx0; cx <= cx1; ++cx) {
+        for (int cy = cy0; cy <= cy1; ++cy)
+            grid_[cellKey(cx, cy)].append({boat, chunk});
+    }
+}
+
+void TrackStore::query(const QRectF &view, QVector<ChunkRef> &out) const
+{
+    out.clear();
+    if (tracks_.isEmpty())
+        return;
+
+    const int cx0 = int(std::floor(view.left() / kCellSize));
+    const int cx1 = int(std::floor(view.right() / kCellSize));
+    const int cy0 = int(std::floor(view.top() / kCellSize));
+    const int cy1 = int(std::floor(view.bottom() / kCellSize));
+    const qint64 cellCount = qint64(cx1 - cx0 + 1) * (cy1 - cy0 + 1);
+
+    if (cellCount > grid_.size() || cellCount > sealedCount_) {
+        // 视口覆盖的网格比已登记的还多（缩得很小）：直接扫描全部分块包围盒更便宜
+        for (int b = 0; b < tracks_.size(); ++b) {
+            const QVector<TrackChunk> &chunks = tracks_[b].chunks;
+            for (int i = 0; i < chunks.size(); ++i) {
+                if (chunks[i].sealed && overlaps(chunks[i].bounds, view))
+                    out.append({b, i});
+            }
+        }
+    } else {
+        // 一个分块可能登记在多个网格中，用集合去重
+        QSet<quint64> seen;
+        for (int cx = cx0; cx <= cx1; ++cx) {
+            for (int cy = cy0; cy <= cy1; ++cy) {
+                auto it = grid_.constFind(cellKey(cx, cy));
+                if (it == grid_.constEnd())
+                    continue;
+                for (const ChunkRef &ref : it.value()) {
+                    const quint64 key = cellKey(ref.boat, ref.chunk);
+                    if (seen.contains(key))
+                        continue;
+                    seen.insert(key);
+                    if (overlaps(tracks_[ref.boat].chunks[ref.chunk].bounds, view))
+                        out.append(ref);
+                }
+            }
+        }
+        // 未登记到网格的大分块逐个检查
+        for (const ChunkRef &ref : oversized_) {
+            if (overlaps(tracks_[ref.boat].chunks[ref.chunk].bounds, view))
+                out.append(ref);
+        }
+    }
+
+    // 未封存的尾块总是参与绘制（点数有限）
+    for (int b = 0; b < tracks_.size(); ++b) {
+        const QVector<TrackChunk> &chunks = tracks_[b].chunks;
+        if (!chunks.isEmpty() && !chunks.last().sealed)
+            out.append({b, int(chunks.size()) - 1});
+    }
+}
@@ -0,0 +1,139 @@
+#include "trend/minmax_pyramid.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+// 一列内允许的平均桶数；超过则换更粗一层
+constexpr int kBucketsPerColumn = 4;
+}
+
+MinMaxPyramid::MinMaxPyramid(int levelCapacity, int levels)
+    : levels_(qMax(1, levels))
+    , pending_(qMax(1, levels))
+    , hasPending_(qMax(1, levels), false)
+    , capacity_(qMax(16, levelCapacity))
+{
+}
+
+void MinMaxPyramid::clear()
+{
+    for (Level &l : levels_)
+        l.clear();
+    hasPending_.fill(false);
+}
+
+double MinMaxPyramid::firstTime() const
+{
+    // 最粗一层保留的历史最长
+    for (int k = levels_.size() - 1; k >= 0; --k) {
+        if (!levels_[k].empty())
+            return levels_[k].front().t0;
+    }
+    return 0.0;
+}
+
+void MinMaxPyramid::merge(TrendBucket &into, const TrendBucket &b)
+{
+    into.t1 = b.t1;
+    into.vmin = std::min(into.vmin, b.vmin);
+    into.vmax = std::max(into.vmax, b.vmax);
+    into.last = b.last;
+}
+
+void MinMaxPyramid::append(double tMs, double value)
+{
+    if (!std::isfinite(value))
+        return;
+    // 时间必须单调，乱序样本并入最后一个时间点
+    if (!isEmpty())
+        tMs = std::max(tMs, lastTime());
+
+    const float v = float(value);
+    push(0, TrendBucket{tMs, tMs, v, v, v, v});
+}
+
+void MinMaxPyramid::push(int level, const TrendBucket &b)
+{
+    Level &l = levels_[level];
+    l.push_back(b);
+    if (int(l.size()) > capacity_)
+        l.pop_front();
+
+    const int up = level + 1;
+    if (up >= levels_.size())
+        return;
+
+    if (!hasPending_[up]) {
+        pending_[up] = b;
+        hasPending_[up] = true;
+    } else {
+        merge(pending_[up], b);
+        hasPending_[up] = false;
+        push(up, pending_[up]);
+    }
+}
+
+void MinMaxPyramid::accumulate(TrendColumn &c, const TrendBucket &b)
+{
+    if (!c.valid) {
+        c.vmin = b.vmin;
+        c.vmax = b.vmax;
+        c.first = b.first;
+        c.valid = true;
+    } else {
+        c.vmin = std::min(c.vmin, b.vmin);
+        c.vmax = std::max(c.vmax, b.vmax);
+    }
+    c.last = b.last;
+}
+
+void MinMaxPyramid::decimate(double t0, double msPerCol, int columns,
+                             QVector<TrendColumn> &out) const
+{
+    out.fill(TrendColumn(), qMax(0, columns));
+    if (columns <= 0 || msPerCol <= 0.0 || isEmpty())
+        return;
+
+    const double t1 = t0 + msPerCol * columns;
+    const auto byStart = [](const TrendBucket &b, double t) { return b.t1 < t; };
+    // 起点早于全部历史时，以实际最早数据作为覆盖要求
+    const double need = std::max(t0, firstTime());
+
+    // 选层：该层需覆盖查询起点（或已是最粗一层），且桶数量在预算内
+    int level = 0;
+    size_t i0 = 0, i1 = 0;
+    for (; level < levels_.size(); ++level) {
+        const Level &l = levels_[level];
+        if (l.empty())
+            continue;
+        i0 = std::lower_bound(l.begin(), l.end(), t0, byStart) - l.begin();
+        i1 = std::lower_bound(l.begin() + i0, l.end(), t1, byStart) - l.begin();
+        const bool covers = l.front().t0 <= need;
+        const bool lastLevel = level == levels_.size() - 1 || levels_[level + 1].empty();
+        if (lastLevel || (covers && int(i1 - i0) <= columns * kBucketsPerColumn))
+            break;
+    }
+    if (level >= levels_.size())
+        return;
+
+    const auto colOf = [&](double t) {
+        return int(std::floor((t - t0) / msPerCol));
+    };
+    const auto place = [&](const TrendBucket &b) {
+        const int ca = std::max(0, colOf(b.t0));
+        const int cb = std::min(columns - 1, colOf(b.t1));
+        for (int c = ca; c <= cb; ++c)
+            accumulate(out[c], b);
+    };
+
+    const Level &l = levels_[level];
+    const size_t end = std::min(l.size(), i1 + 1);
+    for (size_t i = i0; i < end; ++i)
+        place(l[i]);
+
+    // 本层之后尚未合并的数据：按时间顺序为高层 → 低层的半成品桶
+    for (int k = level; k >= 1; --k) {
+        if (hasPending_[k])
+            place(pending_[k]);
+    }
+}
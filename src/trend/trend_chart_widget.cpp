@@ -0,0 +1,300 @@
+#include "trend/trend_chart_widget.h"
+#include <QPainter>
+#include <QPaintEvent>
+#include <QWheelEvent>
+#include <QMouseEvent>
+#include <cmath>
+#include <iterator>
+
+namespace {
+constexpr double kMinSpanMs = 10.0 * 1000;
+constexpr double kMaxSpanMs = 24.0 * 3600 * 1000;
+// 数据中断超过该时长时不连线
+constexpr double kGapMs = 5000.0;
+
+const QColor kLaneBg(18, 18, 18);
+const QColor kGridColor(55, 55, 55);
+const QColor kAxisTextColor("#9E9E9E");
+
+// 时间网格间隔候选（ms）
+const double kGridSteps[] = {
+    1000, 2000, 5000, 10000, 15000, 30000,
+    60000, 120000, 300000, 600000, 900000, 1800000,
+    3600000, 7200000, 10800000, 21600000
+};
+
+QString formatAge(double ms)
+{
+    const qint64 s = qint64(std::llround(ms / 1000.0));
+    if (s == 0)
+        return QStringLiteral("0");
+    if (s < 60)
+        return QString("-%1s").arg(s);
+    if (s < 3600)
+        return QString("-%1:%2").arg(s / 60).arg(s % 60, 2, 10, QChar('0'));
+    return QString("-%1h%2").arg(s / 3600).arg((s % 3600) / 60, 2, 10, QChar('0'));
+}
+}
+
+TrendChartWidget::TrendChartWidget(QWidget *parent)
+    : QWidget(parent)
+    , scrollTimer_(new QTimer(this))
+{
+    setWindowTitle("遥测趋势");
+    setAttribute(Qt::WA_OpaquePaintEvent);
+    setMinimumSize(400, 240);
+    clock_.start();
+
+    scrollTimer_->setInterval(kScrollIntervalMs);
+    scrollTimer_->setTimerType(Qt::PreciseTimer);
+    connect(scrollTimer_, &QTimer::timeout, this, qOverload<>(&QWidget::update));
+}
+
+int TrendChartWidget::addChannel(const QString &name, const QString &unit, const QColor &color)
+{
+    Channel ch;
+    ch.name = name;
+    ch.unit = unit;
+    ch.color = color;
+    channels_.append(ch);
+    return channels_.size() - 1;
+}
+
+void TrendChartWidget::setChannelRange(int channel, double minValue, double maxValue)
+{
+    if (channel < 0 || channel >= channels_.size() || maxValue <= minValue)
+        return;
+    Channel &ch = channels_[channel];
+    ch.autoScale = false;
+    ch.minValue = minValue;
+    ch.maxValue = maxValue;
+}
+
+void TrendChartWidget::addSample(int channel, double value)
+{
+    if (channel < 0 || channel >= channels_.size())
+        return;
+    // 只记录数据，不触发重绘：重绘节奏由滚动定时器决定
+    channels_[channel].data.append(double(clock_.elapsed()), value);
+}
+
+void TrendChartWidget::setTimeSpan(double spanMs)
+{
+    spanMs_ = qBound(kMinSpanMs, spanMs, kMaxSpanMs);
+    update();
+}
+
+void TrendChartWidget::setFollowing(bool follow)
+{
+    following_ = follow;
+    if (following_ && isVisible())
+        scrollTimer_->start();
+    else
+        scrollTimer_->stop();
+    update();
+}
+
+double TrendChartWidget::viewEnd() const
+{
+    return following_ ? double(clock_.elapsed()) : frozenEnd_;
+}
+
+QRect TrendChartWidget::plotRect() const
+{
+    return rect().adjusted(kLeftMargin, kTopMargin, -kRightMargin, -kBottomMargin);
+}
+
+// ============================================================
+// 绘制
+// ============================================================
+void TrendChartWidget::paintEvent(QPaintEvent *)
+{
+    QPainter p(this);
+    p.fillRect(rect(), Qt::black);
+
+    const QRect plot = plotRect();
+    const int cols = plot.width();
+    if (cols <= 0 || channels_.isEmpty())
+        return;
+
+    // 列边界对齐到 msPerCol 的整数倍，剩余部分用亚像素平移表示
+    const double msPerCol = spanMs_ / cols;
+    const double end = viewEnd();
+    const double alignedEnd = std::ceil(end / msPerCol) * msPerCol;
+    const double shift = (alignedEnd - end) / msPerCol;        // 0 ~ 1 像素
+    const double tStart = alignedEnd - msPerCol * cols;
+
+    drawTimeGrid(p, plot, tStart, msPerCol, shift);
+
+    const int n = channels_.size();
+    const int laneH = (plot.height() - kLaneGap * (n - 1)) / n;
+    for (int i = 0; i < n; ++i) {
+        const QRect lane(plot.left(), plot.top() + i * (laneH + kLaneGap), cols, laneH);
+        drawLane(p, channels_[i], lane, tStart, msPerCol, cols, shift);
+    }
+
+    if (!following_) {
+        p.setPen(QColor(230, 180, 0));
+        p.setFont(QFont("Arial", 9, QFont::Bold));
+        p.drawText(plot.adjusted(0, 0, -6, 0), Qt::AlignRight | Qt::AlignTop, "回看（双击返回实时）");
+    }
+}
+
+void TrendChartWidget::drawTimeGrid(QPainter &p, const QRect &plot, double tStart,
+                                    double msPerCol, double shift)
+{
+    // 选择使网格间距不小于 80 像素的最小步长
+    double step = kGridSteps[std::size(kGridSteps) - 1];
+    for (double s : kGridSteps) {
+        if (s / msPerCol >= 80.0) {
+            step = s;
+            break;
+        }
+    }
+
+    const double end = tStart + msPerCol * plot.width();
+    const double now = double(clock_.elapsed());
+    p.setFont(QFont("Arial", 8));
+    for (double t = std::ceil(tStart / step) * step; t <= end; t += step) {
+        const double x = plot.left() + (t - tStart) / msPerCol - shift;
+        p.setPen(kGridColor);
+        p.drawLine(QPointF(x, plot.top()), QPointF(x, plot.bottom()));
+        p.setPen(kAxisTextColor);
+        p.drawText(QRectF(x - 40, plot.bottom() + 4, 80, 14), Qt::AlignCenter, formatAge(now - t));
+    }
+}
+
+void TrendChartWidget::drawLane(QPainter &p, Channel &ch, const QRect &lane,
+                                double tStart, double msPerCol, int cols, double shift)
+{
+    p.fillRect(lane, kLaneBg);
+
+    ch.data.decimate(tStart, msPerCol, cols, ch.columns);
+
+    // 量程
+    double lo = ch.minValue, hi = ch.maxValue;
+    if (ch.autoScale) {
+        bool any = false;
+        for (const TrendColumn &c : ch.columns) {
+            if (!c.valid)
+                continue;
+            lo = any ? std::min(lo, double(c.vmin)) : c.vmin;
+            hi = any ? std::max(hi, double(c.vmax)) : c.vmax;
+            any = true;
+        }
+        if (!any) {
+            lo = 0.0;
+            hi = 1.0;
+        }
+        const double pad = std::max((hi - lo) * 0.1, 0.5);
+        lo -= pad;
+        hi += pad;
+    }
+    const double scale = lane.height() / (hi - lo);
+    const auto yOf = [&](float v) {
+        return lane.bottom() - (qBound(lo, double(v), hi) - lo) * scale;
+    };
+
+    // 左侧标签：名称、最新值、量程
+    const int labelX = 6;
+    p.setPen(ch.color);
+    p.setFont(QFont("Arial", 10, QFont::Bold));
+    p.drawText(QRect(labelX, lane.top(), kLeftMargin - 12, 18), Qt::AlignLeft | Qt::AlignVCenter, ch.name);
+    p.setPen(Qt::white);
+    p.setFont(QFont("Arial", 11, QFont::Bold));
+    p.drawText(QRect(labelX, lane.top() + 18, kLeftMargin - 12, 20), Qt::AlignLeft | Qt::AlignVCenter,
+               ch.data.isEmpty() ? QStringLiteral("--")
+                                 : QString::number(ch.data.lastValue(), 'f', 1) + " " + ch.unit);
+    p.setPen(kAxisTextColor);
+    p.setFont(QFont("Arial", 8));
+    p.drawText(QRect(0, lane.top(), kLeftMargin - 4, 12), Qt::AlignRight | Qt::AlignTop,
+               QString::number(hi, 'f', 1));
+    p.drawText(QRect(0, lane.bottom() - 12, kLeftMargin - 4, 12), Qt::AlignRight | Qt::AlignBottom,
+               QString::number(lo, 'f', 1));
+
+    // 每列一条竖线（min~max），相邻有效列之间连线，整体一次 drawLines
+    lineBuf_.clear();
+    lineBuf_.reserve(cols * 2);
+    const int gapCols = std::max(1, int(kGapMs / msPerCol));
+    int prev = -1;
+    for (int c = 0; c < cols; ++c) {
+        const TrendColumn &col = ch.columns[c];
+        if (!col.valid)
+            continue;
+        const double x = lane.left() + c + 0.5 - shift;
+        if (prev >= 0 && c - prev <= gapCols) {
+            const double px = lane.left() + prev + 0.5 - shift;
+            lineBuf_.append(QLineF(px, yOf(ch.columns[prev].last), x, yOf(col.first)));
+        }
+        lineBuf_.append(QLineF(x, yOf(col.vmin), x, yOf(col.vmax)));
+        prev = c;
+    }
+
+    p.save();
+    p.setClipRect(lane);
+    p.setRenderHint(QPainter::Antialiasing, false);
+    p.setPen(QPen(ch.color, 1));
+    p.drawLines(lineBuf_);
+    p.restore();
+}
+
+// ============================================================
+// 交互
+// ============================================================
+void TrendChartWidget::wheelEvent(QWheelEvent *event)
+{
+    const double factor = event->angleDelta().y() > 0 ? 1.0 / 1.5 : 1.5;
+    setTimeSpan(spanMs_ * factor);
+    event->accept();
+}
+
+void TrendChartWidget::mousePressEvent(QMouseEvent *event)
+{
+    if (event->button() != Qt::LeftButton)
+        return;
+    dragging_ = true;
+    dragStartX_ = int(event->position().x());
+    dragStartEnd_ = viewEnd();
+}
+
+void TrendChartWidget::mouseMoveEvent(QMouseEvent *event)
+{
+    if (!dragging_)
+        return;
+    const int cols = std::max(1, plotRect().width());
+    const double msPerCol = spanMs_ / cols;
+    const double end = dragStartEnd_ - (event->position().x() - dragStartX_) * msPerCol;
+    const double now = double(clock_.elapsed());
+
+    if (end >= now) {
+        setFollowing(true);
+    } else {
+        frozenEnd_ = end;
+        if (following_)
+            setFollowing(false);
+        else
+            update();
+    }
+}
+
+void TrendChartWidget::mouseReleaseEvent(QMouseEvent *)
+{
+    dragging_ = false;
+}
+
+void TrendChartWidget::mouseDoubleClickEvent(QMouseEvent *)
+{
+    setFollowing(true);
+}
+
+void TrendChartWidget::showEvent(QShowEvent *event)
+{
+    QWidget::showEvent(event);
+    setFollowing(following_);
+}
+
+void TrendChartWidget::hideEvent(QHideEvent *event)
+{
+    QWidget::hideEvent(event);
+    scrollTimer_->stop();   // 不可见时只记录数据
+}
@@ -0,0 +1,346 @@
+#include "video/video_hud.h"
+#include <QPainter>
+#include <QFontMetricsF>
+#include <QtMath>
+#include <cmath>
+
+namespace {
+
+const QColor kHudColor(90, 255, 140);
+const QColor kShadowColor(0, 0, 0, 170);
+const QColor kBoxFill(0, 0, 0, 110);
+
+double normalizeHeading(double deg)
+{
+    double h = std::fmod(deg, 360.0);
+    if (h < 0.0)
+        h += 360.0;
+    return h;
+}
+
+int headingKeyOf(double heading) { return int(std::lround(normalizeHeading(heading))) % 360; }
+int speedKeyOf(double knots) { return int(std::lround(knots * 10.0)); }
+int angleKeyOf(double deg) { return int(std::lround(deg * 10.0)); }
+
+QPixmap transparentPixmap(const QSizeF &size, qreal dpr)
+{
+    QPixmap pm((size * dpr).toSize().expandedTo(QSize(1, 1)));
+    pm.setDevicePixelRatio(dpr);
+    pm.fill(Qt::transparent);
+    return pm;
+}
+
+/// 先画一遍加粗的暗色描边再画亮色，保证在亮/暗画面上都看得清（只用于缓存图层）
+template <typename Draw>
+void strokeOutlined(QPainter &q, qreal width, Draw draw)
+{
+    q.setPen(QPen(kShadowColor, width + 2.0, Qt::SolidLine, Qt::RoundCap));
+    draw();
+    q.setPen(QPen(kHudColor, width, Qt::SolidLine, Qt::RoundCap));
+    draw();
+}
+
+void textOutlined(QPainter &q, const QRectF &rect, int flags, const QString &text)
+{
+    q.setPen(kShadowColor);
+    q.drawText(rect.translated(1, 1), flags, text);
+    q.setPen(kHudColor);
+    q.drawText(rect, flags, text);
+}
+
+} // namespace
+
+bool VideoHud::setTelemetry(const HudTelemetry &telemetry)
+{
+    const bool changed = m_data.timestampMs == 0
+            || headingKeyOf(telemetry.heading) != headingKeyOf(m_data.heading)
+            || speedKeyOf(telemetry.speedKnots) != speedKeyOf(m_data.speedKnots)
+            || angleKeyOf(telemetry.roll) != angleKeyOf(m_data.roll)
+            || angleKeyOf(telemetry.pitch) != angleKeyOf(m_data.pitch);
+    m_data = telemetry;
+    return changed;
+}
+
+void VideoHud::rebuild(const QSize &size, qreal dpr)
+{
+    m_cacheSize = size;
+    m_cacheDpr = dpr;
+
+    const qreal w = size.width();
+    const qreal h = size.height();
+    const qreal u = qMin(w, h);
+    const qreal cx = w / 2.0;
+    const qreal cy = h / 2.0;
+
+    m_font = QFont();
+    m_font.setBold(true);
+    m_font.setPixelSize(qBound(11, int(u * 0.04), 28));
+    const QFontMetricsF fm(m_font);
+    const qreal line = qMax<qreal>(1.0, u / 400.0);
+
+    m_ladderPxPerDeg = h / 2.0 / kLadderVisible;
+    m_rollRadius = u * 0.36;
+
+    const qreal tapeW = w * 0.5;
+    const qreal tapeH = qMax(fm.height() * 2.0, u * 0.08);
+    m_tapePxPerDeg = tapeW / (2.0 * kTapeHalfSpan);
+    m_tapeRect = QRectF(cx - tapeW / 2.0, h - tapeH - u * 0.04, tapeW, tapeH);
+
+    const qreal boxH = fm.height() * 1.4;
+    const QSizeF headingBox(fm.horizontalAdvance("000°") + fm.height(), boxH);
+    const QSizeF speedBox(fm.horizontalAdvance("00.0 kn") + fm.height(), boxH);
+    const QSizeF rollBox(fm.horizontalAdvance("R -00.0°") + fm.height(), boxH);
+    m_headingBox = QPointF(cx, m_tapeRect.top() - boxH / 2.0 - line * 4);
+    m_speedBox = QPointF(u * 0.04 + speedBox.width() / 2.0, cy);
+    m_rollBox = QPointF(cx, cy - m_rollRadius - boxH / 2.0 - u * 0.05);
+
+    // ---- 静态图层 ----
+    m_static = transparentPixmap(size, dpr);
+    {
+        QPainter q(&m_static);
+        q.setRenderHint(QPainter::Antialiasing);
+        q.setFont(m_font);
+
+        // 读数框与航向带底色
+        q.setPen(Qt::NoPen);
+        q.setBrush(kBoxFill);
+        const auto boxAt = [](const QPointF &c, const QSizeF &s) {
+            return QRectF(c.x() - s.width() / 2.0, c.y() - s.height() / 2.0, s.width(), s.height());
+        };
+        const QRectF boxes[] = { boxAt(m_headingBox, headingBox), boxAt(m_speedBox, speedBox),
+                                 boxAt(m_rollBox, rollBox), m_tapeRect };
+        for (const QRectF &r : boxes)
+            q.drawRect(r);
+        q.setBrush(Qt::NoBrush);
+        for (const QRectF &r : boxes)
+            strokeOutlined(q, line, [&] { q.drawRect(r); });
+
+        // 航向带中心指示
+        const qreal caret = u * 0.02;
+        strokeOutlined(q, line, [&] {
+            q.drawLine(QPointF(cx, m_tapeRect.top()), QPointF(cx - caret, m_tapeRect.top() - caret));
+            q.drawLine(QPointF(cx, m_tapeRect.top()), QPointF(cx + caret, m_tapeRect.top() - caret));
+        });
+
+        // 中心准星：两翼 + 中心点
+        const qreal wingIn = u * 0.04;
+        const qreal wingOut = u * 0.12;
+        const qreal drop = u * 0.02;
+        strokeOutlined(q, line * 2.0, [&] {
+            q.drawPolyline(QPolygonF{ QPointF(cx - wingOut, cy), QPointF(cx - wingIn, cy),
+                                      QPointF(cx - wingIn, cy + drop) });
+            q.drawPolyline(QPolygonF{ QPointF(cx + wingOut, cy), QPointF(cx + wingIn, cy),
+                                      QPointF(cx + wingIn, cy + drop) });
+            q.drawPoint(QPointF(cx, cy));
+        });
+
+        // 横滚刻度弧（±45°）
+        const qreal r = m_rollRadius;
+        strokeOutlined(q, line, [&] {
+            q.drawArc(QRectF(cx - r, cy - r, 2 * r, 2 * r), int((90 - kRollLimit) * 16), int(2 * kRollLimit * 16));
+            for (int a : { -45, -30, -20, -10, 0, 10, 20, 30, 45 }) {
+                const qreal rad = qDegreesToRadians(double(a));
+                const qreal len = (a % 30 == 0 || std::abs(a) == 45) ? u * 0.035 : u * 0.02;
+                const QPointF dir(std::sin(rad), -std::cos(rad));
+                q.drawLine(QPointF(cx, cy) + dir * r, QPointF(cx, cy) + dir * (r + len));
+            }
+        });
+
+        textOutlined(q, QRectF(m_speedBox.x() - speedBox.width() / 2.0, m_speedBox.y() - boxH / 2.0 - fm.height(),
+                               speedBox.width(), fm.height()),
+                     Qt::AlignCenter, QStringLiteral("SPD"));
+    }
+
+    // ---- 俯仰梯（中心为 0°，每 5° 一档，负俯仰画虚线） ----
+    const qreal ppd = m_ladderPxPerDeg;
+    const QSizeF ladderSize(u * 0.5, 2.0 * kLadderRange * ppd + fm.height() * 2.0);
+    m_ladder = transparentPixmap(ladderSize, dpr);
+    {
+        QPainter q(&m_ladder);
+        q.setRenderHint(QPainter::Antialiasing);
+        q.setFont(m_font);
+        const qreal lx = ladderSize.width() / 2.0;
+        const qreal ly = ladderSize.height() / 2.0;
+        const qreal gap = u * 0.06;
+        for (int a = -int(kLadderRange); a <= int(kLadderRange); a += 5) {
+            if (a == 0)
+                continue;       // 0° 即地平线，每帧单独画
+            const bool major = (a % 10 == 0);
+            const qreal half = ladderSize.width() * (major ? 0.32 : 0.18);
+            const qreal y = ly - a * ppd;
+            const Qt::PenStyle style = a < 0 ? Qt::DashLine : Qt::SolidLine;
+            q.setPen(QPen(kShadowColor, line + 2.0, style));
+            q.drawLine(QPointF(lx - half, y), QPointF(lx - gap, y));
+            q.drawLine(QPointF(lx + gap, y), QPointF(lx + half, y));
+            q.setPen(QPen(kHudColor, line, style));
+            q.drawLine(QPointF(lx - half, y), QPointF(lx - gap, y));
+            q.drawLine(QPointF(lx + gap, y), QPointF(lx + half, y));
+            if (major) {
+                const QString label = QString::number(std::abs(a));
+                const qreal tw = fm.horizontalAdvance(label) + 4;
+                textOutlined(q, QRectF(lx - half - tw - 2, y - fm.height() / 2.0, tw, fm.height()),
+                             Qt::AlignRight | Qt::AlignVCenter, label);
+                textOutlined(q, QRectF(lx + half + 2, y - fm.height() / 2.0, tw, fm.height()),
+                             Qt::AlignLeft | Qt::AlignVCenter, label);
+            }
+        }
+    }
+
+    // ---- 航向刻度带：x = (度数 + kTapeHalfSpan) * 每度像素，首尾各多出半屏便于环绕截取 ----
+    const QSizeF tapeSize((360.0 + 2.0 * kTapeHalfSpan) * m_tapePxPerDeg, tapeH);
+    m_tape = transparentPixmap(tapeSize, dpr);
+    {
+        QPainter q(&m_tape);
+        q.setRenderHint(QPainter::Antialiasing);
+        q.setFont(m_font);
+        for (int d = -int(kTapeHalfSpan); d <= 360 + int(kTapeHalfSpan); d += 5) {
+            const int nd = ((d % 360) + 360) % 360;
+            const qreal x = (d + kTapeHalfSpan) * m_tapePxPerDeg;
+            const qreal len = (nd % 10 == 0) ? tapeH * 0.35 : tapeH * 0.2;
+            strokeOutlined(q, line, [&] { q.drawLine(QPointF(x, 0), QPointF(x, len)); });
+            if (nd % 30 == 0) {
+                QString label;
+                switch (nd) {
+                case 0:   label = QStringLiteral("N"); break;
+                case 90:  label = QStringLiteral("E"); break;
+                case 180: label = QStringLiteral("S"); break;
+                case 270: label = QStringLiteral("W"); break;
+                default:  label = QString::number(nd); break;
+                }
+                const qreal tw = fm.horizontalAdvance(label) + 8;
+                textOutlined(q, QRectF(x - tw / 2.0, tapeH * 0.38, tw, tapeH * 0.6),
+                             Qt::AlignHCenter | Qt::AlignVCenter, label);
+            }
+        }
+    }
+
+    for (QStaticText *t : { &m_headingText, &m_speedText, &m_rollText }) {
+        t->setTextFormat(Qt::PlainText);
+        t->setPerformanceHint(QStaticText::AggressiveCaching);
+    }
+    // 字体随尺寸变化，强制重排数值文字
+    m_headingKey = -1;
+    m_speedKey = -1;
+    m_rollKey = INT_MIN;
+}
+
+void VideoHud::updateTexts()
+{
+    const int heading = headingKeyOf(m_data.heading);
+    if (heading != m_headingKey) {
+        m_headingKey = heading;
+        m_headingText.setText(QStringLiteral("%1°").arg(heading, 3, 10, QLatin1Char('0')));
+        m_headingText.prepare(QTransform(), m_font);
+    }
+    const int speed = qMax(0, speedKeyOf(m_data.speedKnots));
+    if (speed != m_speedKey) {
+        m_speedKey = speed;
+        m_speedText.setText(QStringLiteral("%1 kn").arg(speed / 10.0, 0, 'f', 1));
+        m_speedText.prepare(QTransform(), m_font);
+    }
+    const int roll = angleKeyOf(m_data.roll);
+    if (roll != m_rollKey) {
+        m_rollKey = roll;
+        m_rollText.setText(QStringLiteral("R %1°").arg(roll / 10.0, 0, 'f', 1));
+        m_rollText.prepare(QTransform(), m_font);
+    }
+}
+
+void VideoHud::drawReadout(QPainter &p, const QPointF &center, const QStaticText &text) const
+{
+    const QSizeF s = text.size();
+    const QPointF pos(std::round(center.x() - s.width() / 2.0), std::round(center.y() - s.height() / 2.0));
+    p.setPen(kShadowColor);
+    p.drawStaticText(pos + QPointF(1, 1), text);
+    p.setPen(kHudColor);
+    p.drawStaticText(pos, text);
+}
+
+void VideoHud::paint(QPainter &p, const QRect &area, qreal dpr, qint64 nowMs)
+{
+    if (area.width() < 64 || area.height() < 64)
+        return;     // 宫格小图块之类太小的画面不叠加
+    if (area.size() != m_cacheSize || !qFuzzyCompare(dpr, m_cacheDpr))
+        rebuild(area.size(), dpr);
+
+    p.save();
+    p.setClipRect(area);
+    p.translate(area.topLeft());
+
+    const bool stale = m_data.timestampMs == 0 || nowMs - m_data.timestampMs > kStaleMs;
+    if (stale) {
+        // 遥测中断：只淡显静态框架并提示，不画可能误导的姿态/航向
+        p.setOpacity(0.35);
+        p.drawPixmap(QPointF(0, 0), m_static);
+        p.setOpacity(1.0);
+        p.setFont(m_font);
+        textOutlined(p, QRectF(QPointF(0, 0), QSizeF(area.size())).adjusted(0, 0, 0, -area.height() / 3),
+                     Qt::AlignCenter, m_data.timestampMs == 0 ? QStringLiteral("无遥测数据")
+                                                               : QStringLiteral("遥测中断"));
+        p.restore();
+        return;
+    }
+
+    const qreal cx = area.width() / 2.0;
+    const qreal cy = area.height() / 2.0;
+    const qreal u = qMin(area.width(), area.height());
+    const double roll = qBound(-90.0, m_data.roll, 90.0);
+    const double pitch = qBound(-kLadderRange, m_data.pitch, kLadderRange);
+
+    // 地平线 + 俯仰梯：随横滚旋转、随俯仰平移。横滚很小时不旋转，贴图走整像素快速路径
+    {
+        p.save();
+        p.translate(cx, cy);
+        if (std::abs(roll) >= 0.1)
+            p.rotate(-roll);
+        const qreal offset = std::round(pitch * m_ladderPxPerDeg * dpr) / dpr;
+        p.translate(0, offset);
+
+        const qreal gap = u * 0.06;
+        const qreal reach = area.width() * 0.45;
+        const qreal line = qMax<qreal>(1.0, u / 400.0);
+        p.setRenderHint(QPainter::Antialiasing, std::abs(roll) >= 0.1);
+        p.setPen(QPen(kShadowColor, line * 2.0 + 2.0));
+        p.drawLine(QPointF(-reach, 0), QPointF(-gap, 0));
+        p.drawLine(QPointF(gap, 0), QPointF(reach, 0));
+        p.setPen(QPen(kHudColor, line * 2.0));
+        p.drawLine(QPointF(-reach, 0), QPointF(-gap, 0));
+        p.drawLine(QPointF(gap, 0), QPointF(reach, 0));
+
+        const QSizeF ladder = QSizeF(m_ladder.size()) / dpr;
+        p.drawPixmap(QPointF(std::round(-ladder.width() / 2.0), std::round(-ladder.height() / 2.0)), m_ladder);
+        p.restore();
+    }
+
+    p.drawPixmap(QPointF(0, 0), m_static);
+
+    // 航向带：从 0~360° 长条里按航向截取一屏宽度，1:1 贴图
+    {
+        const double heading = normalizeHeading(m_data.heading);
+        const QRectF source(std::round(heading * m_tapePxPerDeg * dpr), 0,
+                            std::round(m_tapeRect.width() * dpr), m_tape.height());
+        p.drawPixmap(m_tapeRect, m_tape, source);
+    }
+
+    // 横滚指针：跟随地平线旋转的小三角
+    {
+        p.save();
+        p.setRenderHint(QPainter::Antialiasing);
+        p.translate(cx, cy);
+        p.rotate(-qBound(-kRollLimit, roll, kRollLimit));
+        const qreal s = u * 0.022;
+        const qreal r = m_rollRadius - 2.0;
+        const QPolygonF tri{ QPointF(0, -r), QPointF(-s, -r + s * 1.6), QPointF(s, -r + s * 1.6) };
+        p.setPen(QPen(kShadowColor, 2.0));
+        p.setBrush(kHudColor);
+        p.drawPolygon(tri);
+        p.restore();
+    }
+
+    updateTexts();
+    drawReadout(p, m_headingBox, m_headingText);
+    drawReadout(p, m_speedBox, m_speedText);
+    drawReadout(p, m_rollBox, m_rollText);
+
+    p.restore();
+}
@@ -0,0 +1,166 @@
+#include "video/video_mosaic_widget.h"
+#include <QEvent>
+#include <QMouseEvent>
+#include <QtMath>
+
+namespace {
+constexpr int kTileSpacing = 4;
+// 图块像素 / 源像素比例低于该阈值时降低解码质量
+constexpr double kReducedAreaRatio = 0.25;
+constexpr double kMinimalAreaRatio = 1.0 / 16.0;
+}
+
+VideoMosaicWidget::VideoMosaicWidget(StreamManager *streams, QWidget *parent)
+    : QWidget(parent)
+    , m_streams(streams)
+{
+    setStyleSheet("background-color: black;");
+}
+
+void VideoMosaicWidget::setStreamName(const QString &url, const QString &name)
+{
+    m_names.insert(url, name);
+}
+
+void VideoMosaicWidget::setMosaicActive(bool active)
+{
+    if (active) {
+        m_streams->setMosaicMode(true);
+        buildTiles();
+    } else {
+        clearTiles();
+        m_streams->setMosaicMode(false);
+    }
+}
+
+void VideoMosaicWidget::buildTiles()
+{
+    clearTiles();
+
+    for (const QString &url : m_streams->standbyUrls()) {
+        Tile tile;
+        tile.url = url;
+        tile.decoder = m_streams->decoder(url);
+        if (!tile.decoder)
+            continue;
+
+        tile.surface = new VideoSurfaceWidget(this);
+        tile.surface->setCaption(m_names.value(url, url));
+        tile.surface->clear("连接中...");
+        tile.surface->installEventFilter(this);
+        tile.surface->show();
+        m_tiles.append(tile);
+    }
+
+    // 图块指针稳定后再建立连接（QVector 扩容会移动元素）
+    for (int i = 0; i < m_tiles.size(); ++i) {
+        Tile &tile = m_tiles[i];
+        FFmpegDecoder *decoder = tile.decoder;
+        VideoSurfaceWidget *surface = tile.surface;
+        tile.frameConn = connect(decoder, &FFmpegDecoder::frameAvailable, surface, [decoder, surface]() {
+            QImage frame;
+            if (decoder->takeFrame(frame))
+                surface->setFrame(frame);
+        });
+        connect(surface, &VideoSurfaceWidget::displaySizeChanged, this, [this, i](const QSize &size) {
+            if (i < m_tiles.size())
+                updateTileQuality(m_tiles[i], size);
+        });
+
+        // 信箱中已有的帧立即显示
+        QImage frame;
+        if (decoder->takeFrame(frame))
+            surface->setFrame(frame);
+    }
+
+    m_focused = -1;
+    layoutTiles();
+}
+
+void VideoMosaicWidget::clearTiles()
+{
+    for (Tile &tile : m_tiles) {
+        disconnect(tile.frameConn);
+        delete tile.surface;
+    }
+    m_tiles.clear();
+    m_focused = -1;
+}
+
+void VideoMosaicWidget::updateTileQuality(Tile &tile, const QSize &devicePixelSize)
+{
+    tile.decoder->setOutputSize(devicePixelSize);
+
+    const double srcArea = double(tile.decoder->getVideoWidth()) * tile.decoder->getVideoHeight();
+    const double tileArea = double(devicePixelSize.width()) * devicePixelSize.height();
+    const bool focused = (m_focused >= 0 && m_tiles[m_focused].url == tile.url);
+
+    FFmpegDecoder::DecodeQuality quality = FFmpegDecoder::FullQuality;
+    if (!focused && srcArea > 0.0) {
+        const double ratio = tileArea / srcArea;
+        if (ratio < kMinimalAreaRatio)
+            quality = FFmpegDecoder::MinimalQuality;
+        else if (ratio < kReducedAreaRatio)
+            quality = FFmpegDecoder::ReducedQuality;
+    }
+    tile.decoder->setDecodeQuality(quality);
+}
+
+void VideoMosaicWidget::layoutTiles()
+{
+    const int n = m_tiles.size();
+    if (n == 0)
+        return;
+
+    const QRect area = rect();
+    if (m_focused >= 0 && n > 1) {
+        // 放大布局：左侧大图，其余图块在右侧纵向排列
+        const int sideW = area.width() / 4;
+        const int mainW = area.width() - sideW - kTileSpacing;
+        const int sideH = (area.height() - kTileSpacing * (n - 2)) / (n - 1);
+        int y = 0;
+        for (int i = 0; i < n; ++i) {
+            if (i == m_focused) {
+                m_tiles[i].surface->setGeometry(0, 0, mainW, area.height());
+            } else {
+                m_tiles[i].surface->setGeometry(mainW + kTileSpacing, y, sideW, sideH);
+                y += sideH + kTileSpacing;
+            }
+        }
+        return;
+    }
+
+    // 均分布局：尽量接近正方形的网格
+    const int cols = qCeil(qSqrt(double(n)));
+    const int rows = (n + cols - 1) / cols;
+    const int w = (area.width() - kTileSpacing * (cols - 1)) / cols;
+    const int h = (area.height() - kTileSpacing * (rows - 1)) / rows;
+    for (int i = 0; i < n; ++i) {
+        const int r = i / cols;
+        const int c = i % cols;
+        m_tiles[i].surface->setGeometry(c * (w + kTileSpacing), r * (h + kTileSpacing), w, h);
+    }
+}
+
+void VideoMosaicWidget::resizeEvent(QResizeEvent *event)
+{
+    QWidget::resizeEvent(event);
+    layoutTiles();
+}
+
+bool VideoMosaicWidget::eventFilter(QObject *watched, QEvent *event)
+{
+    if (event->type() == QEvent::MouseButtonPress) {
+        for (int i = 0; i < m_tiles.size(); ++i) {
+            if (m_tiles[i].surface != watched)
+                continue;
+            m_focused = (m_focused == i) ? -1 : i;
+            layoutTiles();
+            // 布局不变的图块不会触发 resize，质量按新的放大状态重新评估
+            for (Tile &tile : m_tiles)
+                updateTileQuality(tile, tile.surface->size() * tile.surface->devicePixelRatioF());
+            return true;
+        }
+    }
+    return QWidget::eventFilter(watched, event);
+}
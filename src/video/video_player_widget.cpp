@@ -3,10 +3,14 @@
 #include <QMessageBox>
 #include <QTimer>
 #include <QDebug>
-#include <QResizeEvent>
+#include <QStandardPaths>
+#include <QDir>
 
 VideoPlayerWidget::VideoPlayerWidget(QWidget *parent)
-    : QWidget(parent), m_decoder(new FFmpegDecoder(this)), m_currentCameraUrl("")
+    : QWidget(parent), m_streams(new StreamManager(this)), m_currentCameraUrl("")
+    , m_statsTimer(new QTimer(this))
+    , m_replay(new ReplayEngine(this))
+    , m_overlayTimer(new QTimer(this))
 {
     setupUI();
     setupConnections();
@@ -19,11 +23,18 @@ VideoPlayerWidget::VideoPlayerWidget(QWidget *parent)
     m_cameraPresets->addItem("boat1", "rtsp://60.205.13.156:8554/vrx_boat1");
     m_cameraPresets->addItem("boat2", "rtsp://60.205.13.156:8554/vrx_boat2");
     m_cameraPresets->addItem("boat3", "rtsp://60.205.13.156:8554/vrx_boat3");
+
+    // 所有船只摄像头在后台保持连接（热备），切换船只时无需重新连接
+    for (int i = 1; i < m_cameraPresets->count(); ++i) {
+        const QString url = m_cameraPresets->itemData(i).toString();
+        m_streams->addStandby(url);
+        m_mosaic->setStreamName(url, m_cameraPresets->itemText(i));
+    }
 }
 
 VideoPlayerWidget::~VideoPlayerWidget()
 {
-    m_decoder->stop();
+    // StreamManager 析构时各解码器自行停止
 }
 
 void VideoPlayerWidget::setupUI()
@@ -33,12 +44,29 @@ void VideoPlayerWidget::setupUI()
     m_mainLayout->setSpacing(5);
 
     // 视频显示区域 - 设置为可扩展
-    m_videoLabel = new QLabel("视频将在这里显示");
-    m_videoLabel->setAlignment(Qt::AlignCenter);
-    m_videoLabel->setStyleSheet("QLabel { background-color: black; color: white; }");
-    m_videoLabel->setMinimumSize(640, 480);
-    m_videoLabel->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
-    m_mainLayout->addWidget(m_videoLabel, 1);
+    m_videoSurface = new VideoSurfaceWidget();
+    m_videoSurface->clear("视频将在这里显示");
+    m_videoSurface->setMinimumSize(640, 480);
+    m_mainLayout->addWidget(m_videoSurface, 1);
+
+    // 宫格视图（默认隐藏，与单路显示表面互换）
+    m_mosaic = new VideoMosaicWidget(m_streams);
+    m_mosaic->setMinimumSize(640, 480);
+    m_mosaic->hide();
+    m_mainLayout->addWidget(m_mosaic, 1);
+
+    // 即时回放拖动条（回放模式下显示）
+    m_replayBar = new QWidget();
+    QHBoxLayout *replayLayout = new QHBoxLayout(m_replayBar);
+    replayLayout->setContentsMargins(0, 0, 0, 0);
+    m_replaySlider = new QSlider(Qt::Horizontal);
+    m_replayLabel = new QLabel("0.0 s");
+    m_replayLabel->setMinimumWidth(60);
+    replayLayout->addWidget(new QLabel("回放:"));
+    replayLayout->addWidget(m_replaySlider, 1);
+    replayLayout->addWidget(m_replayLabel);
+    m_replayBar->hide();
+    m_mainLayout->addWidget(m_replayBar);
 
     // 状态显示
     m_statusLabel = new QLabel("状态: 就绪");
@@ -68,6 +96,31 @@ void VideoPlayerWidget::setupUI()
     m_controlLayout->addWidget(m_playButton);
     m_controlLayout->addWidget(m_stopButton);
 
+    m_recordButton = new QPushButton("录像");
+    m_recordButton->setCheckable(true);
+    m_recordButton->setToolTip("将当前摄像头原样录制为分段 MP4（不转码）");
+    m_controlLayout->addWidget(m_recordButton);
+
+    m_overlayButton = new QPushButton("统计");
+    m_overlayButton->setCheckable(true);
+    m_overlayButton->setToolTip("在画面上显示延迟分位数、抖动、帧率与码率");
+    m_controlLayout->addWidget(m_overlayButton);
+
+    m_hudButton = new QPushButton("HUD");
+    m_hudButton->setCheckable(true);
+    m_hudButton->setToolTip("在画面上叠加地平线、航向带、航速与横滚");
+    m_controlLayout->addWidget(m_hudButton);
+
+    m_replayButton = new QPushButton("回放");
+    m_replayButton->setCheckable(true);
+    m_replayButton->setToolTip("回看当前摄像头最近一段时间的画面（拖动选择时刻）");
+    m_controlLayout->addWidget(m_replayButton);
+
+    m_mosaicButton = new QPushButton("宫格");
+    m_mosaicButton->setCheckable(true);
+    m_mosaicButton->setToolTip("同时显示所有船只摄像头，单击图块放大");
+    m_controlLayout->addWidget(m_mosaicButton);
+
     m_mainLayout->addLayout(m_controlLayout);
 }
 
@@ -75,14 +128,34 @@ void VideoPlayerWidget::setupConnections()
 {
     connect(m_playButton, &QPushButton::clicked, this, &VideoPlayerWidget::onPlayClicked);
     connect(m_stopButton, &QPushButton::clicked, this, &VideoPlayerWidget::onStopClicked);
+    connect(m_recordButton, &QPushButton::toggled, this, &VideoPlayerWidget::onRecordToggled);
+    connect(m_overlayButton, &QPushButton::toggled, this, &VideoPlayerWidget::onOverlayToggled);
+    m_overlayTimer->setInterval(250);
+    connect(m_overlayTimer, &QTimer::timeout, this, &VideoPlayerWidget::onOverlayTimer);
+    connect(m_hudButton, &QPushButton::toggled, m_videoSurface, &VideoSurfaceWidget::setHudEnabled);
+    connect(m_replayButton, &QPushButton::toggled, this, &VideoPlayerWidget::onReplayToggled);
+    connect(m_replaySlider, &QSlider::valueChanged, this, &VideoPlayerWidget::onReplaySliderMoved);
+    connect(m_replay, &ReplayEngine::frameReady, this, &VideoPlayerWidget::onReplayFrame);
+    connect(m_videoSurface, &VideoSurfaceWidget::displaySizeChanged,
+            m_replay, &ReplayEngine::setOutputSize);
+    connect(m_mosaicButton, &QPushButton::toggled, this, &VideoPlayerWidget::onMosaicToggled);
 
     // 修改摄像头选择信号连接
     connect(m_cameraPresets, QOverload<int>::of(&QComboBox::currentIndexChanged),
             this, &VideoPlayerWidget::onCameraPresetChanged);
 
-    connect(m_decoder, &FFmpegDecoder::frameReady, this, &VideoPlayerWidget::onFrameReady);
-    connect(m_decoder, &FFmpegDecoder::stateChanged, this, &VideoPlayerWidget::onStateChanged);
-    connect(m_decoder, &FFmpegDecoder::errorOccurred, this, &VideoPlayerWidget::onErrorOccurred);
+    connect(m_streams, &StreamManager::frameAvailable, this, &VideoPlayerWidget::onFrameAvailable);
+
+    // 显示区域尺寸与后备缓冲格式交给解码器，缩放和格式转换在转换线程中完成
+    connect(m_videoSurface, &VideoSurfaceWidget::displaySizeChanged,
+            m_streams, &StreamManager::setOutputSize);
+    connect(m_videoSurface, &VideoSurfaceWidget::backingFormatChanged,
+            m_streams, &StreamManager::setOutputFormat);
+    connect(m_streams, &StreamManager::stateChanged, this, &VideoPlayerWidget::onStateChanged);
+    connect(m_streams, &StreamManager::errorOccurred, this, &VideoPlayerWidget::onErrorOccurred);
+
+    m_statsTimer->setInterval(1000);
+    connect(m_statsTimer, &QTimer::timeout, this, &VideoPlayerWidget::onStatsTimer);
 }
 
 void VideoPlayerWidget::setCurrentBoat(const QString &boatName)
@@ -103,6 +176,11 @@ void VideoPlayerWidget::setCurrentBoat(const QString &boatName)
     }
 }
 
+void VideoPlayerWidget::setHudTelemetry(const HudTelemetry &telemetry)
+{
+    m_videoSurface->setHudTelemetry(telemetry);
+}
+
 void VideoPlayerWidget::onCameraPresetChanged(int index)
 {
     if (index > 0) {
@@ -121,36 +199,15 @@ void VideoPlayerWidget::onCameraPresetChanged(int index)
 void VideoPlayerWidget::playSelectedCamera()
 {
     QString url = m_urlEdit->text().trimmed();
-    if (url.isEmpty()) {
-        return;
+    if (url.isEmpty() || url == m_currentCameraUrl) {
+        return; // 同一个摄像头不执行任何操作
     }
 
-    // 如果当前正在播放其他摄像头，先停止
-    if (m_decoder->getState() == FFmpegDecoder::Playing && url != m_currentCameraUrl) {
-        m_decoder->stop();
-        // 清空视频显示
-        m_videoLabel->setText("正在切换摄像头...");
-        m_cachedPixmap = QPixmap();
-
-        // 使用单次定时器，确保停止操作完成后再开始新的播放
-        QTimer::singleShot(100, [this, url]() {
-            if (m_decoder->openStream(url)) {
-                m_currentCameraUrl = url;
-                m_playButton->setEnabled(false);
-                m_stopButton->setEnabled(true);
-                m_statusLabel->setText("状态: 切换摄像头中...");
-            }
-        });
-    } else if (m_decoder->getState() != FFmpegDecoder::Playing) {
-        // 当前没有播放，直接开始
-        if (m_decoder->openStream(url)) {
-            m_currentCameraUrl = url;
-            m_playButton->setEnabled(false);
-            m_stopButton->setEnabled(true);
-            m_statusLabel->setText("状态: 连接中...");
-        }
-    }
-    // 如果选择的是同一个摄像头，不执行任何操作
+    // 热备切换：目标流已在后台连接，立即显示其最新关键帧并追到实时画面
+    m_streams->activate(url);
+    m_currentCameraUrl = url;
+    m_playButton->setEnabled(false);
+    m_stopButton->setEnabled(true);
 }
 
 void VideoPlayerWidget::onPlayClicked()
@@ -161,51 +218,233 @@ void VideoPlayerWidget::onPlayClicked()
         return;
     }
 
-    if (m_decoder->openStream(url)) {
-        m_currentCameraUrl = url;
-        m_playButton->setEnabled(false);
-        m_stopButton->setEnabled(true);
-        m_statusLabel->setText("状态: 连接中...");
-    }
+    m_streams->activate(url);
+    m_currentCameraUrl = url;
+    m_playButton->setEnabled(false);
+    m_stopButton->setEnabled(true);
 }
 
 void VideoPlayerWidget::onStopClicked()
 {
-    m_decoder->stop();
+    m_streams->deactivate();
     m_playButton->setEnabled(true);
     m_stopButton->setEnabled(false);
     m_statusLabel->setText("状态: 已停止");
     m_currentCameraUrl = "";
 
     // 清空视频显示
-    m_videoLabel->setText("视频将在这里显示");
-    m_cachedPixmap = QPixmap();
+    m_videoSurface->clear("视频将在这里显示");
 }
 
-void VideoPlayerWidget::onFrameReady(const QImage &frame)
+void VideoPlayerWidget::onRecordToggled(bool checked)
 {
-    // 如果帧大小改变或窗口大小改变，重新计算缩放
-    if (m_lastFrameSize != frame.size() || m_cachedPixmap.isNull()) {
-        m_lastFrameSize = frame.size();
-
-        // 计算保持宽高比的缩放
-        QSize labelSize = m_videoLabel->size();
-        QPixmap pixmap = QPixmap::fromImage(frame);
+    if (!checked) {
+        if (m_recordingDecoder) {
+            m_recordingDecoder->stopRecording();
+            m_recordingDecoder = nullptr;
+        }
+        return;
+    }
 
-        // 计算缩放后的大小，保持宽高比
-        QSize scaledSize = frame.size();
-        scaledSize.scale(labelSize, Qt::KeepAspectRatio);
+    // 录制当前流；切换到其他船只后该流（热备）继续录制，直到再次点击
+    FFmpegDecoder *decoder = m_streams->activeDecoder();
+    if (!decoder) {
+        m_recordButton->setChecked(false);
+        return;
+    }
+    QString name = "camera";
+    for (int i = 1; i < m_cameraPresets->count(); ++i) {
+        if (m_cameraPresets->itemData(i).toString() == m_streams->activeUrl())
+            name = m_cameraPresets->itemText(i);
+    }
+    const QString dir = QDir(QStandardPaths::writableLocation(QStandardPaths::MoviesLocation))
+                            .filePath("BoatRecordings");
+    if (!decoder->startRecording(dir, name)) {
+        QMessageBox::warning(this, "录像", "无法创建录像目录: " + dir);
+        m_recordButton->setChecked(false);
+        return;
+    }
+    m_recordingDecoder = decoder;
+}
 
-        m_cachedPixmap = pixmap.scaled(scaledSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+void VideoPlayerWidget::onOverlayToggled(bool checked)
+{
+    if (checked) {
+        m_overlayDecoder = nullptr;     // 首次刷新时重新取基准
+        m_overlayTimer->start();
+        onOverlayTimer();
     } else {
-        // 直接使用缓存的缩放设置，只更新图像内容
-        QPixmap tempPixmap = QPixmap::fromImage(frame);
-        m_cachedPixmap = tempPixmap.scaled(m_cachedPixmap.size(),
-                                         Qt::IgnoreAspectRatio,
-                                         Qt::SmoothTransformation);
+        m_overlayTimer->stop();
+        m_videoSurface->setOverlayLines(QStringList());
+    }
+}
+
+void VideoPlayerWidget::onOverlayTimer()
+{
+    FFmpegDecoder *decoder = m_streams->activeDecoder();
+    if (!decoder) {
+        m_videoSurface->setOverlayLines(QStringList());
+        return;
     }
 
-    m_videoLabel->setPixmap(m_cachedPixmap);
+    // 帧率按两次刷新之间的计数差计算；切换流后重新取基准
+    const VideoFrameStats frames = decoder->frameStats();
+    const qint64 nowMs = m_overlayClock.isValid() ? m_overlayClock.elapsed() : 0;
+    if (decoder != m_overlayDecoder || !m_overlayClock.isValid()) {
+        m_overlayDecoder = decoder;
+        m_overlayFrames = frames;
+        m_overlayClock.start();
+        decoder->latencySnapshot();     // 重置码率计算区间
+        return;
+    }
+    const double dt = qMax<qint64>(1, nowMs) / 1000.0;
+    const double decodedFps = (frames.decoded - m_overlayFrames.decoded) / dt;
+    const double droppedFps = (frames.dropped - m_overlayFrames.dropped) / dt;
+    m_overlayFrames = frames;
+    m_overlayClock.restart();
+
+    const LatencySnapshot lat = decoder->latencySnapshot();
+    QStringList lines;
+    lines << QString("%1  p50 %2  p95 %3  p99 %4 ms")
+                 .arg(lat.glassToGlass ? "端到端" : "收包→显示")
+                 .arg(lat.p50Ms, 0, 'f', 0).arg(lat.p95Ms, 0, 'f', 0).arg(lat.p99Ms, 0, 'f', 0);
+    lines << QString("解码 %1  转换 %2  交接 %3 ms (p50)")
+                 .arg(lat.decodeP50Ms, 0, 'f', 1).arg(lat.convertP50Ms, 0, 'f', 1).arg(lat.handoffP50Ms, 0, 'f', 1);
+    lines << QString("抖动 %1 ms  码率 %2 kbps")
+                 .arg(lat.jitterMs, 0, 'f', 1).arg(lat.bitrateKbps, 0, 'f', 0);
+    lines << QString("解码 %1 fps  丢弃 %2 fps  样本 %3")
+                 .arg(decodedFps, 0, 'f', 1).arg(droppedFps, 0, 'f', 1).arg(lat.samples);
+    const DecodeGovernorStats gov = decoder->governorStats();
+    lines << QString("%1多线程 ×%2  丢帧级 %3  解码占用 %4%  界面 %5 ms")
+                 .arg(gov.sliceThreading ? "片级" : "帧级").arg(gov.threads).arg(gov.skipLevel)
+                 .arg(qRound(gov.decodeLoad * 100)).arg(gov.guiFrameMs, 0, 'f', 0);
+    lines << QString("调控%1 降%2 升%3  %4")
+                 .arg(gov.adaptive ? "" : "(固定)").arg(gov.downgrades).arg(gov.upgrades).arg(gov.lastDecision);
+    m_videoSurface->setOverlayLines(lines);
+}
+
+void VideoPlayerWidget::onReplayToggled(bool checked)
+{
+    FFmpegDecoder *decoder = m_streams->activeDecoder();
+    const PacketRing::Span span = decoder ? decoder->replayRing()->span() : PacketRing::Span();
+    if (checked && !span.isValid()) {
+        m_replayButton->setChecked(false);
+        return;
+    }
+
+    m_replayMode = checked;
+    m_replayBar->setVisible(checked);
+    if (!checked) {
+        // 回到实时画面：下一帧到达即显示
+        m_replay->setSource(nullptr);
+        onFrameAvailable();
+        return;
+    }
+
+    // 以进入回放时的最新包为时间零点，拖动条范围为回放环覆盖的时间
+    m_replay->setOutputSize(m_videoSurface->size() * m_videoSurface->devicePixelRatioF());
+    m_replay->setSource(decoder->replayRing());
+    m_replayEdgeMs = span.lastMs;
+    const QSignalBlocker blocker(m_replaySlider);
+    m_replaySlider->setRange(int(span.firstMs - span.lastMs), 0);
+    m_replaySlider->setSingleStep(100);
+    m_replaySlider->setPageStep(5000);
+    m_replaySlider->setValue(0);
+    onReplaySliderMoved(0);
+}
+
+void VideoPlayerWidget::onReplaySliderMoved(int offsetMs)
+{
+    m_replayLabel->setText(QString("%1 s").arg(offsetMs / 1000.0, 0, 'f', 1));
+    m_replay->seek(m_replayEdgeMs + offsetMs);
+}
+
+void VideoPlayerWidget::onReplayFrame(const QImage &frame, qint64 wallMs)
+{
+    Q_UNUSED(wallMs);
+    if (m_replayMode) {
+        m_videoSurface->setFrame(frame);
+    }
+}
+
+void VideoPlayerWidget::onMosaicToggled(bool checked)
+{
+    // 宫格模式下各图块自行从解码器取帧，单路显示表面隐藏
+    m_videoSurface->setVisible(!checked);
+    m_mosaic->setVisible(checked);
+    m_mosaic->setMosaicActive(checked);
+}
+
+void VideoPlayerWidget::onFrameAvailable()
+{
+    if (m_streams->isMosaicMode()) {
+        return;     // 帧由宫格图块取走
+    }
+    if (m_replayMode) {
+        return;     // 回放中，实时帧留在信箱里（只保留最新一帧）
+    }
+
+    // 只取信箱中最新的一帧；缓冲区来自解码器帧池，显示表面直接持有
+    FFmpegDecoder *decoder = m_streams->activeDecoder();
+    QImage frame;
+    if (decoder && decoder->takeFrame(frame)) {
+        m_videoSurface->setFrame(frame);
+    }
+}
+
+void VideoPlayerWidget::onStatsTimer()
+{
+    FFmpegDecoder *decoder = m_streams->activeDecoder();
+    if (!decoder) {
+        return;
+    }
+    const VideoFrameStats stats = decoder->frameStats();
+    const VideoPipelineStats pipe = decoder->pipelineStats();
+    m_statusLabel->setText(QString("状态: %1 | 解码 %2 fps  显示 %3 fps  丢帧 %4"
+                                   " | 解码 %5/%6 ms  转换 %7/%8 ms  包队列 %9/%10")
+                               .arg(m_stateText)
+                               .arg(stats.decoded - m_lastStats.decoded)
+                               .arg(stats.displayed - m_lastStats.displayed)
+                               .arg(stats.dropped)
+                               .arg(pipe.decode.avgMs, 0, 'f', 1)
+                               .arg(pipe.decode.maxMs, 0, 'f', 1)
+                               .arg(pipe.convert.avgMs, 0, 'f', 1)
+                               .arg(pipe.convert.maxMs, 0, 'f', 1)
+                               .arg(pipe.decode.queued)
+                               .arg(pipe.decode.capacity));
+
+    // 首帧耗时（热打开使用了参数缓存）
+    const VideoOpenStats open = decoder->openStats();
+    if (open.ttffMs >= 0) {
+        m_statusLabel->setText(m_statusLabel->text()
+                               + QString(" | 首帧 %1 ms (%2)").arg(open.ttffMs).arg(open.warm ? "热" : "冷"));
+    }
+    if (open.outageMs >= 0)
+        m_statusLabel->setText(m_statusLabel->text() + QString(" | 断流 %1 ms").arg(open.outageMs));
+
+    if (m_recordingDecoder) {
+        const VideoRecorderStats rec = m_recordingDecoder->recorderStats();
+        m_statusLabel->setText(m_statusLabel->text()
+                               + QString(" | 录像 %1 段 %2 MB 丢包 %3")
+                                     .arg(rec.segments)
+                                     .arg(rec.bytesWritten / (1024.0 * 1024.0), 0, 'f', 1)
+                                     .arg(rec.dropped));
+    }
+
+    // 连接健康：网络卡顿 / 超时与解码错误分开统计
+    const VideoHealthStats health = decoder->healthStats();
+    if (health.stalls || health.timeouts || health.readErrors || health.decodeErrors || health.ptsGaps) {
+        m_statusLabel->setText(m_statusLabel->text()
+                               + QString(" | 网络卡顿 %1 (最长 %2 ms) 超时 %3 重连 %4 丢帧跳变 %5 | 读错误 %6 解码错误 %7")
+                                     .arg(health.stalls)
+                                     .arg(health.longestStallMs)
+                                     .arg(health.timeouts)
+                                     .arg(health.reconnects)
+                                     .arg(health.ptsGaps)
+                                     .arg(health.readErrors)
+                                     .arg(health.decodeErrors));
+    }
+    m_lastStats = stats;
 }
 
 void VideoPlayerWidget::onStateChanged(int state)
@@ -223,6 +462,9 @@ void VideoPlayerWidget::onStateChanged(int state)
     case FFmpegDecoder::Playing:
         stateText = "播放中";
         break;
+    case FFmpegDecoder::Reconnecting:
+        stateText = "连接断开，重连中...";     // 画面保持最后一帧
+        break;
     case FFmpegDecoder::Error:
         stateText = "错误";
         m_playButton->setEnabled(true);
@@ -231,7 +473,17 @@ void VideoPlayerWidget::onStateChanged(int state)
         break;
     }
 
+    m_stateText = stateText;
     m_statusLabel->setText(QString("状态: %1").arg(stateText));
+
+    // 播放 / 重连时每秒刷新帧率与连接统计
+    if ((state == FFmpegDecoder::Playing || state == FFmpegDecoder::Reconnecting)
+        && m_streams->activeDecoder()) {
+        m_lastStats = m_streams->activeDecoder()->frameStats();
+        m_statsTimer->start();
+    } else {
+        m_statsTimer->stop();
+    }
 }
 
 void VideoPlayerWidget::onErrorOccurred(const QString &errorMessage)
@@ -240,12 +492,3 @@ void VideoPlayerWidget::onErrorOccurred(const QString &errorMessage)
     m_statusLabel->setText("状态: 错误 - " + errorMessage);
     m_currentCameraUrl = ""; // 出错时清空当前URL
 }
-
-void VideoPlayerWidget::resizeEvent(QResizeEvent *event)
-{
-    QWidget::resizeEvent(event);
-
-    // 窗口大小改变时，清空缓存，强制重新计算缩放
-    m_cachedPixmap = QPixmap();
-}
-
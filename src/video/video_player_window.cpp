@@ -26,6 +26,13 @@ void VideoPlayerWindow::setCurrentBoat(const QString &boatName)
     }
 }
 
+void VideoPlayerWindow::setHudTelemetry(const HudTelemetry &telemetry)
+{
+    if (m_videoPlayerWidget) {
+        m_videoPlayerWidget->setHudTelemetry(telemetry);
+    }
+}
+
 void VideoPlayerWindow::closeEvent(QCloseEvent *event)
 {
     emit windowClosed();
@@ -0,0 +1,140 @@
+#include "video/video_surface_widget.h"
+#include <QPainter>
+#include <QResizeEvent>
+#include <QDateTime>
+
+VideoSurfaceWidget::VideoSurfaceWidget(QWidget *parent)
+    : QWidget(parent)
+{
+    setAttribute(Qt::WA_OpaquePaintEvent);
+    setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
+}
+
+void VideoSurfaceWidget::setFrame(const QImage &frame)
+{
+    m_frame = frame;
+    m_sinceFrame.start();
+    update();
+}
+
+void VideoSurfaceWidget::clear(const QString &placeholder)
+{
+    m_frame = QImage();     // 释放当前帧，缓冲区归还帧池
+    m_placeholder = placeholder;
+    update();
+}
+
+void VideoSurfaceWidget::setCaption(const QString &caption)
+{
+    m_caption = caption;
+    update();
+}
+
+void VideoSurfaceWidget::setOverlayLines(const QStringList &lines)
+{
+    if (lines == m_overlay)
+        return;
+    m_overlay = lines;
+    update();
+}
+
+void VideoSurfaceWidget::setHudEnabled(bool enabled)
+{
+    if (enabled == m_hudEnabled)
+        return;
+    m_hudEnabled = enabled;
+    update();
+}
+
+void VideoSurfaceWidget::setHudTelemetry(const HudTelemetry &telemetry)
+{
+    if (!m_hud.setTelemetry(telemetry) || !m_hudEnabled || m_frame.isNull())
+        return;
+    // 视频正常刷新时下一帧顺带画出新数据，不为遥测额外重绘整幅画面
+    if (m_sinceFrame.isValid() && m_sinceFrame.elapsed() < 100)
+        return;
+    update(frameRect());
+}
+
+QRect VideoSurfaceWidget::frameRect() const
+{
+    if (m_frame.isNull())
+        return QRect();
+
+    // 帧按设备像素输出：尺寸匹配时逻辑大小即控件大小，1:1 绘制；
+    // 否则（窗口刚调整、新尺寸的帧尚未到达）临时缩放到控件内
+    const qreal dpr = devicePixelRatioF();
+    QSize s = (QSizeF(m_frame.size()) / dpr).toSize();
+    if (s.width() > width() || s.height() > height() || (s.width() < width() && s.height() < height()))
+        s.scale(size(), Qt::KeepAspectRatio);
+    return QRect(QPoint((width() - s.width()) / 2, (height() - s.height()) / 2), s);
+}
+
+void VideoSurfaceWidget::resizeEvent(QResizeEvent *event)
+{
+    QWidget::resizeEvent(event);
+    emit displaySizeChanged(event->size() * devicePixelRatioF());
+}
+
+void VideoSurfaceWidget::paintEvent(QPaintEvent *)
+{
+    QPainter p(this);
+
+    // 光栅引擎下实际绘制目标是窗口后备缓冲（QImage），其格式决定贴图是否需要转换
+    const QPaintDevice *device = p.paintEngine() ? p.paintEngine()->paintDevice() : nullptr;
+    if (device && device->devType() == QInternal::Image) {
+        const QImage::Format format = static_cast<const QImage *>(device)->format();
+        if (format != m_backingFormat) {
+            m_backingFormat = format;
+            emit backingFormatChanged(format);
+        }
+    }
+
+    if (m_frame.isNull()) {
+        p.fillRect(rect(), Qt::black);
+        p.setPen(Qt::white);
+        p.drawText(rect(), Qt::AlignCenter, m_placeholder);
+        if (!m_caption.isEmpty())
+            p.drawText(rect().adjusted(8, 6, -8, -6), Qt::AlignLeft | Qt::AlignTop, m_caption);
+        return;
+    }
+
+    // 只填充画面外的黑边，画面区域直接覆盖
+    const QRect target = frameRect();
+    const QRegion border = QRegion(rect()).subtracted(target);
+    for (const QRect &r : border)
+        p.fillRect(r, Qt::black);
+
+    // 视频帧不透明：Source 模式跳过 alpha 混合，格式一致时直接拷贝
+    p.setCompositionMode(QPainter::CompositionMode_Source);
+    p.drawImage(target, m_frame);
+    p.setCompositionMode(QPainter::CompositionMode_SourceOver);
+
+    if (m_hudEnabled)
+        m_hud.paint(p, target, devicePixelRatioF(), QDateTime::currentMSecsSinceEpoch());
+
+    if (!m_caption.isEmpty()) {
+        p.setPen(Qt::white);
+        p.drawText(rect().adjusted(8, 6, -8, -6), Qt::AlignLeft | Qt::AlignTop, m_caption);
+    }
+
+    if (!m_overlay.isEmpty()) {
+        // 统计浮层：半透明底，等宽字体，右上角
+        QFont font("monospace");
+        font.setStyleHint(QFont::TypeWriter);
+        font.setPointSizeF(9);
+        p.setFont(font);
+        const QFontMetrics fm(font);
+        int textWidth = 0;
+        for (const QString &line : std::as_const(m_overlay))
+            textWidth = qMax(textWidth, fm.horizontalAdvance(line));
+        const QRect box(width() - textWidth - 20, 8, textWidth + 12, fm.height() * m_overlay.size() + 8);
+        p.fillRect(box, QColor(0, 0, 0, 160));
+        p.setPen(QColor(120, 255, 120));
+        int y = box.top() + 4 + fm.ascent();
+        for (const QString &line : std::as_const(m_overlay)) {
+            p.drawText(box.left() + 6, y, line);
+            y += fm.height();
+        }
+    }
+}
@@ -14,7 +14,7 @@ constexpr double kArcEndPhi   = 340.0;
 // 构造函数
 // ============================================================
 RollGaugeWidget::RollGaugeWidget(QWidget* parent)
-    : QWidget(parent)
+    : ThreadedGaugeWidget(parent)
 {
     setAttribute(Qt::WA_OpaquePaintEvent);
     setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Preferred);
@@ -32,7 +32,7 @@ RollGaugeWidget::RollGaugeWidget(QWidget* parent)
 void RollGaugeWidget::setRollValue(double val)
 {
     roll_deg_ = val;
-    update();
+    requestRepaint();
 }
 
 // ============================================================
@@ -72,38 +72,48 @@ double RollGaugeWidget::valueToArcPhi(double v)
 }
 
 // ============================================================
-// 绘制事件：核心绘图逻辑
+// 数据快照：按值捕获当前横滚角
 // ============================================================
-void RollGaugeWidget::paintEvent(QPaintEvent*)
+ThreadedGaugeWidget::SceneFn RollGaugeWidget::snapshotScene() const
 {
-    QPainter p(this);
-    p.fillRect(rect(), QColor(0, 0, 0));  // 背景黑色
+    return [rollDeg = roll_deg_](QPainter& p, const QSize& size) {
+        paintScene(p, size, rollDeg);
+    };
+}
+
+// ============================================================
+// 场景绘制：核心绘图逻辑
+// ============================================================
+void RollGaugeWidget::paintScene(QPainter& p, const QSize& size, double rollDeg)
+{
+    const QRect bounds(QPoint(0, 0), size);
+    p.fillRect(bounds, QColor(0, 0, 0));  // 背景黑色
     p.setRenderHint(QPainter::Antialiasing, true);
 
-    QRectF rc = rect().adjusted(20, 10, -20, -10);
+    QRectF rc = bounds.adjusted(20, 10, -20, -10);
     double r = rc.width() * 0.53;
     QPointF C(rc.center().x(), rc.bottom() - r * 0.9 - 40);
 
-    // -------------------- 1. 绘制标题与实时数值 --------------------
-    QFont f("Microsoft YaHei");
-    f.setBold(true);
+    // 字体按线程缓存：QFont 内部数据首次使用时才填充，渲染线程之间不能共用
+    thread_local const QFont kTitleFont("Microsoft YaHei", 20, QFont::Bold);
+    thread_local const QFont kValueFont("Microsoft YaHei", 25, QFont::Bold);
+    thread_local const QFont kScaleFont("Microsoft YaHei", 16, QFont::Bold);
 
+    // -------------------- 1. 绘制标题与实时数值 --------------------
     // 左上角标题 —— 固定相对容器边距绘制
-    f.setPointSize(20);
-    p.setFont(f);
+    p.setFont(kTitleFont);
     p.setPen(QColor("#9E9E9E"));
-    QFontMetrics fmTitle(f);
+    QFontMetrics fmTitle = p.fontMetrics();
     int marginX = 20;
     int marginY = fmTitle.ascent() + 10;  // 顶部留白
     p.drawText(marginX, marginY, "ROLL");
 
     // 右上角实时数值 —— 自动右对齐
-    f.setPointSize(25);
-    p.setFont(f);
+    p.setFont(kValueFont);
     p.setPen(Qt::white);
-    QString valText = QString::number(fabs(roll_deg_), 'f', 2) + QString::fromUtf8("°");
-    QFontMetrics fmVal(f);
-    int valX = width() - fmVal.horizontalAdvance(valText) - marginX;
+    QString valText = QString::number(fabs(rollDeg), 'f', 2) + QString::fromUtf8("°");
+    QFontMetrics fmVal = p.fontMetrics();
+    int valX = size.width() - fmVal.horizontalAdvance(valText) - marginX;
     int valY = fmVal.ascent() + 10;
     p.drawText(valX, valY, valText);
 
@@ -134,15 +144,13 @@ void RollGaugeWidget::paintEvent(QPaintEvent*)
             QString txt = QString::number(std::abs(v));
             QPointF T = pointOnCirclePhi(C, r + labelOff, phi);
             p.setPen(QColor(230, 230, 230));
-            f.setPointSize(16);
-            f.setBold(true);
-            p.setFont(f);
+            p.setFont(kScaleFont);
             p.drawText(QRectF(T.x() - 18, T.y() - 12, 36, 24), Qt::AlignCenter, txt);
         }
     }
 
     // -------------------- 4. 绘制绿色倒三角指针 --------------------
-    double phi_val = valueToArcPhi(roll_deg_);
+    double phi_val = valueToArcPhi(rollDeg);
     double tip_radius = r - majorLen * 1.4;
     QPointF tip = pointOnCirclePhi(C, tip_radius, phi_val);
     double rad = qDegreesToRadians(phi_val);
@@ -1,4 +1,5 @@
 #include "wind_roll/wind_gauge.h"
+#include "render/numeric_readout.h"
 #include <QFont>
 #include <QDebug>
 #include <QPalette>
@@ -45,8 +46,10 @@ void WindGauge::setupLayout()
     dirLabel = new QLabel("WDIR", this);
     spdLabel = new QLabel("WSPD", this);
 
-    dirValueLabel = new QLabel("--°", this);
-    spdValueLabel = new QLabel("-- m/s", this);
+    dirValueLabel = new NumericReadout("--°", this);
+    spdValueLabel = new NumericReadout("-- m/s", this);
+    dirValueLabel->setWidthTemplate("000.0°");
+    spdValueLabel->setWidthTemplate("00.0 m/s");
 
     for (auto lbl : {dirLabel, spdLabel}) {
         lbl->setFont(labelFont);
@@ -54,9 +57,9 @@ void WindGauge::setupLayout()
     }
 
     for (auto val : {dirValueLabel, spdValueLabel}) {
-        val->setFont(valueFont);
-        val->setStyleSheet("color: white;");
+        val->setTextFont(valueFont);
     }
+    spdValueLabel->setAlignment(Qt::AlignRight | Qt::AlignVCenter);
 
     // ==== DIRECTION 一列 ====
     QVBoxLayout *dirCol = new QVBoxLayout();
@@ -126,6 +129,9 @@ void WindGauge::setRoll(double deg)
  */
 void WindGauge::updateLabels()
 {
-    dirValueLabel->setText(QString::number(direction, 'f', 1) + QChar(0x00B0));
-    spdValueLabel->setText(QString::number(speed, 'f', 1) + " m/s");
+    static const QString kSuffixDeg = QString(QChar(0x00B0));
+    static const QString kSuffixSpeed = QStringLiteral(" m/s");
+
+    dirValueLabel->setValue(direction, 1, kSuffixDeg);
+    spdValueLabel->setValue(speed, 1, kSuffixSpeed);
 }
@@ -5,7 +5,7 @@
 // =============================
 // 构造函数
 // =============================
-WindRoseWidget::WindRoseWidget(QWidget* parent) : QWidget(parent)
+WindRoseWidget::WindRoseWidget(QWidget* parent) : ThreadedGaugeWidget(parent)
 {
     setAttribute(Qt::WA_OpaquePaintEvent);  // 禁止父控件擦除背景，防止闪烁
     // setMinimumSize(200, 200);               // 设置最小尺寸，避免组件太小重叠
@@ -36,6 +36,9 @@ void WindRoseWidget::drawScale(QPainter& p, const QRectF& rc, double r, double&
 
     p.setRenderHint(QPainter::Antialiasing, true);             // 抗锯齿使线条平滑
 
+    // 刻度数字字体：在循环外构造一次
+    QFont labelFont = p.font(); labelFont.setPointSize(12); labelFont.setBold(true);
+
     // 每 5° 一小刻度，30° 一大刻度
     for (int a = 0; a < 360; a += 5) {
         bool major = (a % 30 == 0);                            // 每 30° 为大刻度
@@ -52,8 +55,7 @@ void WindRoseWidget::drawScale(QPainter& p, const QRectF& rc, double r, double&
             QPointF T = polarPoint(rc.center(), r * 1.22, a);  // 数字位置（在圆外）
             QRectF tr(T.x() - 20, T.y() - 14, 40, 28);         // 文本矩形
 
-            QFont f = p.font(); f.setPointSize(12); f.setBold(true);
-            p.setFont(f);
+            p.setFont(labelFont);
             p.setPen(Qt::white);
             p.drawText(tr, Qt::AlignCenter, QString::number(label_val)); // 居中绘制数字
         }
@@ -100,17 +102,27 @@ void WindRoseWidget::drawPointerTriangle(QPainter& p, const QPointF& c, double r
     p.restore();
 }
 
+// =============================
+// 数据快照：按值捕获风向与指针颜色
+// =============================
+ThreadedGaugeWidget::SceneFn WindRoseWidget::snapshotScene() const
+{
+    return [dirDeg = true_dir_deg_, color = trueColor_](QPainter& p, const QSize& size) {
+        paintScene(p, size, dirDeg, color);
+    };
+}
+
 // =============================
 // 主绘制函数：整个风向盘绘制入口
 // =============================
-void WindRoseWidget::paintEvent(QPaintEvent*)
+void WindRoseWidget::paintScene(QPainter& p, const QSize& size, double dirDeg, const QColor& color)
 {
-    QPainter p(this);
-    p.fillRect(rect(), QColor(0, 0, 0));                       // 黑色背景（仪表风格）
+    const QRect bounds(QPoint(0, 0), size);
+    p.fillRect(bounds, QColor(0, 0, 0));                       // 黑色背景（仪表风格）
 
     // 自适应边距（留出绘图空隙）
-    double margin = qMin(width(), height()) * 0.1452;
-    QRectF rc = rect().adjusted(margin - 10, margin, -margin + 20, -margin);
+    double margin = qMin(size.width(), size.height()) * 0.1452;
+    QRectF rc = bounds.adjusted(margin - 10, margin, -margin + 20, -margin);
 
     // 圆半径按比例计算 —— 这是控制风向盘大小的核心参数
     double r = qMin(rc.width(), rc.height()) * 0.44;
@@ -125,5 +137,5 @@ void WindRoseWidget::paintEvent(QPaintEvent*)
     p.drawEllipse(rc.center(), 4, 4);
 
     // 指针（可扩展为多层）
-    drawPointerTriangle(p, rc.center(), r, true_dir_deg_, trueColor_); // 主风向
+    drawPointerTriangle(p, rc.center(), r, dirDeg, color);     // 主风向
 }
@@ -0,0 +1,196 @@
+// tst_packetring —— PacketRing 回放环单元测试
+//
+// 混合大小的关键帧与 P 帧多次绕过环形内存区，逐包核对取出的数据与输入一致、
+// 取出的包序列连续且从关键帧开始。
+
+#include <QtTest>
+#include <QVector>
+#include "backend/packetring.h"
+
+namespace {
+constexpr qint64 kBudget = 256 * 1024;
+constexpr qint64 kFrameMs = 33;
+
+// 确定性伪随机数（各平台结果一致）
+class Lcg
+{
+public:
+    explicit Lcg(quint32 seed) : m_state(seed) {}
+    int bounded(int lo, int hi)     // [lo, hi]
+    {
+        m_state = m_state * 1664525u + 1013904223u;
+        return lo + int((m_state >> 8) % quint32(hi - lo + 1));
+    }
+
+private:
+    quint32 m_state;
+};
+
+// 包内容由 pts 与字节位置决定，取出后可直接重算比对
+quint8 patternByte(int64_t pts, int i)
+{
+    return quint8((pts * 131 + i * 7 + (i >> 8)) & 0xff);
+}
+
+void fillPattern(AVPacket *pkt, int64_t pts)
+{
+    for (int i = 0; i < pkt->size; ++i)
+        pkt->data[i] = patternByte(pts, i);
+}
+
+bool matchesPattern(const AVPacket *pkt, int64_t pts)
+{
+    for (int i = 0; i < pkt->size; ++i) {
+        if (pkt->data[i] != patternByte(pts, i))
+            return false;
+    }
+    return true;
+}
+}
+
+class TestPacketRing : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void extractMatchesInputAcrossWraps_data();
+    void extractMatchesInputAcrossWraps();
+    void oversizedGopWaitsForKeyframe();
+
+private:
+    static AVCodecParameters *videoParams();
+    static void verifyExtract(const PacketRing &ring, qint64 targetMs, const QVector<int> &sizes,
+                              const QVector<bool> &keys);
+};
+
+AVCodecParameters *TestPacketRing::videoParams()
+{
+    AVCodecParameters *par = avcodec_parameters_alloc();
+    par->codec_type = AVMEDIA_TYPE_VIDEO;
+    par->codec_id = AV_CODEC_ID_H264;
+    par->width = 1280;
+    par->height = 720;
+    return par;
+}
+
+void TestPacketRing::verifyExtract(const PacketRing &ring, qint64 targetMs, const QVector<int> &sizes,
+                                   const QVector<bool> &keys)
+{
+    QVector<ReplayPacket> out;
+    PacketRing::ExtractInfo info;
+    const bool ok = ring.extract(targetMs, 0, 0, out, &info);
+    const PacketRing::Span span = ring.span();
+    QCOMPARE(ok, span.isValid());
+
+    bool matched = true;
+    int64_t expectedPts = out.isEmpty() ? 0 : out.first().packet->pts;
+    for (const ReplayPacket &rp : std::as_const(out)) {
+        const AVPacket *pkt = rp.packet;
+        matched = matched && pkt->pts == expectedPts && pkt->size == sizes.at(int(pkt->pts))
+                  && matchesPattern(pkt, pkt->pts);
+        ++expectedPts;
+    }
+    const bool startsAtKey = out.isEmpty()
+        || ((out.first().packet->flags & AV_PKT_FLAG_KEY) && keys.at(int(out.first().packet->pts)));
+    const qint64 lastMs = out.isEmpty() ? 0 : out.last().wallMs;
+
+    for (ReplayPacket &rp : out)
+        av_packet_free(&rp.packet);
+
+    QVERIFY(matched);
+    QVERIFY(startsAtKey);
+    if (ok) {
+        QCOMPARE(lastMs, info.lastWallMs);
+        QVERIFY(lastMs <= qMax(targetMs, span.firstMs));
+    }
+}
+
+void TestPacketRing::extractMatchesInputAcrossWraps_data()
+{
+    // GOP 越短，回绕时区尾越可能残留上一轮的关键帧
+    QTest::addColumn<int>("maxGop");
+    QTest::newRow("intra") << 0;
+    QTest::newRow("gop<=3") << 2;
+    QTest::newRow("gop<=5") << 4;
+    QTest::newRow("gop<=9") << 8;
+    QTest::newRow("gop<=31") << 30;
+}
+
+void TestPacketRing::extractMatchesInputAcrossWraps()
+{
+    QFETCH(int, maxGop);
+
+    PacketRing ring(kBudget);
+    AVCodecParameters *par = videoParams();
+    ring.beginSession(par, AVRational{ 1, 90000 });
+    avcodec_parameters_free(&par);
+
+    Lcg rng(12345);
+    QVector<int> sizes;
+    QVector<bool> keys;
+    int gopLeft = 0;
+    qint64 written = 0;
+
+    // 约 60 次绕回；关键帧最大到预算的四分之一，常在区尾附近触发回绕
+    for (int64_t pts = 0; written < 60 * kBudget; ++pts) {
+        const bool key = gopLeft == 0;
+        gopLeft = key ? rng.bounded(0, maxGop) : gopLeft - 1;
+        const int size = key ? rng.bounded(int(kBudget / 16), int(kBudget / 4)) : rng.bounded(64, 12 * 1024);
+        sizes.append(size);
+        keys.append(key);
+        written += size;
+
+        AVPacket *pkt = av_packet_alloc();
+        QVERIFY(pkt && av_new_packet(pkt, size) == 0);
+        fillPattern(pkt, pts);
+        pkt->pts = pkt->dts = pts;
+        pkt->flags = key ? AV_PKT_FLAG_KEY : 0;
+        ring.append(pkt, pts * kFrameMs);
+        av_packet_free(&pkt);
+
+        // 最新时刻与环内随机时刻各取一次
+        verifyExtract(ring, pts * kFrameMs, sizes, keys);
+        const PacketRing::Span span = ring.span();
+        if (span.isValid())
+            verifyExtract(ring, rng.bounded(int(span.firstMs), int(span.lastMs)), sizes, keys);
+        if (QTest::currentTestFailed()) {
+            qWarning() << "mismatch after packet" << pts;
+            return;
+        }
+    }
+}
+
+void TestPacketRing::oversizedGopWaitsForKeyframe()
+{
+    PacketRing ring(kBudget);
+    AVCodecParameters *par = videoParams();
+    ring.beginSession(par, AVRational{ 1, 90000 });
+    avcodec_parameters_free(&par);
+
+    // 一个 GOP 远大于预算：环被淘汰空后不能以 P 帧开头
+    QVector<int> sizes;
+    QVector<bool> keys;
+    for (int64_t pts = 0; pts < 200; ++pts) {
+        const bool key = pts % 100 == 0;
+        const int size = key ? int(kBudget / 4) : 16 * 1024;
+        sizes.append(size);
+        keys.append(key);
+
+        AVPacket *pkt = av_packet_alloc();
+        QVERIFY(pkt && av_new_packet(pkt, size) == 0);
+        fillPattern(pkt, pts);
+        pkt->pts = pkt->dts = pts;
+        pkt->flags = key ? AV_PKT_FLAG_KEY : 0;
+        ring.append(pkt, pts * kFrameMs);
+        av_packet_free(&pkt);
+
+        verifyExtract(ring, pts * kFrameMs, sizes, keys);
+        if (QTest::currentTestFailed()) {
+            qWarning() << "mismatch after packet" << pts;
+            return;
+        }
+    }
+}
+
+QTEST_APPLESS_MAIN(TestPacketRing)
+#include "tst_packetring.moc"